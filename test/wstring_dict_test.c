@@ -0,0 +1,184 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define _GNU_SOURCE
+#include "wstring_sugar.h"
+#include "wstring_dict.h"
+#define TEST_IMPLEMENTATION
+#include "Testing.h"
+#include <stdlib.h>
+
+#define autoWStringDict __attribute__(( cleanup( wstringdict_delete ))) WStringDict
+
+WStringNamespace s = wstringNamespace;
+
+enum { NumberStrings = 3000 };
+
+//Sorted URLs with long common prefixes and some duplicates.
+static WString**
+newUrls( size_t n )
+{
+	WString** urls = malloc( n * sizeof( WString* ));
+	for ( size_t i = 0; i < n; i++ )
+		urls[i] = wstring_printf( "https://example.com/%s/%zu/möhren", i % 3 ? "api" : "static", ( i * 7919 ) % ( n - 100 ));
+	wstring_sortArray( urls, n );
+	return urls;
+}
+
+static void
+deleteStrings( WString** strings, size_t n )
+{
+	for ( size_t i = 0; i < n; i++ )
+		wstring_delete( &strings[i] );
+	free( strings );
+}
+
+//---------------------------------------------------------------------------------
+
+void
+Test_wstringdict_findSelect()
+{
+	WString** urls = newUrls( NumberStrings );
+	autoWStringDict* dict = wstringdict_new( urls, NumberStrings );
+
+	size_t rawBytes = 0, unique = 0;
+	for ( size_t i = 0; i < NumberStrings; i++ ) {
+		rawBytes += wstring_sizeBytes( urls[i] );
+		unique += i == 0 || !wstring_equals( urls[i - 1], urls[i] );
+	}
+	assert_equal( wstringdict_size( dict ), unique );
+	assert_less( wstringdict_sizeBytes( dict ) * 2, rawBytes );
+
+	size_t wrong = 0;
+	for ( size_t i = 0; i < NumberStrings; i++ ) {
+		int64_t index = wstringdict_find( dict, wstring_view( urls[i] ));
+		autoWString* selected = index >= 0 ? wstringdict_select( dict, index ) : NULL;
+		wrong += selected == NULL || !wstring_equals( selected, urls[i] );
+	}
+	assert_equal( wrong, 0 );
+
+	autoWString* first = wstringdict_select( dict, 0 );
+	autoWString* last = wstringdict_select( dict, unique - 1 );
+	assert_true( wstring_equals( first, urls[0] ));
+	assert_true( wstring_equals( last, urls[NumberStrings - 1] ));
+
+	assert_equal( wstringdict_find( dict, wstring_viewc( "" )), -1 );
+	assert_equal( wstringdict_find( dict, wstring_viewc( "https://example.com/api/1" )), -1 );
+	assert_equal( wstringdict_find( dict, wstring_viewc( "https://example.com/api/1/möhren/" )), -1 );
+	assert_equal( wstringdict_find( dict, wstring_viewc( "zzz" )), -1 );
+
+	deleteStrings( urls, NumberStrings );
+}
+
+void
+Test_wstringdict_rank()
+{
+	WString* strings[] = { s.dup( "" ), s.dup( "apfel" ), s.dup( "apfelbaum" ), s.dup( "apfelbaum" ), s.dup( "birne" ) };
+	autoWStringDict* dict = wstringdict_new( strings, 5 );
+	assert_equal( wstringdict_size( dict ), 4 );
+
+	assert_equal( wstringdict_rank( dict, wstring_viewc( "" )), 0 );
+	assert_equal( wstringdict_find( dict, wstring_viewc( "" )), 0 );
+	assert_equal( wstringdict_rank( dict, wstring_viewc( "a" )), 1 );
+	assert_equal( wstringdict_rank( dict, wstring_viewc( "apfel" )), 1 );
+	assert_equal( wstringdict_rank( dict, wstring_viewc( "apfela" )), 2 );
+	assert_equal( wstringdict_rank( dict, wstring_viewc( "apfelbaum" )), 2 );
+	assert_equal( wstringdict_find( dict, wstring_viewc( "apfelbaum" )), 2 );
+	assert_equal( wstringdict_rank( dict, wstring_viewc( "apfelz" )), 3 );
+	assert_equal( wstringdict_rank( dict, wstring_viewc( "zitrone" )), 4 );
+
+	autoWStringDict* empty = wstringdict_new( NULL, 0 );
+	assert_equal( wstringdict_size( empty ), 0 );
+	assert_equal( wstringdict_rank( empty, wstring_viewc( "apfel" )), 0 );
+	assert_equal( wstringdict_find( empty, wstring_viewc( "apfel" )), -1 );
+
+	//Ranks agree with a linear count
+	WString** urls = newUrls( NumberStrings );
+	autoWStringDict* urlDict = wstringdict_new( urls, NumberStrings );
+	size_t wrong = 0;
+	for ( size_t i = 0; i < 500; i++ ) {
+		autoWString* key = s.printf( "https://example.com/api/%zu", i * 13 );
+		size_t expected = 0;
+		for ( size_t j = 0; j < wstringdict_size( urlDict ); j++ ) {
+			autoWString* string = wstringdict_select( urlDict, j );
+			expected += wstring_compare( string, key ) < 0;
+		}
+		wrong += wstringdict_rank( urlDict, wstring_view( key )) != expected;
+	}
+	assert_equal( wrong, 0 );
+
+	deleteStrings( urls, NumberStrings );
+	for ( size_t i = 0; i < 5; i++ )
+		wstring_delete( &strings[i] );
+}
+
+static void
+collect( WStringView string, size_t index, void* data )
+{
+	WString* collected = data;
+	wstring_appendf( collected, "%zu:%.*s ", index, (int)string.length, string.bytes );
+}
+
+void
+Test_wstringdict_foreachPrefix()
+{
+	WString* strings[40];
+	for ( size_t i = 0; i < 40; i++ )
+		strings[i] = s.printf( "/%s/%02zu", i < 20 ? "api" : "static", i % 20 );
+	autoWStringDict* dict = wstringdict_new( strings, 40 );
+
+	autoWString* collected1 = s.dup( "" );
+	wstringdict_foreachPrefix( dict, wstring_viewc( "/api/1" ), collect, collected1 );
+	assert_strequal( collected1->cstring, "10:/api/10 11:/api/11 12:/api/12 13:/api/13 14:/api/14 15:/api/15 16:/api/16 17:/api/17 18:/api/18 19:/api/19 " );
+
+	autoWString* collected2 = s.dup( "" );
+	wstringdict_foreachPrefix( dict, wstring_viewc( "/static/19" ), collect, collected2 );
+	assert_strequal( collected2->cstring, "39:/static/19 " );
+
+	autoWString* collected3 = s.dup( "" );
+	wstringdict_foreachPrefix( dict, wstring_viewc( "/b" ), collect, collected3 );
+	wstringdict_foreachPrefix( dict, wstring_viewc( "/static/2" ), collect, collected3 );
+	assert_strequal( collected3->cstring, "" );
+
+	size_t count = 0;
+	autoWString* collected4 = s.dup( "" );
+	wstringdict_foreachPrefix( dict, wstring_viewc( "" ), collect, collected4 );
+	for ( const char* c = collected4->cstring; *c; c++ )
+		count += *c == ' ';
+	assert_equal( count, 40 );
+
+	for ( size_t i = 0; i < 40; i++ )
+		wstring_delete( &strings[i] );
+}
+
+//---------------------------------------------------------------------------------
+
+int main()
+{
+	printf( "\n" );
+
+	testsuite( Test_wstringdict_findSelect );
+	testsuite( Test_wstringdict_rank );
+	testsuite( Test_wstringdict_foreachPrefix );
+
+	printf( "\n" );
+	printf( "----------------------------\n" );
+	printf( "| Tests  | Failed | Passed |\n" );
+	printf( "| %-6zu | %-6zu | %-6zu |\n", testsFailed+testsPassed, testsFailed, testsPassed );
+	printf( "----------------------------\n" );
+}
+
+//---------------------------------------------------------------------------------
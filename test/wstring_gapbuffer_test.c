@@ -0,0 +1,140 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define _GNU_SOURCE
+#include "wstring_sugar.h"
+#include "wstring_gapbuffer.h"
+#define TEST_IMPLEMENTATION
+#include "Testing.h"
+#include <stdlib.h>
+#include <unistd.h>
+
+#define autoWStringGapBuffer __attribute__(( cleanup( wstringgapbuffer_delete ))) WStringGapBuffer
+
+//---------------------------------------------------------------------------------
+
+void
+Test_wstringgapbuffer_edit()
+{
+	WString* string = wstring_dup( "Hello world" );
+	autoWStringGapBuffer* buffer = wstringgapbuffer_new( &string );
+	assert_null( string );
+	assert_equal( wstringgapbuffer_size( buffer ), 11 );
+
+	wstringgapbuffer_insert( buffer, 5, wstring_viewc( "," ));
+	wstringgapbuffer_insert( buffer, 7, wstring_viewc( "schöne " ));
+	assert_equal( wstringgapbuffer_size( buffer ), 19 );
+
+	WStringView before = wstringgapbuffer_before( buffer );
+	WStringView after = wstringgapbuffer_after( buffer );
+	assert_equal( before.length, 15 );
+	assert_true( memcmp( before.bytes, "Hello, schöne ", 15 ) == 0 );
+	assert_equal( after.length, 5 );
+	assert_true( memcmp( after.bytes, "world", 5 ) == 0 );
+
+	wstringgapbuffer_erase( buffer, 9, 2 );
+	wstringgapbuffer_erase( buffer, 0, 7 );
+	wstringgapbuffer_erase( buffer, 4, 100 );
+	wstringgapbuffer_insert( buffer, 0, wstring_viewc( "Grüße, " ));
+
+	string = wstringgapbuffer_toString( &buffer );
+	assert_null( buffer );
+	assert_strequal( string->cstring, "Grüße, scne" );
+	assert_equal( wstring_size( string ), 11 );
+	wstring_appendc( string, "!" );
+	assert_strequal( string->cstring, "Grüße, scne!" );
+	wstring_delete( &string );
+}
+void
+Test_wstringgapbuffer_mapped()
+{
+	char path[] = "/tmp/wstring_gapbuffer_testXXXXXX";
+	int fd = mkstemp( path );
+	assert_true( fd >= 0 );
+	assert_equal( write( fd, "Hello world", 11 ), 11 );
+	close( fd );
+
+	WString* string = wstring_mapFile( path );
+	unlink( path );
+	autoWStringGapBuffer* buffer = wstringgapbuffer_new( &string );
+	assert_null( string );
+	assert_equal( wstringgapbuffer_size( buffer ), 11 );
+
+	wstringgapbuffer_insert( buffer, 5, wstring_viewc( ", schöne" ));
+	string = wstringgapbuffer_toString( &buffer );
+	assert_strequal( string->cstring, "Hello, schöne world" );
+	wstring_delete( &string );
+}
+
+//Random edits near a moving cursor, compared with wstring_insert() and wstring_erase().
+void
+Test_wstringgapbuffer_random()
+{
+	const char* texts[] = { "a", "bc", "ä", "€uro", "𝄞", "", "xyzxyzxyzxyz" };
+	srand( 7 );
+
+	autoWString* expected = wstring_dup( "Ölkännchen" );
+	WString* string = wstring_clone( expected );
+	autoWStringGapBuffer* buffer = wstringgapbuffer_new( &string );
+	size_t cursor = 0;
+	size_t wrong = 0;
+
+	for ( size_t round = 0; round < 5000; round++ ) {
+		size_t size = wstring_size( expected );
+		cursor = ( cursor + rand() % 21 + size - 10 ) % ( size + 1 );
+		if ( rand() % 3 ) {
+			const char* text = texts[rand() % 7];
+			wstring_insert( expected, cursor, text );
+			wstringgapbuffer_insert( buffer, cursor, wstring_viewc( text ));
+		}
+		else {
+			size_t length = rand() % 4;
+			wstring_erase( expected, cursor, length );
+			wstringgapbuffer_erase( buffer, cursor, length );
+		}
+
+		WStringView before = wstringgapbuffer_before( buffer );
+		WStringView after = wstringgapbuffer_after( buffer );
+		wrong += before.length + after.length != expected->sizeBytes - 1
+			|| memcmp( before.bytes, expected->cstring, before.length ) != 0
+			|| memcmp( after.bytes, &expected->cstring[before.length], after.length ) != 0
+			|| wstringgapbuffer_size( buffer ) != wstring_size( expected );
+	}
+	assert_equal( wrong, 0 );
+
+	string = wstringgapbuffer_toString( &buffer );
+	assert_strequal( string->cstring, expected->cstring );
+	wstring_delete( &string );
+}
+
+//---------------------------------------------------------------------------------
+
+int main()
+{
+	printf( "\n" );
+
+	testsuite( Test_wstringgapbuffer_edit );
+	testsuite( Test_wstringgapbuffer_mapped );
+	testsuite( Test_wstringgapbuffer_random );
+
+	printf( "\n" );
+	printf( "----------------------------\n" );
+	printf( "| Tests  | Failed | Passed |\n" );
+	printf( "| %-6zu | %-6zu | %-6zu |\n", testsFailed+testsPassed, testsFailed, testsPassed );
+	printf( "----------------------------\n" );
+}
+
+//---------------------------------------------------------------------------------
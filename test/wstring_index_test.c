@@ -0,0 +1,135 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define _GNU_SOURCE
+#include "wstring_sugar.h"
+#include "wstring_index.h"
+#define TEST_IMPLEMENTATION
+#include "Testing.h"
+#include <stdlib.h>
+
+#define autoWStringIndex __attribute__(( cleanup( wstringindex_delete ))) WStringIndex
+
+//Count all matches by comparing at each position.
+static size_t
+countNaive( WStringView text, WStringView pattern )
+{
+	size_t count = 0;
+	for ( size_t i = 0; i + pattern.length <= text.length; i++ )
+		count += memcmp( &text.bytes[i], pattern.bytes, pattern.length ) == 0;
+	return count;
+}
+
+static int
+compareSizes( const void* a, const void* b )
+{
+	size_t x = *(const size_t*)a, y = *(const size_t*)b;
+	return ( x > y ) - ( x < y );
+}
+
+//---------------------------------------------------------------------------------
+
+void
+Test_wstringindex_banana()
+{
+	autoWString* text = wstring_dup( "banana" );
+	autoWStringIndex* index = wstringindex_new( wstring_view( text ));
+
+	assert_true( wstringindex_contains( index, wstring_viewc( "nan" )));
+	assert_true( wstringindex_contains( index, wstring_viewc( "banana" )));
+	assert_true( wstringindex_contains( index, wstring_viewc( "" )));
+	assert_false( wstringindex_contains( index, wstring_viewc( "bananas" )));
+	assert_false( wstringindex_contains( index, wstring_viewc( "nab" )));
+	assert_false( wstringindex_contains( index, wstring_viewc( "c" )));
+
+	assert_equal( wstringindex_count( index, wstring_viewc( "a" )), 3 );
+	assert_equal( wstringindex_count( index, wstring_viewc( "ana" )), 2 );
+	assert_equal( wstringindex_count( index, wstring_viewc( "" )), 6 );
+	assert_equal( wstringindex_count( index, wstring_viewc( "x" )), 0 );
+
+	size_t positions[3];
+	assert_equal( wstringindex_locate( index, wstring_viewc( "an" ), positions, 3 ), 2 );
+	qsort( positions, 2, sizeof( size_t ), compareSizes );
+	assert_equal( positions[0], 1 );
+	assert_equal( positions[1], 3 );
+	assert_equal( wstringindex_locate( index, wstring_viewc( "a" ), positions, 1 ), 3 );
+
+	autoWStringIndex* empty = wstringindex_new( wstring_viewc( "" ));
+	assert_true( wstringindex_contains( empty, wstring_viewc( "" )));
+	assert_false( wstringindex_contains( empty, wstring_viewc( "a" )));
+	assert_equal( wstringindex_count( empty, wstring_viewc( "a" )), 0 );
+}
+
+void
+Test_wstringindex_random()
+{
+	//Small alphabets give many repetitions and deep recursions.
+	const char* alphabets[] = { "ab", "abc", "aä\xff", "abcdefghijklmnopqrstuvwxyz" };
+	unsigned random = 42;
+
+	size_t wrong = 0;
+	for ( size_t a = 0; a < 4; a++ ) {
+		size_t alphabetLength = strlen( alphabets[a] );
+		for ( size_t length = 1; length < 3000; length = length * 3 + 1 ) {
+			char* bytes = malloc( length );
+			for ( size_t i = 0; i < length; i++ ) {
+				random = random * 1103515245 + 12345;
+				bytes[i] = alphabets[a][( random >> 16 ) % alphabetLength];
+			}
+			WStringView text = { bytes, length };
+			autoWStringIndex* index = wstringindex_new( text );
+
+			for ( size_t i = 0; i < 50; i++ ) {
+				random = random * 1103515245 + 12345;
+				size_t start = ( random >> 16 ) % length;
+				size_t patternLength = ( random >> 8 ) % 6 + 1;
+				char pattern[8];
+				for ( size_t j = 0; j < patternLength; j++ )
+					pattern[j] = j % 3 == 2 ? alphabets[a][j % alphabetLength] : bytes[( start + j ) % length];
+
+				WStringView view = { pattern, patternLength };
+				size_t expected = countNaive( text, view );
+				wrong += wstringindex_count( index, view ) != expected;
+				wrong += wstringindex_contains( index, view ) != ( expected > 0 );
+
+				size_t positions[3000];
+				wstringindex_locate( index, view, positions, expected );
+				for ( size_t j = 0; j < expected; j++ )
+					wrong += memcmp( &bytes[positions[j]], pattern, patternLength ) != 0;
+			}
+			free( bytes );
+		}
+	}
+	assert_equal( wrong, 0 );
+}
+
+//---------------------------------------------------------------------------------
+
+int main()
+{
+	printf( "\n" );
+
+	testsuite( Test_wstringindex_banana );
+	testsuite( Test_wstringindex_random );
+
+	printf( "\n" );
+	printf( "----------------------------\n" );
+	printf( "| Tests  | Failed | Passed |\n" );
+	printf( "| %-6zu | %-6zu | %-6zu |\n", testsFailed+testsPassed, testsFailed, testsPassed );
+	printf( "----------------------------\n" );
+}
+
+//---------------------------------------------------------------------------------
@@ -0,0 +1,86 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define _GNU_SOURCE
+#include "wstring_sugar.h"
+#include "wstring_keywordset.h"
+#define TEST_IMPLEMENTATION
+#include "Testing.h"
+#include <stdlib.h>
+
+#define autoWStringKeywordSet __attribute__(( cleanup( wstringkeywordset_delete ))) WStringKeywordSet
+
+//---------------------------------------------------------------------------------
+
+void
+Test_wstringkeywordset_find()
+{
+	const char* methods[] = { "GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH", "GET", "" };
+	autoWStringKeywordSet* set = wstringkeywordset_new( methods, 11 );
+	assert_equal( wstringkeywordset_size( set ), 10 );
+
+	for ( int64_t i = 0; i < 9; i++ )
+		assert_equal( wstringkeywordset_find( set, wstring_viewc( methods[i] )), i );
+	assert_equal( wstringkeywordset_find( set, wstring_viewc( "" )), 10 );
+	assert_equal( wstringkeywordset_find( set, wstring_viewc( "get" )), -1 );
+	assert_equal( wstringkeywordset_find( set, wstring_viewc( "GETS" )), -1 );
+	assert_equal( wstringkeywordset_find( set, (WStringView){ "POSTAL", 4 }), 2 );
+
+	autoWStringKeywordSet* empty = wstringkeywordset_new( NULL, 0 );
+	assert_equal( wstringkeywordset_size( empty ), 0 );
+	assert_equal( wstringkeywordset_find( empty, wstring_viewc( "GET" )), -1 );
+}
+
+void
+Test_wstringkeywordset_many()
+{
+	enum { Number = 3000 };
+	char* keywords[Number];
+	for ( size_t i = 0; i < Number; i++ )
+		asprintf( &keywords[i], "key_%zu", i * 7 );
+
+	autoWStringKeywordSet* set = wstringkeywordset_new( (const char**)keywords, Number );
+	assert_equal( wstringkeywordset_size( set ), Number );
+
+	size_t wrong = 0;
+	for ( size_t i = 0; i < Number * 7; i++ ) {
+		autoWString* key = wstring_printf( "key_%zu", i );
+		int64_t expected = i % 7 == 0 ? (int64_t)( i / 7 ) : -1;
+		wrong += wstringkeywordset_find( set, wstring_view( key )) != expected;
+	}
+	assert_equal( wrong, 0 );
+
+	for ( size_t i = 0; i < Number; i++ )
+		free( keywords[i] );
+}
+
+//---------------------------------------------------------------------------------
+
+int main()
+{
+	printf( "\n" );
+
+	testsuite( Test_wstringkeywordset_find );
+	testsuite( Test_wstringkeywordset_many );
+
+	printf( "\n" );
+	printf( "----------------------------\n" );
+	printf( "| Tests  | Failed | Passed |\n" );
+	printf( "| %-6zu | %-6zu | %-6zu |\n", testsFailed+testsPassed, testsFailed, testsPassed );
+	printf( "----------------------------\n" );
+}
+
+//---------------------------------------------------------------------------------
@@ -0,0 +1,152 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define _GNU_SOURCE
+#include "wstring_sugar.h"
+#include "wstring_parallel.h"
+#define TEST_IMPLEMENTATION
+#include "Testing.h"
+#include <locale.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#define autoWStringThreadPool __attribute__(( cleanup( wstringthreadpool_delete ))) WStringThreadPool
+
+enum { NumberStrings = 30000 };
+
+static WString**
+newStrings( size_t n, const char format[] )
+{
+	WString** strings = malloc( n * sizeof( WString* ));
+	for ( size_t i = 0; i < n; i++ )
+		strings[i] = wstring_printf( format, ( i * 7919 ) % 1000, i );
+	return strings;
+}
+
+static void
+deleteStrings( WString** strings, size_t n )
+{
+	for ( size_t i = 0; i < n; i++ )
+		wstring_delete( &strings[i] );
+	free( strings );
+}
+
+//---------------------------------------------------------------------------------
+
+static void
+sumRange( void* context, size_t begin, size_t end )
+{
+	atomic_size_t* sum = context;
+	for ( size_t i = begin; i < end; i++ )
+		atomic_fetch_add( sum, i );
+}
+
+void
+Test_wstringthreadpool_run()
+{
+	autoWStringThreadPool* pool = wstringthreadpool_new( 3 );
+	assert_equal( wstringthreadpool_size( pool ), 3 );
+
+	for ( int job = 0; job < 20; job++ ) {
+		atomic_size_t sum = 0;
+		wstringthreadpool_run( pool, 10000, 7, sumRange, &sum );
+		assert_equal( sum, 10000*9999/2 );
+	}
+
+	atomic_size_t sum = 0;
+	wstringthreadpool_run( pool, 0, 1, sumRange, &sum );
+	assert_equal( sum, 0 );
+
+	autoWStringThreadPool* single = wstringthreadpool_new( 0 );
+	assert_equal( wstringthreadpool_size( single ), 0 );
+	wstringthreadpool_run( single, 100, 1, sumRange, &sum );
+	assert_equal( sum, 100*99/2 );
+
+	sum = 0;
+	wstringthreadpool_run( NULL, 100, 1, sumRange, &sum );
+	assert_equal( sum, 100*99/2 );
+}
+
+void
+Test_wstring_parallelSortArray()
+{
+	autoWStringThreadPool* pool = wstringthreadpool_new( 3 );
+	WString** strings = newStrings( NumberStrings, "Key %03zu Nr %zu" );
+	WString** expected = malloc( NumberStrings * sizeof( WString* ));
+	memcpy( expected, strings, NumberStrings * sizeof( WString* ));
+
+	wstring_sortArray( expected, NumberStrings );
+	wstring_parallelSortArray( pool, strings, NumberStrings );
+	for ( size_t i = 0; i < NumberStrings; i++ )
+		assert_true( wstring_equals( strings[i], expected[i] ));
+
+	//Many equal strings
+	for ( size_t i = 0; i < NumberStrings; i++ )
+		wstring_setf( strings[i], "%zu", i % 3 );
+	wstring_parallelSortArray( NULL, strings, NumberStrings );
+	assert_strequal( strings[0]->cstring, "0" );
+	assert_strequal( strings[NumberStrings/3]->cstring, "1" );
+	assert_strequal( strings[NumberStrings-1]->cstring, "2" );
+	for ( size_t i = 1; i < NumberStrings; i++ )
+		assert_true( wstring_compare( strings[i-1], strings[i] ) <= 0 );
+
+	wstring_parallelSortArray( pool, strings, 0 );
+
+	free( expected );
+	deleteStrings( strings, NumberStrings );
+}
+
+void
+Test_wstring_parallelTransform()
+{
+	autoWStringThreadPool* pool = wstringthreadpool_new( 3 );
+	WString** strings = newStrings( NumberStrings, "  ÄPFEL %zu und BIRNEN %zu  " );
+
+	wstring_parallelTrim( pool, strings, NumberStrings, " " );
+	wstring_parallelToLower( pool, strings, NumberStrings );
+	wstring_parallelReplaceAll( pool, strings, NumberStrings, "und", "oder" );
+	assert_strequal( strings[0]->cstring, "äpfel 0 oder birnen 0" );
+	assert_strequal( strings[1]->cstring, "äpfel 919 oder birnen 1" );
+	assert_strequal( strings[NumberStrings-1]->cstring, "äpfel 81 oder birnen 29999" );
+
+	uint64_t* results = malloc( NumberStrings * sizeof( uint64_t ));
+	wstring_parallelHash( pool, strings, NumberStrings, results );
+	for ( size_t i = 0; i < NumberStrings; i++ )
+		assert_true( results[i] == wstring_hash( strings[i] ));
+
+	free( results );
+	deleteStrings( strings, NumberStrings );
+}
+
+//---------------------------------------------------------------------------------
+
+int main()
+{
+	setlocale( LC_ALL, "" );
+	printf( "\n" );
+
+	testsuite( Test_wstringthreadpool_run );
+	testsuite( Test_wstring_parallelSortArray );
+	testsuite( Test_wstring_parallelTransform );
+
+	printf( "\n" );
+	printf( "----------------------------\n" );
+	printf( "| Tests  | Failed | Passed |\n" );
+	printf( "| %-6zu | %-6zu | %-6zu |\n", testsFailed+testsPassed, testsFailed, testsPassed );
+	printf( "----------------------------\n" );
+}
+
+//---------------------------------------------------------------------------------
@@ -0,0 +1,177 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define _GNU_SOURCE
+#include "wstring_sugar.h"
+#include "wstring_rope.h"
+#define TEST_IMPLEMENTATION
+#include "Testing.h"
+#include <stdlib.h>
+
+#define autoWStringRope __attribute__(( cleanup( wstringrope_delete ))) WStringRope
+
+//---------------------------------------------------------------------------------
+
+static bool
+ropeEquals( const WStringRope* rope, const char* expected )
+{
+	autoWString* flat = wstringrope_flatten( rope );
+	return wstringrope_length( rope ) == strlen( expected ) && strcmp( flat->cstring, expected ) == 0;
+}
+
+static void
+countChunk( WStringView chunk, void* data )
+{
+	size_t* lengths = data;
+	lengths[0]++;
+	lengths[1] += chunk.length;
+}
+
+//---------------------------------------------------------------------------------
+
+void
+Test_wstringrope_new()
+{
+	autoWStringRope* empty = wstringrope_new();
+	assert_equal( wstringrope_length( empty ), 0 );
+	assert_true( ropeEquals( empty, "" ));
+
+	autoWStringRope* rope = wstringrope_fromView( wstring_viewc( "Grüße" ));
+	assert_equal( wstringrope_length( rope ), 7 );
+	autoWString* flat = wstringrope_flatten( rope );
+	assert_equal( wstring_size( flat ), 5 );
+	assert_strequal( flat->cstring, "Grüße" );
+}
+
+void
+Test_wstringrope_edit()
+{
+	autoWStringRope* rope = wstringrope_fromView( wstring_viewc( "world" ));
+	wstringrope_prepend( rope, wstring_viewc( "Hello " ));
+	wstringrope_append( rope, wstring_viewc( "!" ));
+	assert_true( ropeEquals( rope, "Hello world!" ));
+
+	wstringrope_insert( rope, 5, wstring_viewc( "," ));
+	assert_true( ropeEquals( rope, "Hello, world!" ));
+	wstringrope_erase( rope, 0, 7 );
+	assert_true( ropeEquals( rope, "world!" ));
+	wstringrope_erase( rope, 5, 100 );
+	assert_true( ropeEquals( rope, "world" ));
+
+	autoWStringRope* slice = wstringrope_slice( rope, 1, 3 );
+	assert_true( ropeEquals( slice, "orl" ));
+	wstringrope_appendRope( rope, rope );
+	assert_true( ropeEquals( rope, "worldworld" ));
+	assert_true( ropeEquals( slice, "orl" ));
+}
+
+//Random edits, compared with a plain byte buffer.
+void
+Test_wstringrope_random()
+{
+	srand( 42 );
+	size_t capacity = 1 << 20;
+	char* expected = malloc( capacity );
+	char* text = malloc( 10000 );
+	for ( size_t i = 0; i < 10000; i++ )
+		text[i] = 'a' + rand() % 26;
+
+	autoWStringRope* rope = wstringrope_new();
+	size_t length = 0;
+	size_t wrong = 0;
+
+	for ( size_t round = 0; round < 3000; round++ ) {
+		size_t position = rand() % ( length + 1 );
+		size_t n = rand() % 3 ? rand() % 20 : rand() % 10000;
+		switch ( rand() % 5 ) {
+		case 0:
+		case 1:
+			if ( length + n >= capacity )
+				break;
+			memmove( &expected[position + n], &expected[position], length - position );
+			memcpy( &expected[position], text, n );
+			length += n;
+			wstringrope_insert( rope, position, (WStringView){ text, n });
+			break;
+		case 2:
+			if ( length + n >= capacity )
+				break;
+			memcpy( &expected[length], text, n );
+			length += n;
+			wstringrope_append( rope, (WStringView){ text, n });
+			break;
+		case 3:
+			n = n < length - position ? n : length - position;
+			memmove( &expected[position], &expected[position + n], length - position - n );
+			length -= n;
+			wstringrope_erase( rope, position, n );
+			break;
+		case 4: {
+			n = n < length - position ? n : length - position;
+			autoWStringRope* slice = wstringrope_slice( rope, position, n );
+			autoWString* flat = wstringrope_flatten( slice );
+			wrong += flat->sizeBytes != n + 1 || memcmp( flat->cstring, &expected[position], n ) != 0;
+			break;
+		}
+		}
+		expected[length] = '\0';
+		if ( round % 100 == 0 )
+			wrong += !ropeEquals( rope, expected );
+	}
+	assert_equal( wrong, 0 );
+	assert_true( ropeEquals( rope, expected ));
+
+	free( expected );
+	free( text );
+}
+
+void
+Test_wstringrope_foreachChunk()
+{
+	char* text = malloc( 100000 );
+	memset( text, 'x', 100000 );
+
+	autoWStringRope* rope = wstringrope_fromView( (WStringView){ text, 100000 });
+	for ( size_t i = 0; i < 10000; i++ )
+		wstringrope_append( rope, wstring_viewc( "y" ));
+
+	size_t lengths[2] = { 0 };
+	wstringrope_foreachChunk( rope, countChunk, lengths );
+	assert_equal( lengths[1], 110000 );
+	assert_true( lengths[0] <= 110000 / 2048 + 2 );
+
+	free( text );
+}
+
+//---------------------------------------------------------------------------------
+
+int main()
+{
+	printf( "\n" );
+
+	testsuite( Test_wstringrope_new );
+	testsuite( Test_wstringrope_edit );
+	testsuite( Test_wstringrope_random );
+	testsuite( Test_wstringrope_foreachChunk );
+
+	printf( "\n" );
+	printf( "----------------------------\n" );
+	printf( "| Tests  | Failed | Passed |\n" );
+	printf( "| %-6zu | %-6zu | %-6zu |\n", testsFailed+testsPassed, testsFailed, testsPassed );
+	printf( "----------------------------\n" );
+}
+
+//---------------------------------------------------------------------------------
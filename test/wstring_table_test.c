@@ -0,0 +1,204 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define _GNU_SOURCE
+#include "wstring_sugar.h"
+#include "wstring_table.h"
+#define TEST_IMPLEMENTATION
+#include "Testing.h"
+#include <locale.h>
+#include <stdlib.h>
+
+#define autoWStringTable __attribute__(( cleanup( wstringtable_delete ))) WStringTable
+
+//---------------------------------------------------------------------------------
+
+void
+Test_wstringtable_appendAt()
+{
+	autoWStringTable* table = wstringtable_new( 1, 4 );
+	assert_equal( wstringtable_size( table ), 0 );
+
+	autoWString* string = wstring_dup( "Weiße Möhren" );
+	assert_equal( wstringtable_append( table, string ), 0 );
+	assert_equal( wstringtable_appendc( table, "" ), 1 );
+	assert_equal( wstringtable_appendView( table, (WStringView){ "Test123", 4 }), 2 );
+	for ( int i = 0; i < 1000; i++ )
+		wstringtable_appendc( table, "Howard Carpendale" );
+	assert_equal( wstringtable_size( table ), 1003 );
+
+	assert_strequal( wstringtable_cstring( table, 0 ), "Weiße Möhren" );
+	assert_strequal( wstringtable_cstring( table, 1 ), "" );
+	assert_strequal( wstringtable_cstring( table, 2 ), "Test" );
+	assert_strequal( wstringtable_cstring( table, 1002 ), "Howard Carpendale" );
+
+	WStringView view = wstringtable_at( table, 0 );
+	assert_equal( view.length, 14 );
+	assert_true( memcmp( view.bytes, "Weiße Möhren", 14 ) == 0 );
+	assert_equal( wstringtable_at( table, 1 ).length, 0 );
+
+	wstringtable_clear( table );
+	assert_equal( wstringtable_size( table ), 0 );
+	wstringtable_appendc( table, "Test" );
+	assert_strequal( wstringtable_cstring( table, 0 ), "Test" );
+}
+void
+Test_wstringtable_compare()
+{
+	autoWStringTable* table = wstringtable_new( 0, 0 );
+	wstringtable_appendc( table, "handfull" );
+	wstringtable_appendc( table, "Handsome" );
+	wstringtable_appendc( table, "Hand" );
+	wstringtable_appendc( table, "" );
+
+	autoWString* other = wstring_dup( "Handsome" );
+	int results[4];
+	wstringtable_compare( table, other, results );
+	assert_greater( results[0], 0 );
+	assert_equal( results[1], 0 );
+	assert_less( results[2], 0 );
+	assert_less( results[3], 0 );
+}
+void
+Test_wstringtable_contains()
+{
+	autoWStringTable* table = wstringtable_new( 0, 0 );
+	wstringtable_appendc( table, "Alle meine Entchen" );
+	wstringtable_appendc( table, "schwimmen auf dem See" );
+	wstringtable_appendc( table, "" );
+	wstringtable_appendc( table, "See, See, See" );
+	wstringtable_appendc( table, "Se" );
+	wstringtable_appendc( table, "e Ente im See" );
+
+	bool results[6];
+	autoWString* see = wstring_dup( "See" );
+	assert_equal( wstringtable_contains( table, see, results ), 3 );
+	assert_false( results[0] );
+	assert_true( results[1] );
+	assert_false( results[2] );
+	assert_true( results[3] );
+	assert_false( results[4] );
+	assert_true( results[5] );
+
+	autoWString* spanning = wstring_dup( "SeeSe" );
+	assert_equal( wstringtable_contains( table, spanning, results ), 0 );
+
+	autoWString* empty = wstring_dup( "" );
+	assert_equal( wstringtable_contains( table, empty, results ), 6 );
+	assert_true( results[2] );
+
+	//Search texts with 0 bytes do not match across two strings.
+	autoWStringTable* binary = wstringtable_new( 0, 0 );
+	wstringtable_appendc( binary, "xa" );
+	wstringtable_appendc( binary, "bz" );
+	wstringtable_appendView( binary, (WStringView){ "ya\0bz", 5 });
+	autoWString* terminator = wstring_newBytes( "a\0b", 3 );
+	assert_equal( wstringtable_contains( binary, terminator, results ), 1 );
+	assert_false( results[0] );
+	assert_false( results[1] );
+	assert_true( results[2] );
+	assert_equal( wstringtable_at( binary, 2 ).length, 5 );
+}
+
+void
+Test_wstringtable_containsFiltered()
+{
+	autoWStringTable* table = wstringtable_new( 0, 0 );
+	for ( size_t i = 0; i < 1000; i++ ) {
+		autoWString* message = wstring_printf( "%s request %zu from 10.0.%zu.%zu", i % 100 ? "GET" : "POST", i, i / 256, i % 256 );
+		wstringtable_append( table, message );
+	}
+
+	WStringSignature* signatures = malloc( 1000 * sizeof( WStringSignature ));
+	wstringtable_signatures( table, signatures );
+
+	bool results[1000], expected[1000];
+	const char* searches[] = { "POST", "request 5", "10.0.3.", "DELETE", "", "t" };
+	for ( size_t i = 0; i < 6; i++ ) {
+		autoWString* search = wstring_dup( searches[i] );
+		size_t count = wstringtable_containsFiltered( table, signatures, search, results );
+		assert_equal( count, wstringtable_contains( table, search, expected ));
+		assert_true( memcmp( results, expected, sizeof( results )) == 0 );
+	}
+
+	free( signatures );
+}
+void
+Test_wstringtable_toLower()
+{
+	autoWStringTable* table = wstringtable_new( 0, 0 );
+	wstringtable_appendc( table, "ApPleS anD ORAngeS" );
+	wstringtable_appendc( table, "" );
+	wstringtable_appendc( table, "A" );
+	wstringtable_appendc( table, "1234[@]^_`{}" );
+
+	wstringtable_toLower( table );
+	assert_strequal( wstringtable_cstring( table, 0 ), "apples and oranges" );
+	assert_strequal( wstringtable_cstring( table, 1 ), "" );
+	assert_strequal( wstringtable_cstring( table, 2 ), "a" );
+	assert_strequal( wstringtable_cstring( table, 3 ), "1234[@]^_`{}" );
+
+	char* oldLocale = setlocale( LC_CTYPE, "" );
+	autoWStringTable* table2 = wstringtable_new( 0, 0 );
+	wstringtable_appendc( table2, "ÄÖÜäöüß WEISSE MÖHREN" );
+	wstringtable_appendc( table2, "ȺȺȺȺ" );		//The lower case letters are one byte longer
+	wstringtable_appendc( table2, "ÄRGER" );
+	wstringtable_toLower( table2 );
+	assert_strequal( wstringtable_cstring( table2, 0 ), "äöüäöüß weisse möhren" );
+	assert_strequal( wstringtable_cstring( table2, 1 ), "ⱥⱥⱥⱥ" );
+	assert_strequal( wstringtable_cstring( table2, 2 ), "ärger" );
+	setlocale( LC_CTYPE, oldLocale );
+}
+void
+Test_wstringtable_hash()
+{
+	autoWStringTable* table = wstringtable_new( 0, 0 );
+	wstringtable_appendc( table, "Weiße Möhren" );
+	wstringtable_appendc( table, "" );
+	wstringtable_appendc( table, "Weiße Möhren und noch mehr Möhren" );
+	wstringtable_appendc( table, "Weiße Möhren" );
+
+	uint64_t results[4];
+	wstringtable_hash( table, results );
+
+	autoWString* string = wstring_dup( "Weiße Möhren" );
+	assert_true( results[0] == wstring_hash( string ));
+	assert_true( results[0] == results[3] );
+	assert_true( results[0] != results[1] );
+	assert_true( results[0] != results[2] );
+}
+
+//---------------------------------------------------------------------------------
+
+int main()
+{
+	printf( "\n" );
+
+	testsuite( Test_wstringtable_appendAt );
+	testsuite( Test_wstringtable_compare );
+	testsuite( Test_wstringtable_contains );
+	testsuite( Test_wstringtable_containsFiltered );
+	testsuite( Test_wstringtable_toLower );
+	testsuite( Test_wstringtable_hash );
+
+	printf( "\n" );
+	printf( "----------------------------\n" );
+	printf( "| Tests  | Failed | Passed |\n" );
+	printf( "| %-6zu | %-6zu | %-6zu |\n", testsFailed+testsPassed, testsFailed, testsPassed );
+	printf( "----------------------------\n" );
+}
+
+//---------------------------------------------------------------------------------
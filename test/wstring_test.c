@@ -20,11 +20,31 @@
 #include "Testing.h"
 #include <locale.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dlfcn.h>
+#include <errno.h>
 
 WStringNamespace s = wstringNamespace;
 
 #define autoChar __attribute__(( cleanup( safeFree ))) char
 
+//Count the calls of vsnprintf() while countFormatting is set. Formatting through a
+//temporary buffer takes one more call, to measure the result.
+static bool countFormatting = false;
+static size_t numberFormatting = 0;
+
+int
+vsnprintf( char* string, size_t size, const char* format, va_list args )
+{
+	static int (*nextVsnprintf)( char*, size_t, const char*, va_list ) = NULL;
+	if ( nextVsnprintf == NULL )
+		nextVsnprintf = (int (*)( char*, size_t, const char*, va_list ))dlsym( RTLD_NEXT, "vsnprintf" );
+
+	numberFormatting += countFormatting;
+	return nextVsnprintf( string, size, format, args );
+}
+
 static void
 safeFree( char** pointer ) {
 	if ( pointer ) {
@@ -57,6 +77,48 @@ Test_wstring_newDup()
 	assert_strequal( string6->cstring, "Weiße Möhren" );
 }
 void
+Test_wstring_newBytes()
+{
+	autoWString* string1 = wstring_newBytes( "a\0bä\0", 6 );
+	assert_equal( wstring_sizeBytes( string1 ), 7 );
+	assert_equal( wstring_size( string1 ), 5 );
+	assert_true( memcmp( string1->cstring, "a\0bä\0", 7 ) == 0 );
+
+	autoWString* string2 = wstring_clone( string1 );
+	assert_true( wstring_equals( string1, string2 ));
+	wstring_append( string2, string1 );
+	assert_equal( wstring_sizeBytes( string2 ), 13 );
+	assert_true( wstring_endsWith( string2, string1 ));
+	assert_true( wstring_startsWith( string2, string1 ));
+
+	autoWString* a = wstring_dup( "a" );
+	autoWString* b = wstring_newBytes( "a\0b", 3 );
+	assert_false( wstring_equals( a, b ));
+	assert_true( wstring_compare( a, b ) < 0 );
+	assert_true( wstring_compare( b, a ) > 0 );
+	assert_true( wstring_contains( string1, b ));
+
+	wstring_replaceAll( string2, "b", "xyz" );
+	assert_equal( wstring_sizeBytes( string2 ), 17 );
+	assert_true( memcmp( string2->cstring, "a\0xyzä\0a\0xyzä\0", 17 ) == 0 );
+
+	char* oldLocale = setlocale( LC_CTYPE, "" );
+	wstring_toUpper( string2 );
+	assert_true( memcmp( string2->cstring, "A\0XYZÄ\0A\0XYZÄ\0", 17 ) == 0 );
+	setlocale( LC_CTYPE, oldLocale );
+
+	char* copy = wstring_cstring( string2 );
+	assert_true( memcmp( copy, string2->cstring, 17 ) == 0 );
+	free( copy );
+
+	WString* strings[] = { wstring_newBytes( "a\0\0", 3 ), wstring_dup( "a" ), wstring_newBytes( "a\0", 2 ), wstring_newBytes( "a\0\0\0\0\0\0\0\0b", 10 ), wstring_newBytes( "a\0\0\0\0\0\0\0\0", 9 ) };
+	wstring_sortArray( strings, 5 );
+	for ( size_t i = 0; i < 5; i++ )
+		assert_equal( (int)wstring_sizeBytes( strings[i] ), (int)( i < 3 ? i + 2 : i + 7 ));
+	for ( size_t i = 0; i < 5; i++ )
+		wstring_delete( &strings[i] );
+}
+void
 Test_wstring_printf()
 {
 	autoWString *string1 = wstring_printf( "%s", "test" );
@@ -110,6 +172,321 @@ Test_wstring_stealCstring()
 	assert_strequal( cstring3a, "Weiße Möhren" );
 	assert_strequal( cstring3b, "Weiße Möhren" );
 }
+void
+Test_wstring_adoptSwap()
+{
+	char* buffer1 = malloc( 16 );
+	memcpy( buffer1, "Möhren", 7 );
+	autoWString* string1 = wstring_adopt( buffer1, 7, 16 );
+	assert_true( string1->cstring == buffer1 );
+	assert_strequal( string1->cstring, "Möhren" );
+	assert_equal( wstring_size( string1 ), 6 );
+
+	char* buffer2 = malloc( 4 );
+	memcpy( buffer2, "test", 4 );
+	autoWString* string2 = wstring_adopt( buffer2, 4, 4 );
+	assert_strequal( string2->cstring, "test" );
+	wstring_append( string2, string1 );
+	assert_strequal( string2->cstring, "testMöhren" );
+
+	wstring_swap( string1, string2 );
+	assert_strequal( string1->cstring, "testMöhren" );
+	assert_strequal( string2->cstring, "Möhren" );
+	assert_equal( wstring_size( string2 ), 6 );
+}
+void
+Test_wstring_capacity()
+{
+	WStringNamespace s = wstringNamespace;
+
+	autoWString* string = s.new( "", 0 );
+	assert_equal( wstring_capacity( string ), 100 );
+
+	s.reserve( string, 1000 );
+	assert_equal( wstring_capacity( string ), 1000 );
+	s.reserve( string, 10 );
+	assert_equal( wstring_capacity( string ), 1000 );
+
+	s.appendc( string, "Weiße Möhren" );
+	s.truncate( string, 5 );
+	s.shrinkToFit( string );
+	assert_equal( wstring_capacity( string ), 7 );
+	assert_strequal( string->cstring, "Weiße" );
+
+	WStringGrowthPolicy oldPolicy = wstring_growthPolicy();
+	wstring_setGrowthPolicy( (WStringGrowthPolicy){ .factor = 1.5, .maximumGrowth = 64, .defaultCapacity = 8, .sizeClasses = true } );
+
+	autoWString* small = s.new( "", 0 );
+	assert_equal( wstring_capacity( small ), 8 );
+	s.appendc( string, "!" );
+	assert_equal( wstring_capacity( string ), 16 );
+
+	s.reserve( string, 1000 );
+	for ( size_t i = 0; i < 1000; i++ )
+		s.appendc( string, "x" );
+	assert_equal( wstring_capacity( string ), 1280 );
+
+	wstring_setGrowthPolicy( oldPolicy );
+	assert_equal( wstring_growthPolicy().factor, 2 );
+}
+static char*
+writeTemporaryFile( const char bytes[], size_t length )
+{
+	char* path = strdup( "/tmp/wstring_testXXXXXX" );
+	int fd = mkstemp( path );
+	assert_true( fd >= 0 );
+	assert_equal( write( fd, bytes, length ), (ssize_t)length );
+	close( fd );
+	return path;
+}
+void
+Test_wstring_mapFile()
+{
+	WStringNamespace s = wstringNamespace;
+
+	autoChar* path = writeTemporaryFile( "Weiße\0Möhren", 14 );
+	autoWString* string = s.mapFile( path );
+	assert_true( wstring_mapped( string ));
+	assert_equal( wstring_capacity( string ), 0 );
+	assert_equal( wstring_sizeBytes( string ), 15 );
+	assert_equal( wstring_size( string ), 12 );
+	assert_true( memcmp( string->cstring, "Weiße\0Möhren", 15 ) == 0 );
+
+	s.appendc( string, "!" );
+	assert_false( wstring_mapped( string ));
+	assert_true( wstring_capacity( string ) >= 16 );
+	assert_true( memcmp( string->cstring, "Weiße\0Möhren!", 16 ) == 0 );
+	unlink( path );
+
+	//A file of whole pages needs another page for the 0 terminator.
+	size_t pageSize = sysconf( _SC_PAGESIZE );
+	autoChar* page = malloc( pageSize );
+	memset( page, 'x', pageSize );
+	autoChar* pagePath = writeTemporaryFile( page, pageSize );
+	autoWString* pageString = s.mapFile( pagePath );
+	assert_equal( wstring_size( pageString ), pageSize );
+	assert_equal( pageString->cstring[pageSize], '\0' );
+	s.toUpper( pageString );
+	assert_equal( pageString->cstring[0], 'X' );
+	assert_false( wstring_mapped( pageString ));
+	unlink( pagePath );
+
+	autoChar* emptyPath = writeTemporaryFile( "", 0 );
+	autoWString* empty = s.mapFile( emptyPath );
+	assert_true( wstring_empty( empty ));
+	s.unmap( empty );
+	assert_false( wstring_mapped( empty ));
+	s.appendc( empty, "Möhren" );
+	assert_strequal( empty->cstring, "Möhren" );
+
+	autoWString* cleared = s.mapFile( emptyPath );
+	s.clear( cleared );
+	assert_false( wstring_mapped( cleared ));
+	unlink( emptyPath );
+
+	//Characters are counted on first use, by any function.
+	autoChar* lazyPath = writeTemporaryFile( "Weiße Möhren", 14 );
+	autoWString* heap = s.dup( "Weiße " );
+	WString* lazy = s.mapFile( lazyPath );
+	s.append( heap, lazy );
+	assert_equal( wstring_size( heap ), 18 );
+	wstring_delete( &lazy );
+
+	lazy = s.mapFile( lazyPath );
+	assert_equal( s.at( lazy, 11 ), 'n' );
+	wstring_delete( &lazy );
+
+	lazy = s.mapFile( lazyPath );
+	autoWString* sliced = s.slice( lazy, 6, 100 );
+	assert_strequal( sliced->cstring, "Möhren" );
+	wstring_delete( &lazy );
+
+	lazy = s.mapFile( lazyPath );
+	s.erase( lazy, 0, 6 );
+	assert_strequal( lazy->cstring, "Möhren" );
+	assert_equal( wstring_size( lazy ), 6 );
+	wstring_delete( &lazy );
+
+	lazy = s.mapFile( lazyPath );
+	s.rjust( lazy, 14 );
+	assert_strequal( lazy->cstring, "Weiße Möhren  " );
+	wstring_delete( &lazy );
+
+	lazy = s.mapFile( lazyPath );
+	autoWString* other = s.dup( "Weiße Möhre" );
+	assert_equal( s.similarity( lazy, other ), 1 );
+	assert_false( s.equals( lazy, other ));
+	wstring_delete( &lazy );
+	unlink( lazyPath );
+
+	assert_null( s.mapFile( "/nonexistent/wstring" ));
+	assert_null( s.mapFile( "/tmp" ));
+}
+void
+Test_wstring_readLine()
+{
+	WStringNamespace s = wstringNamespace;
+
+	const char text[] = "Weiße Möhren\n\nmit Äpfeln\r\nohne Zeilenende";
+	autoChar* path = writeTemporaryFile( text, sizeof( text ) - 1 );
+	const char* lines[] = { "Weiße Möhren", "", "mit Äpfeln\r", "ohne Zeilenende" };
+	size_t sizes[] = { 12, 0, 11, 15 };
+
+	FILE* file = fopen( path, "r" );
+	autoWString* line = s.new( "", 0 );
+	for ( size_t i = 0; i < 4; i++ ) {
+		assert_true( s.readLine( line, file ) == line );
+		assert_strequal( line->cstring, lines[i] );
+		assert_equal( wstring_size( line ), sizes[i] );
+	}
+	assert_null( s.readLine( line, file ));
+	assert_true( wstring_empty( line ));
+	fclose( file );
+
+	//A tiny buffer splits lines and characters between reads.
+	for ( size_t capacity = 1; capacity <= 5; capacity += 2 ) {
+		int fd = open( path, O_RDONLY );
+		WStringReader* reader = wstringreader_new( fd, capacity );
+		size_t oldCapacity = wstring_capacity( line );
+		for ( size_t i = 0; i < 4; i++ ) {
+			assert_true( s.readLineFd( line, reader ) == line );
+			assert_strequal( line->cstring, lines[i] );
+			assert_equal( wstring_size( line ), sizes[i] );
+		}
+		assert_equal( wstring_capacity( line ), oldCapacity );
+		errno = EINVAL;
+		assert_null( s.readLineFd( line, reader ));
+		assert_equal( errno, 0 );
+		assert_null( s.readLineFd( line, reader ));
+		assert_equal( wstringreader_error( reader ), 0 );
+		wstringreader_delete( &reader );
+		assert_null( reader );
+		close( fd );
+	}
+
+	int fd = open( path, O_RDONLY );
+	WStringReader* reader = wstringreader_new( fd, 0 );
+	autoWString* first = s.readLineFd( NULL, reader );
+	assert_strequal( first->cstring, "Weiße Möhren" );
+	wstringreader_delete( &reader );
+	close( fd );
+	unlink( path );
+
+	//A read error in the middle of a line ends the reading without a line.
+	autoChar* failingPath = writeTemporaryFile( "ab\ncdefgh\n", 10 );
+	fd = open( failingPath, O_RDONLY );
+	reader = wstringreader_new( fd, 4 );
+	assert_strequal( s.readLineFd( line, reader )->cstring, "ab" );
+	int writeOnly = open( failingPath, O_WRONLY );
+	dup2( writeOnly, fd );
+	close( writeOnly );
+	assert_null( s.readLineFd( line, reader ));
+	assert_equal( errno, EBADF );
+	assert_equal( wstringreader_error( reader ), EBADF );
+	assert_strequal( line->cstring, "c" );
+	errno = 0;
+	assert_null( s.readLineFd( line, reader ));
+	assert_equal( errno, EBADF );
+	wstringreader_delete( &reader );
+	close( fd );
+	unlink( failingPath );
+
+	autoChar* emptyPath = writeTemporaryFile( "", 0 );
+	file = fopen( emptyPath, "r" );
+	assert_null( s.readLine( NULL, file ));
+	fclose( file );
+	unlink( emptyPath );
+}
+void
+Test_wstringlines()
+{
+	const char text[] = "Weiße Möhren\n\nmit Äpfeln und Birnen\nohne Zeilenende";
+	autoChar* path = writeTemporaryFile( text, sizeof( text ) - 1 );
+	const char* expected[] = { "Weiße Möhren", "", "mit Äpfeln und Birnen", "ohne Zeilenende" };
+
+	WStringLines* lines = wstringlines_new( path, '\n' );
+	WStringView line;
+	for ( size_t i = 0; i < 4; i++ ) {
+		assert_true( wstringlines_next( lines, &line ));
+		autoWString* string = wstring_fromView( line );
+		assert_strequal( string->cstring, expected[i] );
+	}
+	assert_false( wstringlines_next( lines, &line ));
+	assert_false( wstringlines_next( lines, &line ));
+	wstringlines_delete( &lines );
+	assert_null( lines );
+	unlink( path );
+
+	autoChar* recordsPath = writeTemporaryFile( "a\0bb\0\0", 6 );
+	lines = wstringlines_new( recordsPath, '\0' );
+	size_t lengths[] = { 1, 2, 0 };
+	for ( size_t i = 0; i < 3; i++ ) {
+		assert_true( wstringlines_next( lines, &line ));
+		assert_equal( line.length, lengths[i] );
+	}
+	assert_false( wstringlines_next( lines, &line ));
+	wstringlines_delete( &lines );
+	unlink( recordsPath );
+
+	autoChar* emptyPath = writeTemporaryFile( "", 0 );
+	lines = wstringlines_new( emptyPath, '\n' );
+	assert_false( wstringlines_next( lines, &line ));
+	wstringlines_delete( &lines );
+	unlink( emptyPath );
+
+	assert_null( wstringlines_new( "/nonexistent/wstring", '\n' ));
+}
+void
+Test_wstring_writeAll()
+{
+	//More strings than writev() takes at once, some of them empty.
+	enum { n = 3000 };
+	WString* strings[n];
+	autoWString* expected = wstring_new( "", 0 );
+	for ( size_t i = 0; i < n; i++ ) {
+		strings[i] = wstring_new( "", 0 );
+		if ( i % 7 )
+			wstring_appendf( strings[i], "Möhre %zu;", i );
+		wstring_append( expected, strings[i] );
+	}
+
+	autoChar* path = writeTemporaryFile( "", 0 );
+	int fd = open( path, O_WRONLY | O_TRUNC );
+	assert_true( wstring_writeAll( fd, (const WString**)strings, n ));
+	assert_true( wstring_writeAll( fd, NULL, 0 ));
+	close( fd );
+
+	autoWString* written = wstring_mapFile( path );
+	assert_equal( wstring_sizeBytes( written ), wstring_sizeBytes( expected ));
+	assert_true( wstring_equals( written, expected ));
+	unlink( path );
+
+	assert_false( wstring_writeAll( fd, (const WString**)&strings[1], 1 ));
+	for ( size_t i = 0; i < n; i++ )
+		wstring_delete( &strings[i] );
+}
+void
+Test_wstring_appendMove()
+{
+	autoWString* string = wstring_new( "", 0 );
+	WString* other = wstring_dup( "Weiße " );
+	char* buffer = other->cstring;
+	wstring_appendMove( string, &other );
+	assert_null( other );
+	assert_true( string->cstring == buffer );
+	assert_strequal( string->cstring, "Weiße " );
+
+	other = wstring_new( "Möhren", 100 );
+	buffer = other->cstring;
+	wstring_appendMove( string, &other );
+	assert_true( string->cstring == buffer );
+	assert_strequal( string->cstring, "Weiße Möhren" );
+	assert_equal( wstring_size( string ), 12 );
+
+	other = wstring_dup( "!" );
+	wstring_appendMove( string, &other );
+	assert_strequal( string->cstring, "Weiße Möhren!" );
+}
 
 //---------------------------------------------------------------------------------
 
@@ -140,6 +517,32 @@ Test_wstring_compareCompareCaseEquals()
 	assert_greater( wstring_compareCase( string4a, string4b ), 0 );
 	assert_false( wstring_equals( string4a, string4b ));
 }
+
+void
+Test_wstring_compareCase()
+{
+	char* oldLocale = setlocale( LC_CTYPE, "" );
+
+	autoWString* string1a = s.dup( "Weiße Möhren aus dem Garten" );
+	autoWString* string1b = s.dup( "WEIßE MÖHREN AUS DEM GARTEN" );
+	assert_equal( s.compareCase( string1a, string1b ), 0 );
+
+	autoWString* string2a = s.dup( "Weiße Möhren aus dem Garten" );
+	autoWString* string2b = s.dup( "WEIßE MÖHREN AUS DEM GARTEn!" );
+	assert_less( s.compareCase( string2a, string2b ), 0 );
+	assert_greater( s.compareCase( string2b, string2a ), 0 );
+
+	autoWString* string3a = s.dup( "Ärger" );
+	autoWString* string3b = s.dup( "Zorn" );
+	assert_greater( s.compareCase( string3a, string3b ), 0 );		//Ä after Z like the lower case characters
+
+	autoWString* string4a = s.dup( "Abcdefgh_ijklmnop" );
+	autoWString* string4b = s.dup( "ABCDEFGH@IJKLMNOP" );
+	assert_greater( s.compareCase( string4a, string4b ), 0 );
+	assert_less( s.compareCase( string4b, string4a ), 0 );
+
+	setlocale( LC_CTYPE, oldLocale );
+}
 void
 Test_wstring_contains()
 {
@@ -210,6 +613,56 @@ Test_wstring_similarity()
 	setlocale( LC_CTYPE, oldLocale );
 }
 
+void
+Test_wstring_hash()
+{
+	autoWString* string1 = s.dup( "" );
+	autoWString* string2 = s.dup( "Weiße Möhren" );
+	autoWString* string3 = s.dup( "Weiße Möhren" );
+	autoWString* string4 = s.dup( "Weiße Möhren!" );
+	autoWString* string5 = s.dup( "Alle meine Entchen schwimmen auf dem See" );
+	autoWString* string6 = s.dup( "Alle meine Entchen schwimmen auf dem Sea" );
+
+	assert_true( wstring_hash( string2 ) == wstring_hash( string3 ));
+	assert_true( wstring_hash( string1 ) != wstring_hash( string2 ));
+	assert_true( wstring_hash( string2 ) != wstring_hash( string4 ));
+	assert_true( wstring_hash( string5 ) != wstring_hash( string6 ));
+	assert_true( wstring_hash( string5 ) == wstring_hashView( wstring_viewc( "Alle meine Entchen schwimmen auf dem See" )));
+	assert_true( wstring_hashView( wstring_viewc( "a" )) != wstring_hashView( wstring_viewc( "b" )));
+}
+
+void
+Test_wstring_signature()
+{
+	autoWString* message = s.dup( "GET /api/users/42 HTTP/1.1 200 OK" );
+	WStringSignature signature = s.signature( message );
+
+	//Never rejects contained strings
+	WStringView view = wstring_view( message );
+	size_t wrong = 0;
+	for ( size_t start = 0; start < view.length; start++ )
+		for ( size_t length = 0; start + length <= view.length; length++ ) {
+			WStringSignature searchSignature = wstring_signatureView( (WStringView){ &view.bytes[start], length });
+			wrong += !wstring_signatureMayContain( &signature, &searchSignature );
+		}
+	assert_equal( wrong, 0 );
+
+	WStringSignature empty = wstring_signatureView( wstring_viewc( "" ));
+	WStringSignature single = wstring_signatureView( wstring_viewc( "x" ));
+	assert_true( wstring_signatureMayContain( &signature, &empty ));
+	assert_true( wstring_signatureMayContain( &signature, &single ));
+	assert_true( wstring_signatureMayContain( &empty, &empty ));
+
+	//Rejects most strings not contained
+	size_t rejected = 0;
+	for ( size_t i = 0; i < 1000; i++ ) {
+		autoWString* search = s.printf( "error %zu", i );
+		WStringSignature searchSignature = s.signature( search );
+		rejected += !wstring_signatureMayContain( &signature, &searchSignature );
+	}
+	assert_greater( rejected, 990 );
+}
+
 //---------------------------------------------------------------------------------
 
 void
@@ -253,6 +706,223 @@ Test_wstring_appendf()
 
 	s.appendf( string, "%s%u", " Test", 1234 );
 	assert_strequal( string->cstring, "Test1234 Test Test1234" );
+
+	autoWString* string2 = s.new( "", 4 );
+	s.appendf( string2, "%s", "Weiße Möhren" );
+	assert_strequal( string2->cstring, "Weiße Möhren" );
+	assert_equal( wstring_size( string2 ), 12 );
+
+	s.appendf( string2, " %d%s", 42, "ß" );
+	assert_strequal( string2->cstring, "Weiße Möhren 42ß" );
+	assert_equal( wstring_size( string2 ), 16 );
+
+	//String values are formatted once into the string without a temporary buffer, unless
+	//they point into the string itself.
+	autoWString* line = s.new( "", 100 );
+	const char* method = "GET";
+	countFormatting = true;
+	numberFormatting = 0;
+	s.appendf( line, "%s %-10s %5.1f %zu %lld %c %ls %p %%", method, "/index", 0.25, (size_t)200, -1LL, 'x', L"x", NULL );
+	s.setf( line, "%*s %.*s", 4, method, 2, method );
+	countFormatting = false;
+	assert_equal( numberFormatting, 2 );
+	assert_strequal( line->cstring, " GET GE" );
+
+	countFormatting = true;
+	numberFormatting = 0;
+	s.appendf( line, "%d %s", 1, &line->cstring[1] );
+	countFormatting = false;
+	assert_equal( numberFormatting, 2 );
+	assert_strequal( line->cstring, " GET GE1 GET GE" );
+
+	//Values may point into the string, also when it grows.
+	autoWString* string3 = s.new( "abc", 8 );
+	s.appendf( string3, "%s", string3->cstring );
+	assert_strequal( string3->cstring, "abcabc" );
+	s.appendf( string3, "%s-%s", string3->cstring, string3->cstring );
+	assert_strequal( string3->cstring, "abcabcabcabc-abcabc" );
+	assert_equal( wstring_size( string3 ), 19 );
+}
+void
+Test_wstring_setf()
+{
+	autoWString* string = s.dup("Weiße Möhren");
+	s.setf( string, "%d", 1234 );
+	assert_strequal( string->cstring, "1234" );
+	assert_equal( wstring_size( string ), 4 );
+
+	s.setf( string, "" );
+	assert_strequal( string->cstring, "" );
+	assert_true( s.empty( string ));
+
+	s.setf( string, "%s %s", "Weiße", "Möhren und noch viel mehr Möhren" );
+	assert_strequal( string->cstring, "Weiße Möhren und noch viel mehr Möhren" );
+	assert_equal( wstring_size( string ), 38 );
+
+	s.setf( string, "%.6s!", string->cstring );
+	assert_strequal( string->cstring, "Weiße!" );
+	assert_equal( wstring_size( string ), 6 );
+}
+void
+Test_wstring_appendIntUint()
+{
+	autoWString* string = s.dup("");
+	s.appendInt( string, 0 );
+	assert_strequal( string->cstring, "0" );
+
+	s.appendInt( string, -1234 );
+	assert_strequal( string->cstring, "0-1234" );
+
+	wstring_clear( string );
+	s.appendInt( string, INT64_MIN );
+	assert_strequal( string->cstring, "-9223372036854775808" );
+
+	wstring_clear( string );
+	s.appendUint( string, UINT64_MAX );
+	assert_strequal( string->cstring, "18446744073709551615" );
+
+	autoWString* string2 = s.dup("Möhren: ");
+	s.appendUint( string2, 42 );
+	assert_strequal( string2->cstring, "Möhren: 42" );
+	assert_equal( wstring_size( string2 ), 10 );
+}
+void
+Test_wstring_appendDouble()
+{
+	autoWString* string = s.dup("");
+	s.appendDouble( string, 0.1 );
+	assert_strequal( string->cstring, "0.1" );
+
+	wstring_clear( string );
+	s.appendDouble( string, -1234.5 );
+	assert_strequal( string->cstring, "-1234.5" );
+
+	wstring_clear( string );
+	s.appendDouble( string, 100.0 );
+	assert_strequal( string->cstring, "100" );
+
+	wstring_clear( string );
+	s.appendDouble( string, 1e-5 );
+	assert_strequal( string->cstring, "1e-05" );
+
+	wstring_clear( string );
+	s.appendDouble( string, 1.5e300 );
+	assert_strequal( string->cstring, "1.5e+300" );
+
+	wstring_clear( string );
+	s.appendDouble( string, 5e-324 );
+	assert_strequal( string->cstring, "5e-324" );
+
+	wstring_clear( string );
+	s.appendDouble( string, 1.7976931348623157e308 );
+	assert_strequal( string->cstring, "1.7976931348623157e+308" );
+
+	wstring_clear( string );
+	s.appendDouble( string, -0.0 );
+	assert_strequal( string->cstring, "-0" );
+
+	wstring_clear( string );
+	s.appendDouble( string, -INFINITY );
+	assert_strequal( string->cstring, "-inf" );
+
+	wstring_clear( string );
+	s.appendDouble( string, NAN );
+	assert_strequal( string->cstring, "nan" );
+}
+void
+Test_wstring_appendTemplate_positional()
+{
+	WStringTemplate* positional = wstringtemplate_new( "{} + {:d} = {:g}{{{3:u}}}" );
+	assert_nonnull( positional );
+	assert_equal( wstringtemplate_countValues( positional ), 4 );
+	assert_equal( wstringtemplate_index( positional, "x" ), -1 );
+
+	autoWString* string = s.dup( "Möhren: " );
+	wstring_appendTemplate( string, positional, (WStringValue[]){
+		{ .cstring = "Weiße" }, { .i = -12 }, { .d = 0.5 }, { .u = 42 }
+	});
+	assert_strequal( string->cstring, "Möhren: Weiße + -12 = 0.5{42}" );
+	assert_equal( wstring_size( string ), 29 );
+	wstringtemplate_delete( &positional );
+	assert_null( positional );
+
+	WStringTemplate* repeated = wstringtemplate_new( "{1:S}{0}{1:S}" );
+	autoWString* other = s.dup( "ß" );
+	wstring_clear( string );
+	wstring_appendTemplate( string, repeated, (WStringValue[]){ { .cstring = "-" }, { .string = other }});
+	assert_strequal( string->cstring, "ß-ß" );
+	assert_equal( wstring_size( string ), 3 );
+	wstringtemplate_delete( &repeated );
+
+	WStringTemplate* empty = wstringtemplate_new( "" );
+	wstring_appendTemplate( string, empty, NULL );
+	assert_strequal( string->cstring, "ß-ß" );
+	wstringtemplate_delete( &empty );
+}
+void
+Test_wstring_appendTemplate_named()
+{
+	WStringTemplate* logLine = wstringtemplate_new( "{method} {path} -> {status:d} in {time:g}s, {method}" );
+	assert_nonnull( logLine );
+	assert_equal( wstringtemplate_countValues( logLine ), 4 );
+	assert_equal( wstringtemplate_index( logLine, "method" ), 0 );
+	assert_equal( wstringtemplate_index( logLine, "time" ), 3 );
+	assert_equal( wstringtemplate_index( logLine, "size" ), -1 );
+
+	autoWString* string = s.new( "", 1 );
+	for ( int i = 0; i < 3; i++ ) {
+		wstring_clear( string );
+		wstring_appendTemplate( string, logLine, (WStringValue[]){
+			{ .cstring = "GET" }, { .cstring = "/index.html" }, { .i = 200 }, { .d = 0.25 }
+		});
+	}
+	assert_strequal( string->cstring, "GET /index.html -> 200 in 0.25s, GET" );
+	wstringtemplate_delete( &logLine );
+}
+void
+Test_wstring_appendTemplate_self()
+{
+	//Values may point into the string, when it grows and when it does not.
+	WStringTemplate* brackets = wstringtemplate_new( "[{:s}|{:s}|{:S}]" );
+	autoWString* string = s.new( "hello", 6 );
+	wstring_appendTemplate( string, brackets, (WStringValue[]){
+		{ .cstring = string->cstring }, { .cstring = &string->cstring[3] }, { .string = string }
+	});
+	assert_strequal( string->cstring, "hello[hello|lo|hello]" );
+	assert_equal( wstring_size( string ), 21 );
+
+	wstring_truncate( string, 2 );
+	wstring_reserve( string, 100 );
+	wstring_appendTemplate( string, brackets, (WStringValue[]){
+		{ .cstring = string->cstring }, { .cstring = &string->cstring[2] }, { .string = string }
+	});
+	assert_strequal( string->cstring, "he[he||he]" );
+	wstringtemplate_delete( &brackets );
+}
+void
+Test_wstring_appendTemplate_malformed()
+{
+	assert_null( wstringtemplate_new( "{" ));
+	assert_null( wstringtemplate_new( "}" ));
+	assert_null( wstringtemplate_new( "{name" ));
+	assert_null( wstringtemplate_new( "{:x}" ));
+	assert_null( wstringtemplate_new( "{} {name}" ));
+	assert_null( wstringtemplate_new( "{name} {0}" ));
+	assert_null( wstringtemplate_new( "{1}" ));
+	assert_null( wstringtemplate_new( "{0:d} {0:s}" ));
+	assert_null( wstringtemplate_new( "{99999}" ));
+
+	//At most 1024 values
+	autoWString* format = wstring_new( "", 0 );
+	for ( size_t i = 0; i < 1024; i++ )
+		wstring_appendf( format, "{v%zu}", i );
+	WStringTemplate* largest = wstringtemplate_new( format->cstring );
+	assert_equal( wstringtemplate_countValues( largest ), 1024 );
+	assert_equal( wstringtemplate_index( largest, "v1023" ), 1023 );
+	wstringtemplate_delete( &largest );
+
+	wstring_appendc( format, "{v1024}" );
+	assert_null( wstringtemplate_new( format->cstring ));
 }
 void
 Test_wstring_prepend()
@@ -278,6 +948,153 @@ Test_wstring_prepend()
 	assert_strequal( wstring_prepend( string9, string10 )->cstring, "Weiße Möhren" );
 }
 
+void
+Test_wstring_join()
+{
+	autoWString* string1 = s.join( ", ", NULL, 0 );
+	assert_strequal( string1->cstring, "" );
+
+	WString* words[] = { s.dup( "Weiße" ), s.dup( "" ), s.dup( "Möhren" ) };
+	autoWString* string2 = s.join( ", ", words, 1 );
+	assert_strequal( string2->cstring, "Weiße" );
+
+	autoWString* string3 = s.join( ", ", words, 3 );
+	assert_strequal( string3->cstring, "Weiße, , Möhren" );
+	assert_equal( wstring_size( string3 ), 15 );
+	assert_equal( wstring_sizeBytes( string3 ), 18 );
+
+	autoWString* string4 = s.join( "", words, 3 );
+	assert_strequal( string4->cstring, "WeißeMöhren" );
+
+	autoWString* string5 = s.join( "ß", words, 3 );
+	assert_strequal( string5->cstring, "WeißeßßMöhren" );
+	assert_equal( wstring_size( string5 ), 13 );
+
+	for ( size_t i = 0; i < 3; i++ )
+		wstring_delete( &words[i] );
+}
+void
+Test_wstring_joinViews()
+{
+	const char* line = "GET /index.html HTTP/1.1";
+	WStringView views[] = {
+		{ &line[4], 11 },
+		wstring_viewc( "Möhren" ),
+		{ line, 3 },
+	};
+
+	autoWString* string1 = s.joinViews( wstring_viewc( " | " ), views, 3 );
+	assert_strequal( string1->cstring, "/index.html | Möhren | GET" );
+	assert_equal( wstring_size( string1 ), 26 );
+
+	autoWString* string2 = s.joinViews( wstring_viewc( "" ), views, 0 );
+	assert_strequal( string2->cstring, "" );
+
+	autoWString* string3 = s.fromView( views[0] );
+	assert_strequal( string3->cstring, "/index.html" );
+
+	autoWString* string4 = s.joinViews( wstring_view( string3 ), views, 2 );
+	assert_strequal( string4->cstring, "/index.html/index.htmlMöhren" );
+}
+
+void
+Test_wstring_insert()
+{
+	WStringNamespace s = wstringNamespace;
+
+	autoWString* string = s.new( "Grüße", 6 );
+	s.insert( string, 3, "ß" );
+	assert_strequal( string->cstring, "Grüßße" );
+	assert_equal( wstring_size( string ), 6 );
+
+	s.insert( string, 0, "Viele " );
+	s.insert( string, wstring_size( string ), "!" );
+	assert_strequal( string->cstring, "Viele Grüßße!" );
+	assert_equal( wstring_size( string ), 13 );
+
+	s.insert( string, 4, "" );
+	assert_strequal( string->cstring, "Viele Grüßße!" );
+}
+
+void
+Test_wstring_erase()
+{
+	WStringNamespace s = wstringNamespace;
+
+	autoWString* string = s.dup( "Viele Grüßße!" );
+	s.erase( string, 9, 1 );
+	assert_strequal( string->cstring, "Viele Grüße!" );
+	assert_equal( wstring_size( string ), 12 );
+
+	s.erase( string, 0, 6 );
+	assert_strequal( string->cstring, "Grüße!" );
+	s.erase( string, 4, 100 );
+	assert_strequal( string->cstring, "Grüß" );
+	assert_equal( wstring_size( string ), 4 );
+	s.erase( string, 4, 1 );
+	assert_strequal( string->cstring, "Grüß" );
+}
+
+void
+Test_wstring_at()
+{
+	WStringNamespace s = wstringNamespace;
+
+	autoWString* ascii = s.dup( "Hello" );
+	assert_equal( s.at( ascii, 0 ), 'H' );
+	assert_equal( s.at( ascii, 4 ), 'o' );
+
+	autoWString* string = s.dup( "Grüße €𝄞" );
+	assert_equal( s.at( string, 2 ), 0xFC );
+	assert_equal( s.at( string, 3 ), 0xDF );
+	assert_equal( s.at( string, 6 ), 0x20AC );
+	assert_equal( s.at( string, 7 ), 0x1D11E );
+
+	//Long enough for the character index, which must follow changes of the string.
+	autoWString* mixed = s.new( "", 0 );
+	for ( size_t i = 0; i < 1000; i++ )
+		s.appendc( mixed, i % 3 ? "a" : "ö" );
+
+	size_t wrong = 0;
+	for ( size_t i = 0; i < 1000; i += 7 )
+		wrong += s.at( mixed, i ) != ( i % 3 ? 'a' : 0xF6 );
+	assert_equal( wrong, 0 );
+
+	s.appendc( mixed, "€" );
+	assert_equal( s.at( mixed, 1000 ), 0x20AC );
+	s.insert( mixed, 500, "€" );
+	assert_equal( s.at( mixed, 500 ), 0x20AC );
+	assert_equal( s.at( mixed, 1000 ), 0xF6 );
+	s.erase( mixed, 0, 2 );
+	assert_equal( s.at( mixed, 998 ), 0xF6 );
+	s.truncate( mixed, 800 );
+	assert_equal( wstring_size( mixed ), 800 );
+	s.appendc( mixed, "ä" );
+	assert_equal( s.at( mixed, 800 ), 0xE4 );
+}
+
+void
+Test_wstring_slice()
+{
+	WStringNamespace s = wstringNamespace;
+
+	autoWString* string = s.dup( "Grüße" );
+	autoWString* slice1 = s.slice( string, 1, 4 );
+	assert_strequal( slice1->cstring, "rüß" );
+	assert_equal( wstring_size( slice1 ), 3 );
+
+	autoWString* slice2 = s.slice( string, 3, 100 );
+	assert_strequal( slice2->cstring, "ße" );
+	autoWString* slice3 = s.slice( string, 4, 2 );
+	assert_strequal( slice3->cstring, "" );
+
+	autoWString* mixed = s.new( "", 0 );
+	for ( size_t i = 0; i < 300; i++ )
+		s.appendc( mixed, i % 2 ? "x" : "€" );
+	autoWString* slice4 = s.slice( mixed, 200, 204 );
+	assert_strequal( slice4->cstring, "€x€x" );
+}
+
 //---------------------------------------------------------------------------------
 
 void
@@ -385,6 +1202,12 @@ Test_wstring_squeeze()
 
 	autoWString *string8 = wstring_dup( "         heiße   Sägezähne         " );
 	assert_strequal( wstring_squeeze( string8 )->cstring, " heiße Sägezähne " );
+
+	autoWString *string9 = wstring_newBytes( "a  \0b  \0\0", 9 );
+	wstring_squeeze( string9 );
+	assert_equal( wstring_sizeBytes( string9 ), 8 );
+	assert_equal( wstring_size( string9 ), 7 );
+	assert_true( memcmp( string9->cstring, "a \0b \0\0", 8 ) == 0 );
 }
 
 //---------------------------------------------------------------------------------
@@ -661,6 +1484,149 @@ Test_wstring_split_noSubstringsFound()
 
 //---------------------------------------------------------------------------------
 
+static int compareStrings( const void* a, const void* b ) {
+	return wstring_compare( *(WString* const*)a, *(WString* const*)b );
+}
+void
+Test_wstring_sortArray()
+{
+	wstring_sortArray( NULL, 0 );
+
+	WString* strings1[] = { s.dup( "Möhren" ), s.dup( "" ), s.dup( "Weiße" ), s.dup( "Möhre" ), s.dup( "" ) };
+	wstring_sortArray( strings1, 5 );
+	assert_strequal( strings1[0]->cstring, "" );
+	assert_strequal( strings1[1]->cstring, "" );
+	assert_strequal( strings1[2]->cstring, "Möhre" );
+	assert_strequal( strings1[3]->cstring, "Möhren" );
+	assert_strequal( strings1[4]->cstring, "Weiße" );
+	for ( size_t i = 0; i < 5; i++ )
+		wstring_delete( &strings1[i] );
+
+	//Many strings with long common prefixes and duplicates
+	enum { Number = 2000 };
+	WString* strings2[Number];
+	WString* expected[Number];
+	unsigned random = 42;
+	for ( size_t i = 0; i < Number; i++ ) {
+		random = random * 1103515245 + 12345;
+		strings2[i] = s.printf( "https://example.com/path/%u/ä%u", ( random >> 16 ) % 50, ( random >> 8 ) % 300 );
+		if ( i % 7 == 0 )
+			wstring_truncate( strings2[i], ( random >> 4 ) % 40 );
+		expected[i] = strings2[i];
+	}
+
+	wstring_sortArray( strings2, Number );
+	qsort( expected, Number, sizeof( WString* ), compareStrings );
+
+	size_t wrong = 0;
+	for ( size_t i = 0; i < Number; i++ )
+		wrong += !wstring_equals( strings2[i], expected[i] );
+	assert_equal( wrong, 0 );
+
+	for ( size_t i = 0; i < Number; i++ )
+		wstring_delete( &strings2[i] );
+}
+
+void
+Test_wstring_sortKey()
+{
+	char* oldLocale = setlocale( LC_CTYPE, "" );
+
+	autoWString* string1 = s.dup( "Weiße MÖHREN" );
+	autoWString* key1 = s.sortKey( string1, WStringCollationIgnoreCase );
+	assert_strequal( key1->cstring, "weiße möhren" );
+	assert_equal( wstring_size( key1 ), 12 );
+	autoWString* string2 = s.dup( "" );
+	autoWString* key2 = s.sortKey( string2, WStringCollationSimple );
+	assert_strequal( key2->cstring, "\x01\x01" );
+	autoWString* string3 = s.dup( "Straße\t" );
+	autoWString* key3 = s.sortKey( string3, WStringCollationSimple );
+	assert_strequal( key3->cstring, "strasse\x01straße\x01Straße\t" );
+
+	enum { Number = 8 };
+	const char* words[Number] = { "Bär", "Zebra", "bar", "Äpfel", "apple", "Bar", "äpfel", "Apfel" };
+	const char* sorted[Number] = { "Apfel", "Äpfel", "äpfel", "apple", "Bar", "bar", "Bär", "Zebra" };
+	WString* keys[Number];
+	for ( size_t i = 0; i < Number; i++ ) {
+		autoWString* word = s.dup( words[i] );
+		keys[i] = s.appendc( s.sortKey( word, WStringCollationSimple ), "\x01" );
+		s.appendc( keys[i], words[i] );		//Keep the word to check the order
+	}
+
+	wstring_sortArray( keys, Number );
+	for ( size_t i = 0; i < Number; i++ ) {
+		const char* word = strrchr( keys[i]->cstring, '\x01' ) + 1;
+		assert_strequal( word, sorted[i] );
+		wstring_delete( &keys[i] );
+	}
+
+	setlocale( LC_CTYPE, oldLocale );
+}
+
+void
+Test_wstring_containsFindCase()
+{
+	char* oldLocale = setlocale( LC_CTYPE, "" );
+
+	autoWString* string = s.dup( "Content-Type: text/html; CHARSET=UTF-8, Größe: ÜBERGRÖSSE" );
+	autoWString* search1 = s.dup( "content-type" );
+	autoWString* search2 = s.dup( "charset=utf-8" );
+	autoWString* search3 = s.dup( "übergrösse" );
+	autoWString* search4 = s.dup( "Größer" );
+	autoWString* search5 = s.dup( "" );
+	assert_true( s.containsCase( string, search1 ));
+	assert_true( s.containsCase( string, search2 ));
+	assert_true( s.containsCase( string, search3 ));
+	assert_false( s.containsCase( string, search4 ));
+	assert_true( s.containsCase( string, search5 ));
+	assert_false( s.contains( string, search2 ));
+
+	WStringView match = s.findCase( string, search2 );
+	assert_true( match.bytes == &string->cstring[25] );
+	assert_equal( match.length, 13 );
+	match = s.findCase( string, search3 );
+	assert_true( match.bytes == &string->cstring[49] );
+	assert_equal( match.length, 12 );
+	match = s.findCase( string, search4 );
+	assert_true( match.bytes == NULL );
+	assert_equal( match.length, 0 );
+
+	autoWString* empty = s.dup( "" );
+	assert_false( s.containsCase( empty, search1 ));
+	assert_true( s.containsCase( empty, search5 ));
+
+	setlocale( LC_CTYPE, oldLocale );
+}
+
+void
+Test_wstring_replaceAllCase()
+{
+	char* oldLocale = setlocale( LC_CTYPE, "" );
+
+	autoWString* string1 = s.dup( "Test TEST test tEsT Tes" );
+	s.replaceAllCase( string1, "test", "Probe" );
+	assert_strequal( string1->cstring, "Probe Probe Probe Probe Tes" );
+	assert_equal( wstring_size( string1 ), 27 );
+
+	autoWString* string2 = s.dup( "Über über ÜBER" );
+	s.replaceAllCase( string2, "ÜBER", "" );
+	assert_strequal( string2->cstring, "  " );
+	assert_equal( wstring_size( string2 ), 2 );
+
+	autoWString* string3 = s.dup( "aaaaAAAAaaaaAAAA" );
+	s.replaceAllCase( string3, "A", "bcd" );
+	assert_strequal( string3->cstring, "bcdbcdbcdbcdbcdbcdbcdbcdbcdbcdbcdbcdbcdbcdbcdbcd" );
+
+	autoWString* string4 = s.dup( "Nothing to replace" );
+	s.replaceAllCase( string4, "cowboy", "cowgirl" );
+	s.replaceAllCase( string4, "", "cowgirl" );
+	assert_strequal( string4->cstring, "Nothing to replace" );
+
+	setlocale( LC_CTYPE, oldLocale );
+}
+
+//---------------------------------------------------------------------------------
+
 void
 Test_wstring_replaceAll_simple()
 {
@@ -738,6 +1704,129 @@ Test_wstring_toDouble()
 	assert_dequal( s.toDouble( string8 ), -1234.567 );
 }
 
+void
+Test_wstring_parseInt64()
+{
+	int64_t value;
+	size_t consumed;
+
+	assert_equal( wstring_parseInt64( "", 0, &value, &consumed ), WStringParseNoNumber );
+	assert_equal( wstring_parseInt64( "-", 1, &value, &consumed ), WStringParseNoNumber );
+	assert_equal( wstring_parseInt64( " 1", 2, &value, &consumed ), WStringParseNoNumber );
+
+	assert_equal( wstring_parseInt64( "1234;5678", 9, &value, &consumed ), WStringParseOk );
+	assert_true( value == 1234 );
+	assert_true( consumed == 4 );
+
+	assert_equal( wstring_parseInt64( "-123456789012345678", 19, &value, &consumed ), WStringParseOk );
+	assert_true( value == -123456789012345678 );
+	assert_true( consumed == 19 );
+
+	assert_equal( wstring_parseInt64( "12345", 3, &value, &consumed ), WStringParseOk );
+	assert_true( value == 123 );
+	assert_true( consumed == 3 );
+
+	assert_equal( wstring_parseInt64( "9223372036854775807", 19, &value, NULL ), WStringParseOk );
+	assert_true( value == INT64_MAX );
+
+	assert_equal( wstring_parseInt64( "-9223372036854775808", 20, &value, NULL ), WStringParseOk );
+	assert_true( value == INT64_MIN );
+
+	assert_equal( wstring_parseInt64( "9223372036854775808", 19, &value, &consumed ), WStringParseOutOfRange );
+	assert_true( value == INT64_MAX );
+	assert_true( consumed == 19 );
+}
+void
+Test_wstring_parseUint64()
+{
+	uint64_t value;
+	size_t consumed;
+
+	assert_equal( wstring_parseUint64( "-1", 2, &value, &consumed ), WStringParseNoNumber );
+
+	assert_equal( wstring_parseUint64( "+0000000000000000000000042x", 27, &value, &consumed ), WStringParseOk );
+	assert_true( value == 42 );
+	assert_true( consumed == 26 );
+
+	assert_equal( wstring_parseUint64( "18446744073709551615", 20, &value, NULL ), WStringParseOk );
+	assert_true( value == UINT64_MAX );
+
+	assert_equal( wstring_parseUint64( "18446744073709551616", 20, &value, &consumed ), WStringParseOutOfRange );
+	assert_true( value == UINT64_MAX );
+	assert_true( consumed == 20 );
+}
+void
+Test_wstring_parseHex()
+{
+	uint64_t value;
+	size_t consumed;
+
+	assert_equal( wstring_parseHex( "xyz", 3, &value, &consumed ), WStringParseNoNumber );
+
+	assert_equal( wstring_parseHex( "0xg", 3, &value, &consumed ), WStringParseOk );
+	assert_true( value == 0 );
+	assert_true( consumed == 1 );
+
+	assert_equal( wstring_parseHex( "ff", 2, &value, &consumed ), WStringParseOk );
+	assert_true( value == 255 );
+	assert_true( consumed == 2 );
+
+	assert_equal( wstring_parseHex( "0XDeadBeefCafeBabe!", 19, &value, &consumed ), WStringParseOk );
+	assert_true( value == 0xDEADBEEFCAFEBABE );
+	assert_true( consumed == 18 );
+
+	assert_equal( wstring_parseHex( "10000000000000000", 17, &value, NULL ), WStringParseOutOfRange );
+	assert_true( value == UINT64_MAX );
+}
+void
+Test_wstring_parseDouble()
+{
+	double value;
+	size_t consumed;
+
+	assert_equal( wstring_parseDouble( "", 0, &value, &consumed ), WStringParseNoNumber );
+	assert_equal( wstring_parseDouble( ".", 1, &value, &consumed ), WStringParseNoNumber );
+	assert_equal( wstring_parseDouble( "-e5", 3, &value, &consumed ), WStringParseNoNumber );
+
+	assert_equal( wstring_parseDouble( "1.5;", 4, &value, &consumed ), WStringParseOk );
+	assert_true( value == 1.5 );
+	assert_true( consumed == 3 );
+
+	assert_equal( wstring_parseDouble( "-.25e+2", 7, &value, &consumed ), WStringParseOk );
+	assert_true( value == -25.0 );
+	assert_true( consumed == 7 );
+
+	assert_equal( wstring_parseDouble( "7e", 2, &value, &consumed ), WStringParseOk );
+	assert_true( value == 7.0 );
+	assert_true( consumed == 1 );
+
+	assert_equal( wstring_parseDouble( "0.1", 3, &value, NULL ), WStringParseOk );
+	assert_true( value == 0.1 );
+
+	assert_equal( wstring_parseDouble( "2.2250738585072011e-308", 23, &value, NULL ), WStringParseOk );
+	assert_true( value == 2.2250738585072011e-308 );
+
+	assert_equal( wstring_parseDouble( "4.9e-324", 8, &value, NULL ), WStringParseOk );
+	assert_true( value == 4.9e-324 );
+
+	assert_equal( wstring_parseDouble( "9007199254740993.000000000000000000001", 38, &value, NULL ), WStringParseOk );
+	assert_true( value == 9007199254740994.0 );
+
+	assert_equal( wstring_parseDouble( "123456789012345678901234567890", 30, &value, NULL ), WStringParseOk );
+	assert_true( value == 123456789012345678901234567890.0 );
+
+	assert_equal( wstring_parseDouble( "1e400", 5, &value, NULL ), WStringParseOutOfRange );
+	assert_true( isinf( value ));
+
+	assert_equal( wstring_parseDouble( "-Infinity", 9, &value, &consumed ), WStringParseOk );
+	assert_true( isinf( value ) );
+	assert_true( value < 0 );
+	assert_true( consumed == 9 );
+
+	assert_equal( wstring_parseDouble( "NaN", 3, &value, NULL ), WStringParseOk );
+	assert_true( isnan( value ));
+}
+
 //---------------------------------------------------------------------------------
 
 int main()
@@ -745,17 +1834,42 @@ int main()
 	printf( "\n" );
 
 	testsuite( Test_wstring_newDup );
+	testsuite( Test_wstring_newBytes );
 	testsuite( Test_wstring_printf );
 	testsuite( Test_wstring_clone );
 	testsuite( Test_wstring_stealCstring );
+	testsuite( Test_wstring_adoptSwap );
+	testsuite( Test_wstring_appendMove );
+	testsuite( Test_wstring_capacity );
+	testsuite( Test_wstring_mapFile );
+	testsuite( Test_wstring_readLine );
+	testsuite( Test_wstringlines );
+	testsuite( Test_wstring_writeAll );
 
 	testsuite( Test_wstring_compareCompareCaseEquals );
+	testsuite( Test_wstring_compareCase );
 	testsuite( Test_wstring_contains );
+	testsuite( Test_wstring_containsFindCase );
 	testsuite( Test_wstring_similarity );
+	testsuite( Test_wstring_hash );
+	testsuite( Test_wstring_signature );
 
 	testsuite( Test_wstring_append );
 	testsuite( Test_wstring_appendf );
+	testsuite( Test_wstring_setf );
+	testsuite( Test_wstring_appendIntUint );
+	testsuite( Test_wstring_appendDouble );
+	testsuite( Test_wstring_appendTemplate_positional );
+	testsuite( Test_wstring_appendTemplate_named );
+	testsuite( Test_wstring_appendTemplate_self );
+	testsuite( Test_wstring_appendTemplate_malformed );
 	testsuite( Test_wstring_prepend );
+	testsuite( Test_wstring_join );
+	testsuite( Test_wstring_joinViews );
+	testsuite( Test_wstring_insert );
+	testsuite( Test_wstring_erase );
+	testsuite( Test_wstring_at );
+	testsuite( Test_wstring_slice );
 
 	testsuite( Test_wstring_ltrim );
 	testsuite( Test_wstring_rtrim );
@@ -777,10 +1891,18 @@ int main()
 	testsuite( Test_wstring_split_fullSentence );
 	testsuite( Test_wstring_split_noSubstringsFound );
 
+	testsuite( Test_wstring_sortArray );
+	testsuite( Test_wstring_sortKey );
+
 	testsuite( Test_wstring_replaceAll_simple );
+	testsuite( Test_wstring_replaceAllCase );
 
 	testsuite( Test_wstring_toInt );
 	testsuite( Test_wstring_toDouble );
+	testsuite( Test_wstring_parseInt64 );
+	testsuite( Test_wstring_parseUint64 );
+	testsuite( Test_wstring_parseHex );
+	testsuite( Test_wstring_parseDouble );
 
 	printf( "\n" );
 	printf( "----------------------------\n" );
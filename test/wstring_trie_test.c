@@ -0,0 +1,117 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define _GNU_SOURCE
+#include "wstring_sugar.h"
+#include "wstring_trie.h"
+#define TEST_IMPLEMENTATION
+#include "Testing.h"
+#include <stdlib.h>
+
+#define autoWStringTrie __attribute__(( cleanup( wstringtrie_delete ))) WStringTrie
+
+//---------------------------------------------------------------------------------
+
+void
+Test_wstringtrie_add()
+{
+	autoWStringTrie* trie = wstringtrie_new();
+	assert_equal( wstringtrie_size( trie ), 0 );
+	assert_equal( wstringtrie_longestMatch( trie, wstring_viewc( "/api" )), -1 );
+
+	assert_equal( wstringtrie_add( trie, wstring_viewc( "/api/users/" )), 0 );
+	assert_equal( wstringtrie_add( trie, wstring_viewc( "/api/" )), 1 );
+	assert_equal( wstringtrie_add( trie, wstring_viewc( "/api/orders/" )), 2 );
+	assert_equal( wstringtrie_add( trie, wstring_viewc( "/api/" )), 1 );
+	assert_equal( wstringtrie_add( trie, wstring_viewc( "/" )), 3 );
+	assert_equal( wstringtrie_add( trie, wstring_viewc( "/äpfel" )), 4 );
+	assert_equal( wstringtrie_add( trie, wstring_viewc( "/ä" )), 5 );
+	assert_equal( wstringtrie_size( trie ), 6 );
+
+	assert_equal( wstringtrie_longestMatch( trie, wstring_viewc( "/api/users/42" )), 0 );
+	assert_equal( wstringtrie_longestMatch( trie, wstring_viewc( "/api/users/" )), 0 );
+	assert_equal( wstringtrie_longestMatch( trie, wstring_viewc( "/api/users" )), 1 );
+	assert_equal( wstringtrie_longestMatch( trie, wstring_viewc( "/api/orders/7" )), 2 );
+	assert_equal( wstringtrie_longestMatch( trie, wstring_viewc( "/api" )), 3 );
+	assert_equal( wstringtrie_longestMatch( trie, wstring_viewc( "/äpfelbaum" )), 4 );
+	assert_equal( wstringtrie_longestMatch( trie, wstring_viewc( "/äpf" )), 5 );
+	assert_equal( wstringtrie_longestMatch( trie, wstring_viewc( "index.html" )), -1 );
+	assert_equal( wstringtrie_longestMatch( trie, wstring_viewc( "" )), -1 );
+
+	assert_equal( wstringtrie_add( trie, wstring_viewc( "" )), 6 );
+	assert_equal( wstringtrie_longestMatch( trie, wstring_viewc( "index.html" )), 6 );
+}
+
+void
+Test_wstringtrie_matchAll()
+{
+	autoWStringTrie* trie = wstringtrie_new();
+	const char* routes[] = { "/static/", "/", "/api/v1/", "/api/", "/api/v1/users", "/api/v2/" };
+	for ( size_t i = 0; i < 6; i++ )
+		wstringtrie_add( trie, wstring_viewc( routes[i] ));
+
+	size_t results[4];
+	assert_equal( wstringtrie_matchAll( trie, wstring_viewc( "/api/v1/users/42" ), results, 4 ), 4 );
+	assert_equal( results[0], 1 );
+	assert_equal( results[1], 3 );
+	assert_equal( results[2], 2 );
+	assert_equal( results[3], 4 );
+
+	assert_equal( wstringtrie_matchAll( trie, wstring_viewc( "/api/v1/users/42" ), results, 2 ), 4 );
+	assert_equal( wstringtrie_matchAll( trie, wstring_viewc( "/api/v3/" ), results, 4 ), 2 );
+	assert_equal( results[0], 1 );
+	assert_equal( results[1], 3 );
+	assert_equal( wstringtrie_matchAll( trie, wstring_viewc( "api" ), results, 4 ), 0 );
+
+	//Agrees with wstring_startsWith() for many prefixes
+	autoWStringTrie* numbers = wstringtrie_new();
+	WString* prefixes[300];
+	for ( size_t i = 0; i < 300; i++ ) {
+		prefixes[i] = wstring_printf( "/%zu", ( i * 7919 ) % 1000 );
+		wstringtrie_add( numbers, wstring_view( prefixes[i] ));
+	}
+
+	size_t wrong = 0;
+	for ( size_t n = 0; n < 2000; n++ ) {
+		autoWString* path = wstring_printf( "/%zu/index", n );
+		size_t expected = 0;
+		for ( size_t i = 0; i < 300; i++ )
+			expected += wstring_startsWith( path, prefixes[i] );
+		wrong += wstringtrie_matchAll( numbers, wstring_view( path ), NULL, 0 ) != expected;
+	}
+	assert_equal( wrong, 0 );
+
+	for ( size_t i = 0; i < 300; i++ )
+		wstring_delete( &prefixes[i] );
+}
+
+//---------------------------------------------------------------------------------
+
+int main()
+{
+	printf( "\n" );
+
+	testsuite( Test_wstringtrie_add );
+	testsuite( Test_wstringtrie_matchAll );
+
+	printf( "\n" );
+	printf( "----------------------------\n" );
+	printf( "| Tests  | Failed | Passed |\n" );
+	printf( "| %-6zu | %-6zu | %-6zu |\n", testsFailed+testsPassed, testsFailed, testsPassed );
+	printf( "----------------------------\n" );
+}
+
+//---------------------------------------------------------------------------------
@@ -16,10 +16,12 @@
 */
 #define _GNU_SOURCE
 #include "wstring.h"
+#include "wstring_internal.h"
 #include <assert.h>
 #include <errno.h>
 #include <float.h>	//DBL_MIN, DBL_MAX
 #include <ctype.h>
+#include <wchar.h>
 #include <wctype.h>
 #include <limits.h>
 #include <math.h>
@@ -28,82 +30,60 @@
 #include <stdint.h>
 #include <string.h>
 #include <iso646.h>
+#include <locale.h>	//newlocale(), strtod_l()
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>	//writev()
 
 //---------------------------------------------------------------------------------
 
 static void
 resize( WString* string, size_t newCapacity );
 
-static uint32_t
-utf8NextChar( char** str );
-
-static bool
-utf8MoreChars( const char* str );
-
 static size_t
-utf8len( const char *str );
+grownCapacity( size_t capacity, size_t needed );
 
 static size_t
-occurrences( const char *string, const char *search );
-
-//---------------------------------------------------------------------------------
-//	Memeory management & helpers
-//---------------------------------------------------------------------------------
+characterOffset( const WString* string, size_t position );
 
-#define __wmax( x, y )	((x) > (y) ? (x) : (y))
+static size_t
+characterCount( const WString* string );
 
-#define __wxnew( type, ... )	\
-	memcpy( __wxmalloc( sizeof( type )), &(type){ __VA_ARGS__ }, sizeof(type) )
+static void
+prepareChange( WString* string );
 
 static void
-__wdie( const char* text )
-{
-	fputs( text, stderr );
-	abort();
-}
+ownText( WString* string, size_t capacity );
 
-static void*
-__wxmalloc( size_t size )
-{
-	void* ptr = malloc( size );
-	if ( ptr ) return ptr;
+static void
+unmapText( char* bytes, size_t sizeBytes );
 
-	__wdie( "Out of memory." );
-	return NULL;
-}
+static size_t
+mappedSize( size_t sizeBytes );
 
-static void*
-__wxrealloc( void* pointer, size_t size )
-{
-	void* ptr = realloc( pointer, size );
-	if ( ptr ) return ptr;
+static size_t
+occurrences( const char* bytes, size_t length, const char* search, size_t searchLength );
 
-	__wdie( "Out of memory." );
-	return NULL;
-}
+static int
+compareBytes( const char* bytes, size_t length, const char* other, size_t otherLength );
 
-void*
-__wxcalloc( size_t number, size_t size )
-{
-	void* ptr = calloc( number, size );
-	if ( ptr ) return ptr;
+static size_t
+formatUint64( char* buffer, uint64_t value );
 
-	__wdie( "Out of memory." );
-	return NULL;
-}
+static size_t
+formatDouble( char* buffer, double value );
 
-static char*
-__wstr_dup( const char* string )
-{
-	if ( not string ) string = "";
+static int
+skipEqualCase( const char* bytes, size_t length, size_t* position, const char* other, size_t otherLength, size_t* otherPosition );
 
-	size_t size = strlen( string ) + 1;
-	char* copy = __wxmalloc( size );
-    memcpy( copy, string, size );
+static size_t
+findCase( const char* bytes, size_t length, size_t start, const char* search, size_t searchLength, size_t* matchEnd );
 
-    assert( copy );
-    return copy;
-}
+//---------------------------------------------------------------------------------
+//	Memeory management & helpers
+//---------------------------------------------------------------------------------
 
 static int
 __wvsnprintf( char* string, size_t size, const char* format, va_list args )
@@ -117,34 +97,15 @@ __wvsnprintf( char* string, size_t size, const char* format, va_list args )
 	return -1;
 }
 
-//Like __wstr_printf(), but takes a va_list argument
-static char*
-__wstr_printfva( const char* format, va_list args )
-{
-	assert( format );
-
-    va_list args_copy;
-	va_copy( args_copy, args );
-
-	int len = __wvsnprintf( NULL, 0, format, args_copy ) + 1;
-	char* other = __wxmalloc( len );
-	__wvsnprintf( other, len, format, args );
-
-	va_end( args_copy );
-
-	assert( other );
-	return other;
-}
-
 //---------------------------------------------------------------------------------
 
 static WString*
 checkString( const WString* string ) {
 	assert( string->cstring );
-	assert( string->size <= string->sizeBytes );
-	assert( string->sizeBytes <= string->capacity );
-	assert( string->sizeBytes == strlen( string->cstring ) + 1 );
-	assert( string->size == utf8len( string->cstring ));
+	assert( string->size <= string->sizeBytes or string->size == SIZE_MAX );
+	assert( string->sizeBytes <= string->capacity or string->capacity == 0 );
+	assert( string->cstring[string->sizeBytes - 1] == '\0' );
+	assert( string->size == __wutf8count( string->cstring, string->sizeBytes - 1 ) or string->size == SIZE_MAX );
 
 	return (WString*)string;
 }
@@ -153,6 +114,16 @@ enum WStringConfiguration {
 	WStringGrowthRate			= 2,
 	WStringDefaultCapacity 		= 100,
 	Utf8MaximumCharacterSize	= 4,
+	CharacterIndexStep			= 64,	//Characters between two offsets of the character index
+	MaxIntegerCharacters		= 20,	//"-9223372036854775808" and "18446744073709551615"
+	MaxDoubleCharacters			= 24,	//"-2.2250738585072014e-308"
+	SmallestSizeClass			= 16,	//Allocators hand out memory in steps of at least 16 bytes
+	LargestSizeClassStep		= 4096,	//and of at most one page for big blocks
+};
+
+static WStringGrowthPolicy growthPolicy = {
+	.factor = WStringGrowthRate,
+	.defaultCapacity = WStringDefaultCapacity,
 };
 
 
@@ -176,41 +147,48 @@ do {																\
 	}																\
 }while( 0 )
 
-//TODO: Step over UTF8 characters
-#define str_foreach( str, current, ... )					\
-do {														\
-	assert( str );											\
-	for ( char* current = str; utf8MoreChars( str ); utf8NextChar( &current )) {	\
-		__VA_ARGS__											\
-	}														\
-}while(0)
-
 //---------------------------------------------------------------------------------
 
-WString*
-wstring_new( const char* cstring, size_t capacity )
+//Create a string from a byte range, which may contain 0 bytes.
+static WString*
+newString( const char* bytes, size_t length, size_t capacity )
 {
-	assert( cstring );
+	assert( bytes or length == 0 );
 
 	WString* string = __wxnew( WString,
-		.size = utf8len( cstring ),
-		.sizeBytes = strlen( cstring ) + 1,
-		.capacity = capacity ? capacity : WStringDefaultCapacity,
+		.size = __wutf8count( bytes, length ),
+		.sizeBytes = length + 1,
+		.capacity = __wmax( capacity ? capacity : growthPolicy.defaultCapacity, length + 1 ),
 	);
 
-	string->capacity = __wmax( string->capacity, string->sizeBytes );
-
-	//Copy the given char* into our new String*
 	string->cstring = __wxmalloc( string->capacity );
-	strcpy( string->cstring, cstring ),
+	if ( length > 0 )
+		memcpy( string->cstring, bytes, length );
 
 	//Always terminate the cstring
+	string->cstring[length] = '\0';
 	string->cstring[string->capacity - 1] = '\0';
 
 	assert( string );
 	return checkString( string );
 }
 
+WString*
+wstring_new( const char* cstring, size_t capacity )
+{
+	assert( cstring );
+
+	return newString( cstring, strlen( cstring ), capacity );
+}
+
+WString*
+wstring_newBytes( const char bytes[], size_t length )
+{
+	assert( bytes or length == 0 );
+
+	return newString( bytes, length, length + 1 );
+}
+
 WString*
 wstring_dup( const char* cstring )
 {
@@ -222,7 +200,7 @@ wstring_clone( const WString* string )
 {
 	assert( string );
 
-	WString* clone = wstring_new( string->cstring, string->capacity );
+	WString* clone = newString( string->cstring, string->sizeBytes - 1, string->capacity );
 
 	assert( clone );
 	assert( wstring_equals( clone, string ) );
@@ -234,6 +212,14 @@ wstring_clear( WString* string )
 {
 	assert( string );
 
+	//Do not copy a mapped file just to clear it.
+	if ( string->capacity == 0 ) {
+		unmapText( string->cstring, string->sizeBytes );
+		string->cstring = __wxmalloc( growthPolicy.defaultCapacity );
+		string->capacity = growthPolicy.defaultCapacity;
+	}
+	prepareChange( string );
+
 	string->cstring[0] = '\0';
 	string->size = 0;
 	string->sizeBytes = 1;
@@ -249,6 +235,7 @@ wstring_steal( WString** stringPtr )
 	assert( *stringPtr );
 
 	WString* string = *stringPtr;
+	ownText( string, string->sizeBytes );
 
 	char* stolen = string->cstring;
 	string->cstring = NULL;
@@ -258,12 +245,120 @@ wstring_steal( WString** stringPtr )
 	return stolen;
 }
 
+WString*
+wstring_adopt( char* buffer, size_t length, size_t capacity )
+{
+	assert( buffer );
+	assert( length <= capacity );
+
+	if ( length == capacity ) {
+		capacity = length + 1;
+		buffer = __wxrealloc( buffer, capacity );
+	}
+	buffer[length] = '\0';
+
+	WString* string = __wxnew( WString,
+		.cstring = buffer,
+		.size = __wutf8count( buffer, length ),
+		.sizeBytes = length + 1,
+		.capacity = capacity,
+	);
+
+	assert( string );
+	return checkString( string );
+}
+
+//Map a regular file read-only, followed by at least one 0 byte, and give the kernel an
+//advice on how it is read before any page is touched. Returns NULL with errno set on
+//errors.
+static char*
+mapText( const char path[], int advice, size_t* length )
+{
+	int fd = open( path, O_RDONLY | O_CLOEXEC );
+	if ( fd < 0 ) return NULL;
+
+	struct stat status;
+	if ( fstat( fd, &status ) < 0 ) {
+		close( fd );
+		return NULL;
+	}
+	if ( not S_ISREG( status.st_mode )) {
+		close( fd );
+		errno = EINVAL;
+		return NULL;
+	}
+
+	//Reserve the mapping plus at least one 0 byte in anonymous memory first, then map the
+	//file over it. The bytes after the end of the file terminate the cstring.
+	*length = status.st_size;
+	size_t mappingSize = mappedSize( *length + 1 );
+	char* bytes = mmap( NULL, mappingSize, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+	if ( bytes != MAP_FAILED and *length > 0
+		 and mmap( bytes, *length, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0 ) == MAP_FAILED ) {
+		int error = errno;
+		munmap( bytes, mappingSize );
+		errno = error;
+		bytes = MAP_FAILED;
+	}
+	int error = errno;
+	close( fd );
+	errno = error;
+	if ( bytes == MAP_FAILED ) return NULL;
+
+	if ( advice != MADV_NORMAL )
+		madvise( bytes, mappingSize, advice );
+	return bytes;
+}
+
+WString*
+wstring_mapFile( const char path[] )
+{
+	assert( path );
+
+	size_t length;
+	char* bytes = mapText( path, MADV_NORMAL, &length );
+	if ( not bytes ) return NULL;
+
+	WString* string = __wxnew( WString,
+		.cstring = bytes,
+		.size = SIZE_MAX,	//Counted on first use, see characterCount()
+		.sizeBytes = length + 1,
+		.capacity = 0,
+	);
+
+	assert( string );
+	return checkString( string );
+}
+
+WString*
+wstring_unmap( WString* string )
+{
+	assert( string );
+
+	ownText( string, string->sizeBytes );
+
+	assert( string->capacity > 0 );
+	return checkString( string );
+}
+
+bool
+wstring_mapped( const WString* string )
+{
+	assert( string );
+
+	return string->capacity == 0;
+}
+
 char*
 wstring_cstring( const WString* string )
 {
 	assert( string );
 
-	return __wstr_dup( string->cstring );
+	char* copy = __wxmalloc( string->sizeBytes );
+	memcpy( copy, string->cstring, string->sizeBytes );
+
+	assert( copy );
+	return copy;
 }
 
 void
@@ -274,7 +369,11 @@ wstring_delete( WString** stringPtr )
 
 	WString* string = *stringPtr;
 
-	free( string->cstring );
+	if ( string->capacity == 0 and string->cstring )
+		unmapText( string->cstring, string->sizeBytes );
+	else
+		free( string->cstring );
+	free( string->index );
 	free( *stringPtr );
 	*stringPtr = NULL;
 }
@@ -288,6 +387,25 @@ wstring_assign( WString** stringPtr, WString* other )
 	*stringPtr = other;
 }
 
+void
+wstring_swap( WString* string, WString* other )
+{
+	assert( string );
+	assert( other );
+
+	WString temp = *string;
+	*string = *other;
+	*other = temp;
+}
+
+WString*
+wstring_fromView( WStringView view )
+{
+	assert( view.bytes or view.length == 0 );
+
+	return newString( view.bytes, view.length, view.length + 1 );
+}
+
 //---------------------------------------------------------------------------------
 
 WString*
@@ -299,8 +417,8 @@ wstring_append( WString* string, const WString* other )
 	size_t newSize = string->sizeBytes + other->sizeBytes - 1;
 	resize( string, newSize );
 
-	strcpy( &string->cstring[string->sizeBytes - 1], other->cstring );
-	string->size += other->size;
+	memcpy( &string->cstring[string->sizeBytes - 1], other->cstring, other->sizeBytes );
+	string->size += characterCount( other );
 	string->sizeBytes += other->sizeBytes - 1;
 
 	assert( string );
@@ -308,6 +426,38 @@ wstring_append( WString* string, const WString* other )
 	return checkString( string );
 }
 
+WString*
+wstring_appendMove( WString* string, WString** otherPtr )
+{
+	assert( string );
+	assert( otherPtr );
+	assert( *otherPtr );
+	assert( *otherPtr != string );
+
+	WString* other = *otherPtr;
+	size_t newSize = string->sizeBytes + other->sizeBytes - 1;
+
+	if ( string->sizeBytes == 1 )
+		wstring_swap( string, other );
+	else
+	if ( newSize > string->capacity and newSize <= other->capacity ) {
+		//Move the text of string in front of the text of other, within the buffer of other.
+		memmove( &other->cstring[string->sizeBytes - 1], other->cstring, other->sizeBytes );
+		memcpy( other->cstring, string->cstring, string->sizeBytes - 1 );
+		other->size += characterCount( string );
+		other->sizeBytes = newSize;
+		prepareChange( other );
+		wstring_swap( string, other );
+	}
+	else
+		wstring_append( string, other );
+
+	wstring_delete( otherPtr );
+
+	assert( string );
+	return checkString( string );
+}
+
 WString*
 wstring_appendc( WString* string, const char* other )
 {
@@ -318,8 +468,8 @@ wstring_appendc( WString* string, const char* other )
 	size_t newSize = string->sizeBytes + sizeOther;
 	resize( string, newSize );
 
-	strcpy( &string->cstring[string->sizeBytes - 1], other );
-	string->size += utf8len( other );
+	memcpy( &string->cstring[string->sizeBytes - 1], other, sizeOther + 1 );
+	string->size += __wutf8count( other, sizeOther );
 	string->sizeBytes += sizeOther;
 
 	assert( string );
@@ -339,7 +489,162 @@ wstring_appendn( WString* string, size_t n, const char* buffer )
 	memcpy( &string->cstring[string->sizeBytes - 1], buffer, n );
 	string->cstring[newSize-1] = 0;
 	string->sizeBytes = newSize;
-	string->size = utf8len( string->cstring );
+	string->size += __wutf8count( buffer, n );
+
+	assert( string );
+	return checkString( string );
+}
+
+//Return whether a string value of the format points into a byte range, for example into
+//the string that gets the result. Walks over the values of a copy of args. Formats that
+//cannot be followed, like numbered values, count as pointing into the range.
+static bool
+formatReadsFrom( const char* format, va_list args, const char* begin, const char* end )
+{
+	if ( strchr( format, '$' ))
+		return true;
+
+	va_list values;
+	va_copy( values, args );
+	bool result = false;
+
+	for ( const char* current = strchr( format, '%' ); current and not result; current = strchr( current, '%' )) {
+		current++;
+		if ( *current == '%' ) {
+			current++;
+			continue;
+		}
+
+		//Flags, width and precision, which may be values too
+		current += strspn( current, "-+ #0'" );
+		if ( *current == '*' ) {
+			(void)va_arg( values, int );
+			current++;
+		}
+		current += strspn( current, "0123456789" );
+		if ( *current == '.' ) {
+			current++;
+			if ( *current == '*' ) {
+				(void)va_arg( values, int );
+				current++;
+			}
+			current += strspn( current, "0123456789" );
+		}
+
+		size_t modifiers = strspn( current, "hlLqjzt" );
+		char modifier = modifiers ? current[modifiers - 1] : '\0';
+		bool longLong = modifiers == 2 and modifier == 'l';
+		current += modifiers;
+
+		switch ( *current++ ) {
+		case 'c': case 'C':
+			(void)va_arg( values, int );
+			break;
+		case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+			if ( longLong or modifier == 'q' )
+				(void)va_arg( values, long long );
+			else if ( modifier == 'l' )
+				(void)va_arg( values, long );
+			else if ( modifier == 'j' )
+				(void)va_arg( values, intmax_t );
+			else if ( modifier == 'z' )
+				(void)va_arg( values, size_t );
+			else if ( modifier == 't' )
+				(void)va_arg( values, ptrdiff_t );
+			else
+				(void)va_arg( values, int );
+			break;
+		case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+			if ( modifier == 'L' )
+				(void)va_arg( values, long double );
+			else
+				(void)va_arg( values, double );
+			break;
+		case 's': case 'S': {
+			uintptr_t value = (uintptr_t)va_arg( values, const void* );
+			result = value >= (uintptr_t)begin and value < (uintptr_t)end;
+			break;
+		}
+		case 'p': case 'n':
+			(void)va_arg( values, void* );
+			break;
+		case 'm':
+			break;
+		default:
+			result = true;
+		}
+	}
+
+	va_end( values );
+	return result;
+}
+
+//Format into a new buffer, for values that point into the string itself.
+static char*
+formatTemporary( const char* format, va_list args, size_t* length )
+{
+	va_list argsCopy;
+	va_copy( argsCopy, args );
+
+	*length = __wvsnprintf( NULL, 0, format, argsCopy );
+	char* buffer = __wxmalloc( *length + 1 );
+	__wvsnprintf( buffer, *length + 1, format, args );
+
+	va_end( argsCopy );
+	return buffer;
+}
+
+//Return whether a string value of the format points into the text or the unused
+//capacity of the string.
+static bool
+formatReadsString( const WString* string, const char* format, va_list args )
+{
+	const char* end = &string->cstring[__wmax( string->capacity, string->sizeBytes )];
+	return formatReadsFrom( format, args, string->cstring, end );
+}
+
+//Format directly into the unused capacity at the end of the string. Only if the
+//result does not fit, grow the string and format a second time.
+static WString*
+appendfvaInPlace( WString* string, const char* format, va_list args )
+{
+	va_list argsCopy;
+	va_copy( argsCopy, args );
+
+	ownText( string, string->sizeBytes );
+	size_t offset = string->sizeBytes - 1;
+	size_t spare = string->capacity - offset;
+	size_t length = __wvsnprintf( &string->cstring[offset], spare, format, args );
+	if ( length >= spare ) {
+		resize( string, string->sizeBytes + length );
+		__wvsnprintf( &string->cstring[offset], length + 1, format, argsCopy );
+	}
+	va_end( argsCopy );
+
+	string->size += __wutf8count( &string->cstring[offset], length );
+	string->sizeBytes += length;
+
+	return checkString( string );
+}
+
+//Like appendfvaInPlace(), but values that point into the string itself are formatted
+//into a temporary buffer first.
+static WString*
+appendfva( WString* string, const char* format, va_list args )
+{
+	assert( string );
+	assert( format );
+
+	if ( formatReadsString( string, format, args )) {
+		size_t length;
+		char* buffer = formatTemporary( format, args, &length );
+		if ( length > 0 )
+			wstring_appendn( string, length, buffer );
+		free( buffer );
+		return checkString( string );
+	}
+
+	appendfvaInPlace( string, format, args );
 
 	assert( string );
 	return checkString( string );
@@ -353,106 +658,403 @@ wstring_appendf( WString* string, const char* format, ... )
 
     va_list args;
     va_start( args, format );
-	char* other = __wstr_printfva( format, args );
+	appendfva( string, format, args );
 	va_end( args );
 
-	wstring_appendc( string, other );
-
-	free( other );
 	assert( string );
     return checkString( string );
 }
 
 WString*
-wstring_printf( const char* format, ... )
+wstring_setf( WString* string, const char* format, ... )
 {
+	assert( string );
 	assert( format );
 
     va_list args;
     va_start( args, format );
-	char* cstring  = __wstr_printfva( format, args );
+	if ( formatReadsString( string, format, args )) {
+		size_t length;
+		char* buffer = formatTemporary( format, args, &length );
+		wstring_clear( string );
+		if ( length > 0 )
+			wstring_appendn( string, length, buffer );
+		free( buffer );
+	}
+	else {
+		wstring_clear( string );
+		appendfvaInPlace( string, format, args );
+	}
 	va_end( args );
 
-	WString* string = wstring_dup( cstring );
+	assert( string );
+    return checkString( string );
+}
+
+//Make room for up to maxLength ASCII characters and return where to write them.
+static char*
+beginAppend( WString* string, size_t maxLength )
+{
+	resize( string, string->sizeBytes + maxLength );
+	return &string->cstring[string->sizeBytes - 1];
+}
+
+//Take over length ASCII characters written after beginAppend().
+static WString*
+endAppend( WString* string, size_t length )
+{
+	string->size += length;
+	string->sizeBytes += length;
+	string->cstring[string->sizeBytes - 1] = '\0';
 
-	free( cstring );
 	assert( string );
 	return checkString( string );
 }
 
 WString*
-wstring_prepend( WString* string, const WString* other )
+wstring_appendInt( WString* string, int64_t value )
 {
 	assert( string );
-	assert( string );
-
-	size_t newSize = string->sizeBytes + other->sizeBytes - 1;
-	resize( string, newSize );
-
-	memmove( &string->cstring[other->sizeBytes - 1], string->cstring, string->sizeBytes );
-	memmove( string->cstring, other->cstring, other->sizeBytes - 1 );
 
-	string->size += other->size;
-	string->sizeBytes += other->sizeBytes - 1;
+	char* buffer = beginAppend( string, MaxIntegerCharacters + 1 );
+	size_t length = 0;
+	if ( value < 0 )
+		buffer[length++] = '-';
+	length += formatUint64( &buffer[length], value < 0 ? 0 - (uint64_t)value : (uint64_t)value );
 
-	assert( string );
-	assert( wstring_startsWith( string, other ) );
-	return checkString( string );
+	return endAppend( string, length );
 }
 
-//REFACTOR: wstring_replace() must use resize()
-static WString*
-_replace( WString* string, const char *search, const char *replace, bool all )
+WString*
+wstring_appendUint( WString* string, uint64_t value )
 {
 	assert( string );
-	assert( search );
-	assert( replace );
-
-	size_t count = occurrences( string->cstring, search );
-	if ( count == 0 ) return checkString( string );
 
-	size_t searchLen = strlen( search );
-	size_t replaceLen = strlen( replace );
+	char* buffer = beginAppend( string, MaxIntegerCharacters + 1 );
+	return endAppend( string, formatUint64( buffer, value ));
+}
 
-	size_t newSizeBytes = (
-        string->sizeBytes - 1
-      - searchLen * count
-      + replaceLen * count
-	) + 1;
+WString*
+wstring_appendDouble( WString* string, double value )
+{
+	assert( string );
 
-	size_t newCapacity = __wmax( string->capacity, newSizeBytes );
-	char *newCString = __wxcalloc( newCapacity, 1 );
+	char* buffer = beginAppend( string, MaxDoubleCharacters + 1 );
+	return endAppend( string, formatDouble( buffer, value ));
+}
 
-	char *pos = string->cstring;
-	char *current;
-	bool repeat = true;
-	while (( current = strstr( pos, search )) and repeat ) {
-		size_t len = current - pos;
-		strncat( newCString, pos, len );
-		strncat( newCString, replace, replaceLen );
-		pos = current + searchLen;
-		repeat = all;
-	}
+WString*
+wstring_printf( const char* format, ... )
+{
+	assert( format );
 
-	if ( pos != ( string->cstring + string->sizeBytes - 1 ))
-		strncat( newCString, pos, ( string->cstring - pos ));
+	WString* string = wstring_new( "", 0 );
 
-	free( string->cstring );
-	string->cstring = newCString;
-	string->sizeBytes = strlen( string->cstring ) + 1;
-	string->size = utf8len( string->cstring );
-	string->capacity = newCapacity;
-	string->cstring[newCapacity - 1] = 0;
+    va_list args;
+    va_start( args, format );
+	appendfva( string, format, args );
+	va_end( args );
 
 	assert( string );
 	return checkString( string );
 }
 
 WString*
-wstring_replace( WString* string, const char* search, const char* replace )
+wstring_prepend( WString* string, const WString* other )
 {
-	return _replace( string, search, replace, false );
-}
+	assert( string );
+	assert( string );
+	prepareChange( string );
+
+	size_t newSize = string->sizeBytes + other->sizeBytes - 1;
+	resize( string, newSize );
+
+	memmove( &string->cstring[other->sizeBytes - 1], string->cstring, string->sizeBytes );
+	memmove( string->cstring, other->cstring, other->sizeBytes - 1 );
+
+	string->size += characterCount( other );
+	string->sizeBytes += other->sizeBytes - 1;
+
+	assert( string );
+	assert( wstring_startsWith( string, other ) );
+	return checkString( string );
+}
+
+WString*
+wstring_join( const char* separator, WString* const strings[], size_t n )
+{
+	assert( separator );
+	assert( strings or n == 0 );
+
+	size_t separatorBytes = strlen( separator );
+	size_t separatorSize = __wutf8count( separator, separatorBytes );
+
+	//Sum up all parts, so that the result is allocated only once.
+	size_t sizeBytes = 1;
+	size_t size = 0;
+	for ( size_t i = 0; i < n; i++ ) {
+		assert( strings[i] );
+		sizeBytes += strings[i]->sizeBytes - 1;
+		size += characterCount( strings[i] );
+	}
+	if ( n > 1 ) {
+		sizeBytes += ( n - 1 ) * separatorBytes;
+		size += ( n - 1 ) * separatorSize;
+	}
+
+	WString* joined = wstring_new( "", sizeBytes );
+	char* current = joined->cstring;
+	for ( size_t i = 0; i < n; i++ ) {
+		if ( i > 0 ) {
+			memcpy( current, separator, separatorBytes );
+			current += separatorBytes;
+		}
+		memcpy( current, strings[i]->cstring, strings[i]->sizeBytes - 1 );
+		current += strings[i]->sizeBytes - 1;
+	}
+	*current = '\0';
+	joined->sizeBytes = sizeBytes;
+	joined->size = size;
+
+	assert( joined );
+	return checkString( joined );
+}
+
+WString*
+wstring_joinViews( WStringView separator, const WStringView views[], size_t n )
+{
+	assert( separator.bytes or separator.length == 0 );
+	assert( views or n == 0 );
+
+	size_t sizeBytes = 1;
+	for ( size_t i = 0; i < n; i++ )
+		sizeBytes += views[i].length;
+	if ( n > 1 )
+		sizeBytes += ( n - 1 ) * separator.length;
+
+	WString* joined = wstring_new( "", sizeBytes );
+	char* current = joined->cstring;
+	for ( size_t i = 0; i < n; i++ ) {
+		if ( i > 0 ) {
+			memcpy( current, separator.bytes, separator.length );
+			current += separator.length;
+		}
+		memcpy( current, views[i].bytes, views[i].length );
+		current += views[i].length;
+	}
+	*current = '\0';
+	joined->sizeBytes = sizeBytes;
+	joined->size = __wutf8count( joined->cstring, sizeBytes - 1 );
+
+	assert( joined );
+	return checkString( joined );
+}
+
+WString*
+wstring_insert( WString* string, size_t position, const char text[] )
+{
+	assert( string );
+	assert( text );
+	assert( position <= characterCount( string ));
+
+	size_t length = strlen( text );
+	size_t offset = characterOffset( string, position );
+	prepareChange( string );
+	resize( string, string->sizeBytes + length );
+
+	memmove( &string->cstring[offset + length], &string->cstring[offset], string->sizeBytes - offset );
+	memcpy( &string->cstring[offset], text, length );
+
+	string->size += __wutf8count( text, length );
+	string->sizeBytes += length;
+
+	assert( string );
+	return checkString( string );
+}
+
+WString*
+wstring_erase( WString* string, size_t position, size_t length )
+{
+	assert( string );
+	assert( position <= characterCount( string ));
+
+	length = __wmin( length, characterCount( string ) - position );
+	size_t start = characterOffset( string, position );
+	size_t end = characterOffset( string, position + length );
+	prepareChange( string );
+
+	memmove( &string->cstring[start], &string->cstring[end], string->sizeBytes - end );
+
+	string->size -= length;
+	string->sizeBytes -= end - start;
+
+	assert( string );
+	return checkString( string );
+}
+
+//---------------------------------------------------------------------------------
+//	Character positions
+//---------------------------------------------------------------------------------
+
+//Byte offsets of every CharacterIndexStep-th character of a string, collected as far as
+//needed. Appending keeps them valid, all other changes drop them.
+typedef struct WStringCharacterIndex {
+	size_t	count;
+	size_t	capacity;
+	size_t	offsets[];	//offsets[i] is the byte offset of character i * CharacterIndexStep
+}CharacterIndex;
+
+//Return the number of characters. Mapped files count them on first use, so the
+//count is a cache that may be filled in strings passed as const.
+static size_t
+characterCount( const WString* string )
+{
+	if ( string->size == SIZE_MAX )
+		((WString*)string)->size = __wutf8count( string->cstring, string->sizeBytes - 1 );
+
+	return string->size;
+}
+
+//Prepare the text of a string for changes: Drop its character index and copy the text of
+//a mapped file to the heap.
+static void
+prepareChange( WString* string )
+{
+	free( string->index );
+	string->index = NULL;
+	ownText( string, string->sizeBytes );
+}
+
+//Return the byte offset of a character position, or of the 0 terminator if the position
+//is at or behind the end.
+static size_t
+characterOffset( const WString* string, size_t position )
+{
+	size_t length = string->sizeBytes - 1;
+	size_t size = characterCount( string );
+	if ( position >= size )
+		return length;
+	if ( size == length )
+		return position;
+	if ( position < CharacterIndexStep )
+		return __wutf8offset( string->cstring, length, position );
+
+	//The index is a cache, so it may be built in strings passed as const.
+	CharacterIndex* index = string->index;
+	size_t checkpoint = position / CharacterIndexStep;
+
+	if ( index == NULL or index->count <= checkpoint ) {
+		size_t capacity = index ? index->capacity : 0;
+		if ( capacity <= checkpoint ) {
+			capacity = __wmax( checkpoint + 1, capacity * 2 );
+			index = __wxrealloc( index, sizeof( CharacterIndex ) + capacity * sizeof( size_t ));
+			if ( string->index == NULL ) {
+				index->count = 1;
+				index->offsets[0] = 0;
+			}
+			index->capacity = capacity;
+			((WString*)string)->index = index;
+		}
+
+		for ( ; index->count <= checkpoint; index->count++ ) {
+			size_t last = index->offsets[index->count - 1];
+			index->offsets[index->count] = last + __wutf8offset( &string->cstring[last], length - last, CharacterIndexStep );
+		}
+	}
+
+	size_t offset = index->offsets[checkpoint];
+	return offset + __wutf8offset( &string->cstring[offset], length - offset, position % CharacterIndexStep );
+}
+
+uint32_t
+wstring_at( const WString* string, size_t position )
+{
+	assert( string );
+	assert( position < characterCount( string ));
+
+	size_t offset = characterOffset( string, position );
+	const unsigned char* bytes = (const unsigned char*)&string->cstring[offset];
+	if ( bytes[0] < 0x80 )
+		return bytes[0];
+
+	size_t length = __wutf8offset( (const char*)bytes, string->sizeBytes - 1 - offset, 1 );
+	uint32_t codePoint = bytes[0] & ( 0x7F >> length );
+	for ( size_t i = 1; i < length; i++ )
+		codePoint = ( codePoint << 6 ) | ( bytes[i] & 0x3F );
+
+	return codePoint;
+}
+
+WString*
+wstring_slice( const WString* string, size_t start, size_t end )
+{
+	assert( string );
+
+	end = __wmin( end, characterCount( string ));
+	start = __wmin( start, end );
+
+	size_t startOffset = characterOffset( string, start );
+	size_t endOffset = characterOffset( string, end );
+	WString* slice = wstring_fromView( (WStringView){ &string->cstring[startOffset], endOffset - startOffset } );
+
+	assert( slice );
+	assert( wstring_size( slice ) == end - start );
+	return slice;
+}
+
+//---------------------------------------------------------------------------------
+
+static WString*
+_replace( WString* string, const char *search, const char *replace, bool all )
+{
+	assert( string );
+	assert( search );
+	assert( replace );
+
+	size_t length = string->sizeBytes - 1;
+	size_t searchLength = strlen( search );
+	size_t replaceLength = strlen( replace );
+	if ( searchLength == 0 ) return checkString( string );
+
+	size_t count = all ? occurrences( string->cstring, length, search, searchLength )
+					   : memmem( string->cstring, length, search, searchLength ) != NULL;
+	if ( count == 0 ) return checkString( string );
+	prepareChange( string );
+
+	size_t newSizeBytes = length - searchLength * count + replaceLength * count + 1;
+	size_t newCapacity = __wmax( string->capacity, newSizeBytes );
+	char* replaced = __wxmalloc( newCapacity );
+
+	size_t position = 0, replacedLength = 0;
+	for ( size_t i = 0; i < count; i++ ) {
+		const char* match = memmem( &string->cstring[position], length - position, search, searchLength );
+		size_t matchStart = match - string->cstring;
+
+		memcpy( &replaced[replacedLength], &string->cstring[position], matchStart - position );
+		replacedLength += matchStart - position;
+		memcpy( &replaced[replacedLength], replace, replaceLength );
+		replacedLength += replaceLength;
+		position = matchStart + searchLength;
+	}
+	memcpy( &replaced[replacedLength], &string->cstring[position], length - position + 1 );
+
+	free( string->cstring );
+	string->cstring = replaced;
+	string->sizeBytes = newSizeBytes;
+	string->size += count * __wutf8count( replace, replaceLength );
+	string->size -= count * __wutf8count( search, searchLength );
+	string->capacity = newCapacity;
+	string->cstring[newCapacity - 1] = 0;
+
+	assert( string );
+	return checkString( string );
+}
+
+WString*
+wstring_replace( WString* string, const char* search, const char* replace )
+{
+	return _replace( string, search, replace, false );
+}
 
 WString*
 wstring_replaceAll( WString* string, const char* search, const char* replace )
@@ -460,6 +1062,58 @@ wstring_replaceAll( WString* string, const char* search, const char* replace )
 	return _replace( string, search, replace, true );
 }
 
+WString*
+wstring_replaceAllCase( WString* string, const char* search, const char* replace )
+{
+	assert( string );
+	assert( search );
+	assert( replace );
+	prepareChange( string );
+
+	size_t length = string->sizeBytes - 1;
+	size_t searchLength = strlen( search );
+	size_t replaceLength = strlen( replace );
+	if ( searchLength == 0 ) return checkString( string );
+
+	size_t matchEnd;
+	size_t matchStart = findCase( string->cstring, length, 0, search, searchLength, &matchEnd );
+	if ( matchStart == SIZE_MAX ) return checkString( string );
+
+	size_t capacity = __wmax( string->capacity, length + 1 );
+	char* replaced = __wxmalloc( capacity );
+	size_t replacedLength = 0, position = 0;
+
+	while ( matchStart != SIZE_MAX ) {
+		size_t needed = replacedLength + ( matchStart - position ) + replaceLength + ( length - matchEnd ) + 1;
+		if ( needed > capacity ) {
+			capacity = grownCapacity( capacity, needed );
+			replaced = __wxrealloc( replaced, capacity );
+		}
+
+		memcpy( &replaced[replacedLength], &string->cstring[position], matchStart - position );
+		replacedLength += matchStart - position;
+		memcpy( &replaced[replacedLength], replace, replaceLength );
+		replacedLength += replaceLength;
+
+		position = matchEnd;
+		matchStart = findCase( string->cstring, length, position, search, searchLength, &matchEnd );
+	}
+
+	//The space for the rest was reserved with the last match.
+	memcpy( &replaced[replacedLength], &string->cstring[position], length - position );
+	replacedLength += length - position;
+	replaced[replacedLength] = '\0';
+
+	free( string->cstring );
+	string->cstring = replaced;
+	string->sizeBytes = replacedLength + 1;
+	string->size = __wutf8count( replaced, replacedLength );
+	string->capacity = capacity;
+
+	assert( string );
+	return checkString( string );
+}
+
 inline static bool
 isTrimmable( char character, const char *trimlist )
 {
@@ -486,6 +1140,7 @@ wstring_ltrim( WString* string, const char chars[] )
 	assert( string );
 	assert( chars );
 	assert( chars[0] );
+	prepareChange( string );
 
 	char *newString = string->cstring;
 	size_t newLen = string->sizeBytes;
@@ -510,6 +1165,7 @@ wstring_rtrim( WString* string, const char chars[] )
 	assert( string );
 	assert( chars );
 	assert( chars[0] );
+	prepareChange( string );
 
 	if ( string->sizeBytes < 2 )
 		return string;
@@ -532,16 +1188,18 @@ WString*
 wstring_squeeze( WString* string )
 {
 	assert( string );
+	prepareChange( string );
 
     if ( string->sizeBytes <= 1 )
 		return checkString( string );
 
     char *from = string->cstring + 1;
     char *to = string->cstring + 1;
+    const char* end = &string->cstring[string->sizeBytes - 1];
 
-	while ( *from ) {
+	while ( from < end ) {
 		char byte = *from;
-		if ( isspace( byte ) and byte == from[-1] ) {
+		if ( isspace( (unsigned char)byte ) and byte == from[-1] ) {
 			string->size--;
 			string->sizeBytes--;
 		}
@@ -562,19 +1220,15 @@ wstring_truncate( WString* string, size_t size )
 {
 	assert( string );
 
-	if ( size >= string->size )
+	if ( size >= characterCount( string ))
 		return checkString( string );
 
-	size_t index = 1;
-	str_foreach( string->cstring, current,
-		if ( index > size ) {
-			*current = 0;
-			string->size = size;
-			string->sizeBytes = current-string->cstring + 1;
-			break;
-		}
-		index++;
-	);
+	size_t offset = characterOffset( string, size );
+	prepareChange( string );
+
+	string->cstring[offset] = '\0';
+	string->size = size;
+	string->sizeBytes = offset + 1;
 
 	assert( string );
 	assert( wstring_size( string ) <= size );
@@ -586,6 +1240,7 @@ wstring_center( WString* string, size_t size )
 {
 	assert( string );
 	assert( size > 0 );
+	prepareChange( string );
 
 	if ( string->size >= size )
 		return checkString( string );
@@ -616,6 +1271,7 @@ wstring_ljust( WString* string, size_t size )
 {
 	assert( string );
 	assert( size > 0 );
+	prepareChange( string );
 
 	if ( string->size >= size ) return string;
 	size_t delta = size - string->size;
@@ -638,7 +1294,7 @@ wstring_rjust( WString* string, size_t size )
 	assert( string );
 	assert( size > 0 );
 
-	if ( string->size >= size ) return string;
+	if ( characterCount( string ) >= size ) return string;
 	size_t delta = size - string->size;
 
 	resize( string, string->sizeBytes + delta );
@@ -655,31 +1311,81 @@ wstring_rjust( WString* string, size_t size )
 
 //---------------------------------------------------------------------------------
 
+//Convert each character with a callback, keeping 0 bytes and invalid bytes as they are.
 static void
-wstring_map( WString* string, wint_t callback( wint_t ))
+wstring_map( WString* string, wint_t callback( wint_t character, void* data ), void* data )
 {
-	//Convert string->cstring into a wide string.
-	wchar_t* wideBuffer = __wxmalloc( (string->size+1) * sizeof(wchar_t) );
-	size_t size = mbstowcs( wideBuffer, string->cstring, string->size + 1 );
+	prepareChange( string );
+
+	//Each character grows to at most 4 bytes, stray continuation bytes are copied.
+	size_t length = string->sizeBytes - 1;
+	size_t capacity = string->size * Utf8MaximumCharacterSize + length + 1;
+	char* mapped = __wxmalloc( capacity );
+	size_t mappedLength = 0;
+	mbstate_t state = { 0 };
+
+	for ( size_t position = 0; position < length; ) {
+		unsigned char byte = string->cstring[position];
+		wchar_t character = byte;
+		size_t n = 1;
+		if ( byte >= 0x80 ) {
+			n = mbrtowc( &character, &string->cstring[position], length - position, &state );
+			if ( n == (size_t)-1 or n == (size_t)-2 ) {
+				mapped[mappedLength++] = byte;
+				position++;
+				memset( &state, 0, sizeof( state ));
+				continue;
+			}
+		}
 
-	if ( size != (size_t)-1 ) {
-		free( string->cstring );
+		wint_t converted = callback( character, data );
+		size_t written = converted < 0x80 ? ( mapped[mappedLength] = converted, 1 ) :
+						 wcrtomb( &mapped[mappedLength], converted, &(mbstate_t){ 0 });
+		if ( written == (size_t)-1 ) {
+			memcpy( &mapped[mappedLength], &string->cstring[position], n );
+			written = n;
+		}
+		mappedLength += written;
+		position += n;
+	}
+	mapped[mappedLength] = '\0';
+
+	free( string->cstring );
+	string->cstring = mapped;
+	string->capacity = capacity;
+	string->sizeBytes = mappedLength + 1;
+	string->size = __wutf8count( mapped, mappedLength );
+}
+
+static wint_t
+lowerCase( wint_t character, void* data )
+{
+	(void)data;
+	return towlower( character );
+}
 
-		//Apply the callback function.
-		for ( size_t i = 0; i < string->size; i++ )
-			wideBuffer[i] = callback( wideBuffer[i] );
+static wint_t
+upperCase( wint_t character, void* data )
+{
+	(void)data;
+	return towupper( character );
+}
 
-		//Reconvert it to a char* string.
-		string->capacity = string->size * Utf8MaximumCharacterSize + 1;
-		string->cstring = __wxmalloc( string->capacity );
-		string->sizeBytes = wcstombs( string->cstring, wideBuffer, string->capacity )+1;
-		assert( string->sizeBytes != (size_t)-1 && "A bug in mbstowcs(), callback() or wcstombs() occurred." );
-		string->size = utf8len( string->cstring );
-		string->cstring[ string->sizeBytes-1 ] = 0;
+//Upper case after spaces, lower case otherwise.
+static wint_t
+titleCase( wint_t character, void* data )
+{
+	bool* wordStart = data;
+	if ( character == L' ' ) {
+		*wordStart = true;
+		return character;
+	}
+	if ( *wordStart ) {
+		*wordStart = false;
+		return towupper( character );
 	}
 
-	//Clean up.
-	free( wideBuffer );
+	return towlower( character );
 }
 
 WString*
@@ -687,7 +1393,7 @@ wstring_toLower( WString* string )
 {
 	assert( string );
 
-	wstring_map( string, towlower );
+	wstring_map( string, lowerCase, NULL );
 
 	assert( string );
 	return checkString( string );
@@ -698,7 +1404,7 @@ wstring_toUpper( WString* string )
 {
 	assert( string );
 
-	wstring_map( string, towupper );
+	wstring_map( string, upperCase, NULL );
 
 	assert( string );
 	return checkString( string );
@@ -709,39 +1415,8 @@ wstring_toTitle( WString* string )
 {
 	assert( string );
 
-	//Convert string->cstring into a wide string.
-	wchar_t* wideBuffer = __wxmalloc( (string->size+1) * sizeof(wchar_t) );
-	size_t size = mbstowcs( wideBuffer, string->cstring, string->size + 1 );
-
-	if ( size != (size_t)-1 ) {
-		free( string->cstring );
-
-		//Apply the callback function.
-		bool space = true;
-		for ( size_t i = 0; i < string->size; i++ ) {
-			if ( wideBuffer[i] == L' ' )
-				space = true;
-			else
-			if ( space == true ) {
-				wideBuffer[i] = towupper( wideBuffer[i] );
-				space = false;
-			}
-			else
-				wideBuffer[i] = towlower( wideBuffer[i] );
-
-		}
-
-		//Reconvert it to a char* string.
-		string->capacity = string->size * Utf8MaximumCharacterSize + 1;
-		string->cstring = __wxmalloc( string->capacity );
-		string->sizeBytes = wcstombs( string->cstring, wideBuffer, string->capacity )+1;
-		assert( string->sizeBytes != (size_t)-1 && "A bug in mbstowcs(), callback() or wcstombs() occurred." );
-		string->size = utf8len( string->cstring );
-		string->cstring[ string->sizeBytes-1 ] = 0;
-	}
-
-	//Clean up.
-	free( wideBuffer );
+	bool wordStart = true;
+	wstring_map( string, titleCase, &wordStart );
 
 	assert( string );
 	return checkString( string );
@@ -754,7 +1429,7 @@ wstring_size( const WString* string )
 {
 	assert( string );
 
-	return string->size;
+	return characterCount( string );
 }
 
 size_t
@@ -765,12 +1440,67 @@ wstring_sizeBytes( const WString* string )
 	return string->sizeBytes;
 }
 
+size_t
+wstring_capacity( const WString* string )
+{
+	assert( string );
+
+	return string->capacity;
+}
+
+WString*
+wstring_reserve( WString* string, size_t capacity )
+{
+	assert( string );
+
+	if ( string->capacity == 0 )
+		ownText( string, __wmax( capacity, string->sizeBytes ));
+	else
+	if ( capacity > string->capacity ) {
+		string->capacity = capacity;
+		string->cstring = __wxrealloc( string->cstring, capacity );
+	}
+
+	assert( string );
+	return checkString( string );
+}
+
+WString*
+wstring_shrinkToFit( WString* string )
+{
+	assert( string );
+
+	if ( string->capacity > string->sizeBytes ) {
+		string->capacity = string->sizeBytes;
+		string->cstring = __wxrealloc( string->cstring, string->capacity );
+	}
+
+	assert( string );
+	return checkString( string );
+}
+
+void
+wstring_setGrowthPolicy( WStringGrowthPolicy policy )
+{
+	assert( policy.factor >= 1 );
+
+	if ( policy.defaultCapacity == 0 )
+		policy.defaultCapacity = 1;
+	growthPolicy = policy;
+}
+
+WStringGrowthPolicy
+wstring_growthPolicy( void )
+{
+	return growthPolicy;
+}
+
 bool
 wstring_empty( const WString* string )
 {
 	assert( string );
 
-	return string->size == 0;
+	return string->sizeBytes == 1;
 }
 
 bool
@@ -779,9 +1509,8 @@ wstring_equals( const WString* string, const WString *other )
 	assert( string );
 	assert( string );
 
-	return string->size == other->size and					//Faster comparison for unequal strings
-		   string->sizeBytes == other->sizeBytes and			//Faster comparison for unequal strings
-		   strcmp( string->cstring, other->cstring ) == 0;
+	return string->sizeBytes == other->sizeBytes and			//Faster comparison for unequal strings
+		   memcmp( string->cstring, other->cstring, string->sizeBytes ) == 0;
 }
 
 int
@@ -790,18 +1519,22 @@ wstring_compare( const WString* string, const WString *other )
 	assert( string );
 	assert( string );
 
-	return strcmp( string->cstring, other->cstring );
+	return compareBytes( string->cstring, string->sizeBytes - 1, other->cstring, other->sizeBytes - 1 );
 }
 
-//TODO: Only ASCII characters are compared correctly.
-//TODO: Replace GNU strcasecmp() by own implementation
 int
 wstring_compareCase( const WString* string, const WString *other )
 {
 	assert( string );
-	assert( string );
+	assert( other );
+
+	size_t length = string->sizeBytes - 1, otherLength = other->sizeBytes - 1;
+	size_t position = 0, otherPosition = 0;
+	int result = skipEqualCase( string->cstring, length, &position, other->cstring, otherLength, &otherPosition );
+	if ( result != 0 )
+		return result;
 
-	return strcasecmp( string->cstring, other->cstring );
+	return ( position < length ) - ( otherPosition < otherLength );
 }
 
 //Taken and modified from https://github.com/wooorm/levenshtein.c, MIT licensed
@@ -811,8 +1544,8 @@ wstring_similarity( const WString* string, const WString* other )
 	assert( string );
 	assert( other );
 
-    size_t length = string->size;
-    size_t bLength = other->size;
+    size_t length = characterCount( string );
+    size_t bLength = characterCount( other );
 
     //Shortcut optimizations / degenerate cases.
     if ( wstring_equals( string, other )) return 0;
@@ -859,16 +1592,41 @@ wstring_contains( const WString* string, const WString *other )
 	assert( string );
 	assert( string );
 
-	return strstr( string->cstring, other->cstring ) != NULL;
+	return memmem( string->cstring, string->sizeBytes - 1, other->cstring, other->sizeBytes - 1 ) != NULL;
 }
 
 bool
-wstring_startsWith( const WString* string, const WString *other )
+wstring_containsCase( const WString* string, const WString* other )
+{
+	assert( string );
+	assert( other );
+
+	size_t matchEnd;
+	return findCase( string->cstring, string->sizeBytes - 1, 0, other->cstring, other->sizeBytes - 1, &matchEnd ) != SIZE_MAX;
+}
+
+WStringView
+wstring_findCase( const WString* string, const WString* other )
 {
 	assert( string );
+	assert( other );
+
+	size_t matchEnd;
+	size_t matchStart = findCase( string->cstring, string->sizeBytes - 1, 0, other->cstring, other->sizeBytes - 1, &matchEnd );
+	if ( matchStart == SIZE_MAX )
+		return (WStringView){ NULL, 0 };
+
+	return (WStringView){ &string->cstring[matchStart], matchEnd - matchStart };
+}
+
+bool
+wstring_startsWith( const WString* string, const WString *other )
+{
 	assert( string );
+	assert( other );
 
-	return strstr( string->cstring, other->cstring ) == string->cstring;
+	return string->sizeBytes >= other->sizeBytes and
+		   memcmp( string->cstring, other->cstring, other->sizeBytes - 1 ) == 0;
 }
 
 bool
@@ -882,13 +1640,11 @@ wstring_endsWith( const WString* string, const WString *other )
 
 	size_t endPosition = string->sizeBytes - other->sizeBytes;
 
-	return strcmp( &string->cstring[endPosition], other->cstring ) == 0;
+	return memcmp( &string->cstring[endPosition], other->cstring, other->sizeBytes - 1 ) == 0;
 }
 
 //---------------------------------------------------------------------------------
 
-//TODO: Replace POSIX strtok_r() by own implementation
-
 void
 wstring_split( const WString* string, const char *delimiters, void foreach( const WString*, void* data ), void* data )
 {
@@ -896,59 +1652,2016 @@ wstring_split( const WString* string, const char *delimiters, void foreach( cons
 	assert( delimiters and delimiters[0] );
 	assert( foreach );
 
-	//Get the first substring.
-	char* copy = __wstr_dup( string->cstring );
-	char* strtokPtr = NULL;
-	char* token = copy[0] ? strtok_r( copy, delimiters, &strtokPtr ) : "";
+	bool isDelimiter[UCHAR_MAX + 1] = { false };
+	for ( const char* delimiter = delimiters; *delimiter; delimiter++ )
+		isDelimiter[(unsigned char)*delimiter] = true;
 
-	while ( token ) {
-		WString* tokenString = wstring_dup( token );
-			foreach( tokenString, data );
-        wstring_delete( &tokenString );
-		token = strtok_r( NULL, delimiters, &strtokPtr );
+	//An empty string is one empty token.
+	size_t length = string->sizeBytes - 1;
+	if ( length == 0 ) {
+		foreach( string, data );
+		return;
 	}
 
-	free( copy );
+	//Tokens are the longest runs of bytes that are no delimiters, like with strtok().
+	const char* bytes = string->cstring;
+	size_t position = 0;
+	while ( position < length ) {
+		while ( position < length and isDelimiter[(unsigned char)bytes[position]] )
+			position++;
+
+		size_t start = position;
+		while ( position < length and not isDelimiter[(unsigned char)bytes[position]] )
+			position++;
+
+		if ( position > start ) {
+			WString* token = newString( &bytes[start], position - start, 0 );
+			foreach( token, data );
+			wstring_delete( &token );
+		}
+	}
 }
 
+//---------------------------------------------------------------------------------
+//	Case folding
 //---------------------------------------------------------------------------------
 
-int
-wstring_toInt( const WString* string )
+enum CaseFoldingConstants {
+	InvalidByteCharacter	= 0x110000,		//Bytes of invalid UTF8 sequences fold to characters beyond Unicode
+};
+
+//Read the character at *position, advance behind it and return it in lower case.
+static inline uint32_t
+foldCharacter( const char* bytes, size_t length, size_t* position )
 {
-	assert( string );
+	unsigned char byte = bytes[*position];
+	if ( byte < 0x80 ) {
+		(*position)++;
+		return byte >= 'A' and byte <= 'Z' ? byte + ( 'a' - 'A' ) : byte;
+	}
 
-	char *endptr;
+	wchar_t c;
+	size_t n = mbrtowc( &c, &bytes[*position], length - *position, &(mbstate_t){ 0 });
+	if ( n == (size_t)-1 or n == (size_t)-2 ) {
+		(*position)++;
+		return InvalidByteCharacter + byte;
+	}
 
-	errno = 0;
-	long value = strtol( string->cstring, &endptr, 10 );
+	*position += n;
+	return towlower( c );
+}
 
-	if (( errno == ERANGE and ( value == LONG_MAX or value == LONG_MIN )) or ( errno != 0 and value == 0 ))
-		return INT_MIN;
+//Advance through two byte ranges as long as their characters are equal ignoring case.
+//Blocks of 8 ASCII bytes are folded and compared at once, other characters one by one
+//with towlower(). Returns 0 if one of the ranges ended, otherwise the sign of the
+//difference of the first unequal characters.
+static int
+skipEqualCase( const char* bytes, size_t length, size_t* position, const char* other, size_t otherLength, size_t* otherPosition )
+{
+	const uint64_t highBits = 0x8080808080808080;
+	size_t i = *position, j = *otherPosition;
+	int result = 0;
+
+	while ( i < length and j < otherLength ) {
+		if ( i + 8 <= length and j + 8 <= otherLength ) {
+			uint64_t word = __wload8( &bytes[i] ), otherWord = __wload8( &other[j] );
+			if ( not (( word | otherWord ) & highBits ) and __wswarToLower( word ) == __wswarToLower( otherWord )) {
+				i += 8, j += 8;
+				continue;
+			}
+		}
 
-	if ( endptr == string->cstring )
-		return INT_MIN;
+		uint32_t c = foldCharacter( bytes, length, &i );
+		uint32_t otherC = foldCharacter( other, otherLength, &j );
+		if ( c != otherC ) {
+			result = c < otherC ? -1 : 1;
+			break;
+		}
+	}
 
-	return value;
+	*position = i, *otherPosition = j;
+	return result;
 }
 
-double
+//Set the high bit of each byte equal to value.
+static inline uint64_t
+swarEqualBytes( uint64_t word, uint8_t value )
+{
+	const uint64_t ones = 0x0101010101010101;
+	const uint64_t lowBits = ones * 0x7F;
+
+	uint64_t x = word ^ ( ones * value );
+	return ~((( x & lowBits ) + lowBits ) | x | lowBits );
+}
+
+//Find the first match of search in bytes[start, length) ignoring case, and return its
+//start or SIZE_MAX. The end of the match goes to *matchEnd, because upper and lower case
+//characters may have different lengths.
+static size_t
+findCase( const char* bytes, size_t length, size_t start, const char* search, size_t searchLength, size_t* matchEnd )
+{
+	if ( searchLength == 0 ) {
+		*matchEnd = start;
+		return start;
+	}
+
+	//A match starts with the first search character in either case, or with any
+	//non-ASCII byte, which might fold to it. So skip 8 bytes at a time to the candidates.
+	const uint64_t highBits = 0x8080808080808080;
+	unsigned char first = search[0];
+	unsigned char lower = 0x80, upper = 0x80;
+	if ( first < 0x80 ) {
+		lower = first >= 'A' and first <= 'Z' ? first + ( 'a' - 'A' ) : first;
+		upper = lower >= 'a' and lower <= 'z' ? lower - ( 'a' - 'A' ) : lower;
+	}
+
+	size_t position = start;
+	while ( position < length ) {
+		if ( position + 8 <= length ) {
+			uint64_t word = __wload8( &bytes[position] );
+			uint64_t candidates = ( word & highBits ) | swarEqualBytes( word, lower ) | swarEqualBytes( word, upper );
+			if ( candidates == 0 ) {
+				position += 8;
+				continue;
+			}
+			position += __builtin_ctzll( candidates ) / 8;
+		}
+		else {
+			unsigned char byte = bytes[position];
+			if ( byte < 0x80 and byte != lower and byte != upper ) {
+				position++;
+				continue;
+			}
+		}
+
+		size_t end = position, searchEnd = 0;
+		if ( skipEqualCase( bytes, length, &end, search, searchLength, &searchEnd ) == 0 and searchEnd == searchLength ) {
+			*matchEnd = end;
+			return position;
+		}
+		position++;
+	}
+
+	return SIZE_MAX;
+}
+
+//---------------------------------------------------------------------------------
+//	Sorting
+//---------------------------------------------------------------------------------
+
+enum SortConfiguration {
+	SortInsertionThreshold	= 16,
+};
+
+//A string and 8 of its bytes, starting at the current depth of the sort.
+typedef struct {
+	uint64_t	key;
+	WString*	string;
+}SortItem;
+
+//Load 8 bytes starting at depth, so that comparing keys as numbers compares the bytes
+//like memcmp(). Bytes after the end of the string are 0, so a key ending with 0 may end
+//the string or contain 0 bytes of it.
+static inline uint64_t
+sortKey( const WString* string, size_t depth )
+{
+	size_t length = string->sizeBytes - 1;
+	if ( depth >= length )
+		return 0;
+
+	if ( length - depth >= 8 )
+		return __builtin_bswap64( __wload8( &string->cstring[depth] ));
+
+	char bytes[8] = { 0 };
+	memcpy( bytes, &string->cstring[depth], length - depth );
+	return __builtin_bswap64( __wload8( bytes ));
+}
+
+//If the last of the 8 bytes of a key is 0, the string may end within the key.
+static inline bool
+sortKeyEndsString( uint64_t key )
+{
+	return ( key & 0xFF ) == 0;
+}
+
+//Sort strings whose bytes are equal up to their ends, so that shorter ones come first.
+//Without 0 bytes in the strings they all have the same length already.
+static void
+sortByLength( SortItem* items, size_t n )
+{
+	for ( size_t i = 1; i < n; i++ ) {
+		SortItem item = items[i];
+		size_t j = i;
+		while ( j > 0 and items[j - 1].string->sizeBytes > item.string->sizeBytes ) {
+			items[j] = items[j - 1];
+			j--;
+		}
+		items[j] = item;
+	}
+}
+
+static inline void
+swapItems( SortItem* a, SortItem* b )
+{
+	SortItem temp = *a;
+	*a = *b;
+	*b = temp;
+}
+
+static inline int
+compareItems( const SortItem* a, const SortItem* b, size_t depth )
+{
+	if ( a->key != b->key )
+		return a->key < b->key ? -1 : 1;
+
+	size_t length = a->string->sizeBytes - 1, otherLength = b->string->sizeBytes - 1;
+	size_t start = __wmin( depth + 8, __wmin( length, otherLength ));
+	return compareBytes( &a->string->cstring[start], length - start, &b->string->cstring[start], otherLength - start );
+}
+
+static void
+insertionSort( SortItem* items, size_t n, size_t depth )
+{
+	for ( size_t i = 1; i < n; i++ ) {
+		SortItem item = items[i];
+		size_t j = i;
+		while ( j > 0 and compareItems( &items[j - 1], &item, depth ) > 0 ) {
+			items[j] = items[j - 1];
+			j--;
+		}
+		items[j] = item;
+	}
+}
+
+static inline uint64_t
+medianOfThree( uint64_t a, uint64_t b, uint64_t c )
+{
+	if ( a < b ) {
+		if ( b < c ) return b;
+		return a < c ? c : a;
+	}
+	if ( a < c ) return a;
+	return b < c ? c : b;
+}
+
+//Multikey quicksort by Bentley and Sedgewick, comparing 8 bytes at a time.
+static void
+multikeyQuicksort( SortItem* items, size_t n, size_t depth )
+{
+	while ( n > 1 ) {
+		if ( n < SortInsertionThreshold ) {
+			insertionSort( items, n, depth );
+			return;
+		}
+
+		//Partition into keys less than, equal to and greater than the pivot.
+		uint64_t pivot = medianOfThree( items[0].key, items[n / 2].key, items[n - 1].key );
+		size_t less = 0, current = 0, greater = n;
+		while ( current < greater ) {
+			if ( items[current].key < pivot )
+				swapItems( &items[less++], &items[current++] );
+			else if ( items[current].key > pivot )
+				swapItems( &items[current], &items[--greater] );
+			else
+				current++;
+		}
+
+		//Strings with equal keys continue with their next 8 bytes, unless all of them
+		//end within the key.
+		bool ended = sortKeyEndsString( pivot );
+		for ( size_t i = less; ended and i < greater; i++ )
+			ended = items[i].string->sizeBytes - 1 <= depth + 8;
+
+		if ( ended )
+			sortByLength( &items[less], greater - less );
+		else {
+			for ( size_t i = less; i < greater; i++ )
+				items[i].key = sortKey( items[i].string, depth + 8 );
+			multikeyQuicksort( &items[less], greater - less, depth + 8 );
+		}
+
+		//Recurse into the smaller partition and loop over the larger one.
+		if ( less < n - greater ) {
+			multikeyQuicksort( items, less, depth );
+			items += greater;
+			n -= greater;
+		}
+		else {
+			multikeyQuicksort( &items[greater], n - greater, depth );
+			n = less;
+		}
+	}
+}
+
+void
+wstring_sortArray( WString* strings[], size_t n )
+{
+	assert( strings or n == 0 );
+
+	if ( n < 2 ) return;
+
+	SortItem* items = __wxmalloc( n * sizeof( SortItem ));
+	for ( size_t i = 0; i < n; i++ ) {
+		assert( strings[i] );
+		items[i] = (SortItem){ sortKey( strings[i], 0 ), strings[i] };
+	}
+
+	multikeyQuicksort( items, n, 0 );
+
+	for ( size_t i = 0; i < n; i++ )
+		strings[i] = items[i].string;
+	free( items );
+}
+
+//---------------------------------------------------------------------------------
+//	Collation keys
+//---------------------------------------------------------------------------------
+
+enum CollationConstants {
+	CollationLevelSeparator	= 0x01,
+	MaxCollationGrowth		= 2,	//Bytes per input byte of a level, e.g. ß (2 bytes) -> ss
+};
+
+//Base letters of the accented letters in Latin-1 and Latin Extended-A, sorted by code point.
+typedef struct {
+	uint16_t	first;
+	uint16_t	last;
+	char		base[3];
+}BaseLetters;
+
+static const BaseLetters baseLetters[] = {
+	{ 0x00C0, 0x00C5, "a" }, { 0x00C6, 0x00C6, "ae" }, { 0x00C7, 0x00C7, "c" },
+	{ 0x00C8, 0x00CB, "e" }, { 0x00CC, 0x00CF, "i" }, { 0x00D0, 0x00D0, "d" },
+	{ 0x00D1, 0x00D1, "n" }, { 0x00D2, 0x00D6, "o" }, { 0x00D8, 0x00D8, "o" },
+	{ 0x00D9, 0x00DC, "u" }, { 0x00DD, 0x00DD, "y" }, { 0x00DE, 0x00DE, "th" },
+	{ 0x00DF, 0x00DF, "ss" }, { 0x00E0, 0x00E5, "a" }, { 0x00E6, 0x00E6, "ae" },
+	{ 0x00E7, 0x00E7, "c" }, { 0x00E8, 0x00EB, "e" }, { 0x00EC, 0x00EF, "i" },
+	{ 0x00F0, 0x00F0, "d" }, { 0x00F1, 0x00F1, "n" }, { 0x00F2, 0x00F6, "o" },
+	{ 0x00F8, 0x00F8, "o" }, { 0x00F9, 0x00FC, "u" }, { 0x00FD, 0x00FD, "y" },
+	{ 0x00FE, 0x00FE, "th" }, { 0x00FF, 0x00FF, "y" }, { 0x0100, 0x0105, "a" },
+	{ 0x0106, 0x010D, "c" }, { 0x010E, 0x0111, "d" }, { 0x0112, 0x011B, "e" },
+	{ 0x011C, 0x0123, "g" }, { 0x0124, 0x0127, "h" }, { 0x0128, 0x0131, "i" },
+	{ 0x0132, 0x0133, "ij" }, { 0x0134, 0x0135, "j" }, { 0x0136, 0x0138, "k" },
+	{ 0x0139, 0x0142, "l" }, { 0x0143, 0x014B, "n" }, { 0x014C, 0x0151, "o" },
+	{ 0x0152, 0x0153, "oe" }, { 0x0154, 0x0159, "r" }, { 0x015A, 0x0161, "s" },
+	{ 0x0162, 0x0167, "t" }, { 0x0168, 0x0173, "u" }, { 0x0174, 0x0175, "w" },
+	{ 0x0176, 0x0178, "y" }, { 0x0179, 0x017E, "z" }, { 0x017F, 0x017F, "s" },
+};
+
+static const char*
+baseLetter( wint_t c )
+{
+	size_t low = 0, high = sizeof( baseLetters ) / sizeof( baseLetters[0] );
+	while ( low < high ) {
+		size_t middle = low + ( high - low ) / 2;
+		if ( c > baseLetters[middle].last )
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	if ( low < sizeof( baseLetters ) / sizeof( baseLetters[0] ) and c >= baseLetters[low].first )
+		return baseLetters[low].base;
+	return NULL;
+}
+
+//Write one level of a key: the lower case characters, optionally without their accents
+//and without control characters. Invalid multibyte sequences are copied byte by byte.
+static size_t
+writeCollationLevel( char* key, const WString* string, bool baseLetters, bool skipControls )
+{
+	const char* bytes = string->cstring;
+	size_t remaining = string->sizeBytes - 1;
+	size_t length = 0;
+	mbstate_t state = { 0 };
+
+	while ( remaining > 0 ) {
+		unsigned char byte = *bytes;
+		if ( byte < 0x80 ) {
+			if ( not ( skipControls and ( byte < 0x20 or byte == 0x7F )))
+				key[length++] = byte >= 'A' and byte <= 'Z' ? byte + ( 'a' - 'A' ) : byte;
+			bytes++, remaining--;
+			continue;
+		}
+
+		wchar_t c;
+		size_t n = mbrtowc( &c, bytes, remaining, &state );
+		if ( n == (size_t)-1 or n == (size_t)-2 ) {
+			key[length++] = byte;
+			bytes++, remaining--;
+			memset( &state, 0, sizeof( state ));
+			continue;
+		}
+
+		const char* base = baseLetters ? baseLetter( c ) : NULL;
+		size_t written = (size_t)-1;
+		if ( base ) {
+			written = strlen( base );
+			memcpy( &key[length], base, written );
+		}
+		else
+		if ( not ( skipControls and iswcntrl( c )))
+			written = wcrtomb( &key[length], towlower( c ), &(mbstate_t){ 0 });
+		else
+			written = 0;
+
+		if ( written == (size_t)-1 ) {
+			memcpy( &key[length], bytes, n );
+			written = n;
+		}
+		length += written;
+		bytes += n, remaining -= n;
+	}
+
+	return length;
+}
+
+WString*
+wstring_sortKey( const WString* string, WStringCollation collation )
+{
+	assert( string );
+	assert( collation == WStringCollationIgnoreCase or collation == WStringCollationSimple );
+
+	size_t length = string->sizeBytes - 1;
+	char* key = __wxmalloc( ( 2 * MaxCollationGrowth + 1 ) * length + 3 );
+	size_t keyLength;
+
+	if ( collation == WStringCollationIgnoreCase )
+		keyLength = writeCollationLevel( key, string, false, false );
+	else {
+		keyLength = writeCollationLevel( key, string, true, true );
+		key[keyLength++] = CollationLevelSeparator;
+		keyLength += writeCollationLevel( &key[keyLength], string, false, true );
+		key[keyLength++] = CollationLevelSeparator;
+		memcpy( &key[keyLength], string->cstring, length );
+		keyLength += length;
+	}
+
+	WString* result = wstring_fromView( (WStringView){ key, keyLength });
+	free( key );
+
+	assert( result );
+	return checkString( result );
+}
+
+//---------------------------------------------------------------------------------
+
+int
+wstring_toInt( const WString* string )
+{
+	assert( string );
+
+	const char* start = string->cstring;
+	while ( isspace( (unsigned char)*start )) start++;
+
+	int64_t value;
+	size_t length = string->sizeBytes - 1 - ( start - string->cstring );
+	if ( wstring_parseInt64( start, length, &value, NULL ) != WStringParseOk )
+		return INT_MIN;
+
+	if ( value < INT_MIN or value > INT_MAX )
+		return INT_MIN;
+
+	return value;
+}
+
+double
 wstring_toDouble( const WString* string )
 {
 	assert( string );
 
-	char *endptr;
+	const char* start = string->cstring;
+	while ( isspace( (unsigned char)*start )) start++;
+
+	double value;
+	size_t length = string->sizeBytes - 1 - ( start - string->cstring );
+	if ( wstring_parseDouble( start, length, &value, NULL ) == WStringParseNoNumber )
+		return NAN;
+
+	return value;
+}
+
+//---------------------------------------------------------------------------------
+//	Number parsing
+//---------------------------------------------------------------------------------
+
+static inline bool
+isDigit( char c )
+{
+	return (unsigned char)( c - '0' ) < 10;
+}
+
+//Check in parallel if all 8 bytes of the word are the characters '0' to '9'.
+static inline bool
+swarIsEightDigits( uint64_t word )
+{
+	return not ((( word + 0x4646464646464646 ) | ( word - 0x3030303030303030 )) & 0x8080808080808080 );
+}
+
+//Convert 8 digit characters to their value in parallel.
+static inline uint32_t
+swarParseEightDigits( uint64_t word )
+{
+	const uint64_t mask = 0x000000FF000000FF;
+	const uint64_t mul1 = 0x000F424000000064;	//100 + (1000000 << 32)
+	const uint64_t mul2 = 0x0000271000000001;	//1 + (10000 << 32)
+
+	word -= 0x3030303030303030;
+	word = ( word * 10 ) + ( word >> 8 );		//Pairs of digits
+	word = ((( word & mask ) * mul1 ) + ((( word >> 16 ) & mask ) * mul2 )) >> 32;
+	return (uint32_t)word;
+}
+
+//Check in parallel if all 8 bytes of the word are hexadecimal digits.
+static inline bool
+swarIsEightHexDigits( uint64_t word )
+{
+	const uint64_t high = 0x8080808080808080;
+	if ( word & high ) return false;
+
+	uint64_t lower = word | 0x2020202020202020;
+	uint64_t valid = __wswarInRange( word, '0', '9' ) | __wswarInRange( lower, 'a', 'f' );
+	return valid == high;
+}
+
+//Convert 8 hexadecimal digit characters to their value in parallel.
+static inline uint32_t
+swarParseEightHexDigits( uint64_t word )
+{
+	//Letters have bit 6 set and their low nibble is 1 for a/A, so add 9.
+	word = ( word & 0x0F0F0F0F0F0F0F0F ) + (( word >> 6 ) & 0x0101010101010101 ) * 9;
+
+	//Merge neighbouring nibbles, bytes and 16 bit words. The first digit is the lowest byte.
+	word = (( word & 0x0F000F000F000F00 ) >> 8 ) | (( word & 0x000F000F000F000F ) << 4 );
+	word = (( word & 0x00FF000000FF0000 ) >> 16 ) | (( word & 0x000000FF000000FF ) << 8 );
+	word = (( word & 0x0000FFFF00000000 ) >> 32 ) | (( word & 0x000000000000FFFF ) << 16 );
+	return (uint32_t)word;
+}
+
+static inline int
+hexValue( char c )
+{
+	if ( isDigit( c )) return c - '0';
+	c |= 0x20;
+	if ( c >= 'a' and c <= 'f' ) return c - 'a' + 10;
+	return -1;
+}
+
+//Parse decimal digits as far as possible. Returns the number of consumed bytes.
+//Sets overflow, but still consumes all digits, if the value does not fit into 64 bit.
+static size_t
+parseDecimalDigits( const char* bytes, size_t length, uint64_t* value, bool* overflow )
+{
+	size_t index = 0;
+	while ( index < length and bytes[index] == '0' ) index++;
+
+	//Up to 19 digits always fit into 64 bits, so parse them without overflow checks.
+	size_t start = index;
+	uint64_t result = 0;
+	while ( length - index >= 8 and index - start <= 11 and swarIsEightDigits( __wload8( &bytes[index] ))) {
+		result = result * 100000000 + swarParseEightDigits( __wload8( &bytes[index] ));
+		index += 8;
+	}
+	while ( index < length and index - start < 19 and isDigit( bytes[index] )) {
+		result = result * 10 + ( bytes[index] - '0' );
+		index++;
+	}
+
+	*overflow = false;
+	while ( index < length and isDigit( bytes[index] )) {
+		if ( __builtin_mul_overflow( result, 10, &result ) or
+			 __builtin_add_overflow( result, (uint64_t)( bytes[index] - '0' ), &result ))
+			*overflow = true;
+		index++;
+	}
+
+	*value = *overflow ? UINT64_MAX : result;
+	return index;
+}
+
+WStringParseStatus
+wstring_parseUint64( const char bytes[], size_t length, uint64_t* value, size_t* consumed )
+{
+	assert( bytes or length == 0 );
+	assert( value );
+
+	size_t index = 0;
+	if ( index < length and bytes[index] == '+' ) index++;
+	if ( index == length or not isDigit( bytes[index] ))
+		return WStringParseNoNumber;
+
+	bool overflow;
+	index += parseDecimalDigits( &bytes[index], length - index, value, &overflow );
+
+	if ( consumed ) *consumed = index;
+	return overflow ? WStringParseOutOfRange : WStringParseOk;
+}
+
+WStringParseStatus
+wstring_parseInt64( const char bytes[], size_t length, int64_t* value, size_t* consumed )
+{
+	assert( bytes or length == 0 );
+	assert( value );
+
+	size_t index = 0;
+	bool negative = false;
+	if ( index < length and ( bytes[index] == '-' or bytes[index] == '+' )) {
+		negative = bytes[index] == '-';
+		index++;
+	}
+	if ( index == length or not isDigit( bytes[index] ))
+		return WStringParseNoNumber;
+
+	bool overflow;
+	uint64_t magnitude;
+	index += parseDecimalDigits( &bytes[index], length - index, &magnitude, &overflow );
+
+	uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+	if ( overflow or magnitude > limit ) {
+		overflow = true;
+		magnitude = limit;
+	}
+	*value = negative ? (int64_t)( 0 - magnitude ) : (int64_t)magnitude;
+
+	if ( consumed ) *consumed = index;
+	return overflow ? WStringParseOutOfRange : WStringParseOk;
+}
+
+WStringParseStatus
+wstring_parseHex( const char bytes[], size_t length, uint64_t* value, size_t* consumed )
+{
+	assert( bytes or length == 0 );
+	assert( value );
+
+	size_t index = 0;
+	if ( length >= 3 and bytes[0] == '0' and ( bytes[1] | 0x20 ) == 'x' and hexValue( bytes[2] ) >= 0 )
+		index = 2;
+	if ( index == length or hexValue( bytes[index] ) < 0 )
+		return WStringParseNoNumber;
+
+	while ( index < length and bytes[index] == '0' ) index++;
+
+	//Up to 16 digits always fit into 64 bits.
+	size_t start = index;
+	uint64_t result = 0;
+	while ( length - index >= 8 and index - start <= 8 and swarIsEightHexDigits( __wload8( &bytes[index] ))) {
+		result = ( result << 32 ) | swarParseEightHexDigits( __wload8( &bytes[index] ));
+		index += 8;
+	}
+
+	int digit;
+	bool overflow = false;
+	while ( index < length and ( digit = hexValue( bytes[index] )) >= 0 ) {
+		if ( index - start >= 16 ) overflow = true;
+		result = ( result << 4 ) | digit;
+		index++;
+	}
+
+	*value = overflow ? UINT64_MAX : result;
+	if ( consumed ) *consumed = index;
+	return overflow ? WStringParseOutOfRange : WStringParseOk;
+}
+
+//---------------------------------------------------------------------------------
+
+enum EiselLemireConstants {
+	DoubleMantissaBits		= 52,
+	DoubleMinimumExponent	= -1023,
+	DoubleInfinitePower		= 0x7FF,
+	SmallestPowerOfTen		= -342,
+	LargestPowerOfTen		= 308,
+	SmallestPowerOfFive		= -342,
+	MinExponentRoundToEven	= -4,
+	MaxExponentRoundToEven	= 23,
+	MaxFastPathExponent		= 22,
+};
+
+//128 bit approximations of the powers of five from 5^-342 to 5^308, high word first.
+static const uint64_t powersOfFive[2 * ( LargestPowerOfTen - SmallestPowerOfFive + 1 )];
+
+typedef struct {
+	uint64_t	high;
+	uint64_t	low;
+}UInt128;
+
+static inline UInt128
+multiply128( uint64_t a, uint64_t b )
+{
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 product = (unsigned __int128)a * b;
+	return (UInt128){ .high = product >> 64, .low = (uint64_t)product };
+#else
+	uint64_t aLow = (uint32_t)a, aHigh = a >> 32;
+	uint64_t bLow = (uint32_t)b, bHigh = b >> 32;
+
+	uint64_t lowLow = aLow * bLow;
+	uint64_t highLow = aHigh * bLow;
+	uint64_t lowHigh = aLow * bHigh;
+	uint64_t highHigh = aHigh * bHigh;
+
+	uint64_t middle = ( lowLow >> 32 ) + (uint32_t)highLow + lowHigh;
+	return (UInt128){
+		.high = highHigh + ( highLow >> 32 ) + ( middle >> 32 ),
+		.low = ( middle << 32 ) | (uint32_t)lowLow,
+	};
+#endif
+}
+
+//The double w * 10^q as raw mantissa and biased exponent, without the sign.
+typedef struct {
+	uint64_t	mantissa;
+	int32_t		power2;
+}AdjustedMantissa;
+
+//Compute w * 10^q with the Eisel-Lemire algorithm, following the fast_float library.
+static AdjustedMantissa
+eiselLemire( int64_t q, uint64_t w )
+{
+	if ( w == 0 or q < SmallestPowerOfTen )
+		return (AdjustedMantissa){ 0, 0 };
+	if ( q > LargestPowerOfTen )
+		return (AdjustedMantissa){ 0, DoubleInfinitePower };
+
+	int leadingZeros = __builtin_clzll( w );
+	w <<= leadingZeros;
+
+	//Multiply w with the truncated 128 bit power of five. The second half of the power
+	//is only needed if the bits that decide the rounding might still change.
+	size_t index = 2 * ( q - SmallestPowerOfFive );
+	UInt128 product = multiply128( w, powersOfFive[index] );
+	const uint64_t precisionMask = UINT64_MAX >> ( DoubleMantissaBits + 3 );
+	if (( product.high & precisionMask ) == precisionMask ) {
+		UInt128 second = multiply128( w, powersOfFive[index + 1] );
+		product.low += second.high;
+		if ( second.high > product.low ) product.high++;
+	}
+
+	int upperBit = product.high >> 63;
+	int shift = upperBit + 64 - DoubleMantissaBits - 3;
+	AdjustedMantissa result = {
+		.mantissa = product.high >> shift,
+		.power2 = (int32_t)((((( 152170 + 65536 ) * (int32_t)q ) >> 16 ) + 63 ) + upperBit - leadingZeros - DoubleMinimumExponent ),
+	};
+
+	//Subnormal numbers
+	if ( result.power2 <= 0 ) {
+		if ( -result.power2 + 1 >= 64 )
+			return (AdjustedMantissa){ 0, 0 };
+
+		result.mantissa >>= -result.power2 + 1;
+		result.mantissa += result.mantissa & 1;
+		result.mantissa >>= 1;
+		result.power2 = result.mantissa < ( UINT64_C(1) << DoubleMantissaBits ) ? 0 : 1;
+		return result;
+	}
+
+	//Exactly between two doubles: round to even
+	if ( product.low <= 1 and q >= MinExponentRoundToEven and q <= MaxExponentRoundToEven and
+		 ( result.mantissa & 3 ) == 1 and ( result.mantissa << shift ) == product.high )
+		result.mantissa &= ~UINT64_C(1);
+
+	result.mantissa += result.mantissa & 1;
+	result.mantissa >>= 1;
+	if ( result.mantissa >= ( UINT64_C(2) << DoubleMantissaBits )) {
+		result.mantissa = UINT64_C(1) << DoubleMantissaBits;
+		result.power2++;
+	}
+	result.mantissa &= ~( UINT64_C(1) << DoubleMantissaBits );
+
+	if ( result.power2 >= DoubleInfinitePower )
+		return (AdjustedMantissa){ 0, DoubleInfinitePower };
+
+	return result;
+}
+
+static double
+toBinaryDouble( AdjustedMantissa am, bool negative )
+{
+	uint64_t bits = am.mantissa | ((uint64_t)am.power2 << DoubleMantissaBits );
+	if ( negative ) bits |= UINT64_C(1) << 63;
+
+	double value;
+	memcpy( &value, &bits, sizeof( value ));
+	return value;
+}
+
+//Fallback for the rare numbers with more than 19 significant digits which are too close
+//to the middle of two doubles.
+static double
+parseDoubleSlow( const char* bytes, size_t length )
+{
+	char* copy = __wxmalloc( length + 1 );
+	memcpy( copy, bytes, length );
+	copy[length] = '\0';
+
+	locale_t cLocale = newlocale( LC_ALL_MASK, "C", (locale_t)0 );
+	if ( not cLocale ) __wdie( "Out of memory." );
+	double value = strtod_l( copy, NULL, cLocale );
+
+	freelocale( cLocale );
+	free( copy );
+	return value;
+}
+
+static bool
+startsWithCase( const char* bytes, size_t length, const char* word )
+{
+	size_t wordLength = strlen( word );
+	if ( length < wordLength ) return false;
+
+	for ( size_t i = 0; i < wordLength; i++ )
+		if (( bytes[i] | 0x20 ) != word[i] ) return false;
+
+	return true;
+}
+
+WStringParseStatus
+wstring_parseDouble( const char bytes[], size_t length, double* value, size_t* consumed )
+{
+	assert( bytes or length == 0 );
+	assert( value );
+
+	const char* current = bytes;
+	const char* end = bytes + length;
+
+	bool negative = false;
+	if ( current < end and ( *current == '-' or *current == '+' )) {
+		negative = *current == '-';
+		current++;
+	}
+
+	//Infinity and NaN
+	if ( current < end and not isDigit( *current ) and *current != '.' ) {
+		size_t rest = end - current;
+		if ( startsWithCase( current, rest, "nan" )) {
+			*value = negative ? -NAN : NAN;
+			current += 3;
+		}
+		else if ( startsWithCase( current, rest, "infinity" )) {
+			*value = negative ? -INFINITY : INFINITY;
+			current += 8;
+		}
+		else if ( startsWithCase( current, rest, "inf" )) {
+			*value = negative ? -INFINITY : INFINITY;
+			current += 3;
+		}
+		else
+			return WStringParseNoNumber;
+
+		if ( consumed ) *consumed = current - bytes;
+		return WStringParseOk;
+	}
+
+	//Integer part. Overflowing the mantissa is fine, too many digits are handled below.
+	uint64_t mantissa = 0;
+	const char* integerStart = current;
+	while ( end - current >= 8 and swarIsEightDigits( __wload8( current ))) {
+		mantissa = mantissa * 100000000 + swarParseEightDigits( __wload8( current ));
+		current += 8;
+	}
+	while ( current < end and isDigit( *current )) {
+		mantissa = mantissa * 10 + ( *current - '0' );
+		current++;
+	}
+	const char* integerEnd = current;
+	int64_t digitCount = integerEnd - integerStart;
+
+	//Fraction
+	int64_t exponent = 0;
+	const char* fractionStart = NULL;
+	const char* fractionEnd = NULL;
+	if ( current < end and *current == '.' ) {
+		current++;
+		fractionStart = current;
+		while ( end - current >= 8 and swarIsEightDigits( __wload8( current ))) {
+			mantissa = mantissa * 100000000 + swarParseEightDigits( __wload8( current ));
+			current += 8;
+		}
+		while ( current < end and isDigit( *current )) {
+			mantissa = mantissa * 10 + ( *current - '0' );
+			current++;
+		}
+		fractionEnd = current;
+		exponent = fractionStart - fractionEnd;
+		digitCount -= exponent;
+	}
+	if ( digitCount == 0 )
+		return WStringParseNoNumber;
+
+	//Exponent. A lonely 'e' does not belong to the number.
+	int64_t explicitExponent = 0;
+	if ( current < end and ( *current | 0x20 ) == 'e' ) {
+		const char* exponentStart = current++;
+		bool negativeExponent = false;
+		if ( current < end and ( *current == '-' or *current == '+' )) {
+			negativeExponent = *current == '-';
+			current++;
+		}
+		if ( current < end and isDigit( *current )) {
+			while ( current < end and isDigit( *current )) {
+				if ( explicitExponent < 0x10000000 )
+					explicitExponent = explicitExponent * 10 + ( *current - '0' );
+				current++;
+			}
+			if ( negativeExponent ) explicitExponent = -explicitExponent;
+			exponent += explicitExponent;
+		}
+		else
+			current = exponentStart;
+	}
+	if ( consumed ) *consumed = current - bytes;
+
+	//More than 19 significant digits: Keep the first 19 digits and remember to
+	//check whether the dropped ones could influence the result.
+	bool tooManyDigits = false;
+	if ( digitCount > 19 ) {
+		for ( const char* start = integerStart; start < end and ( *start == '0' or *start == '.' ); start++ )
+			if ( *start == '0' ) digitCount--;
+
+		if ( digitCount > 19 ) {
+			tooManyDigits = true;
+			const uint64_t minimalNineteenDigits = UINT64_C(1000000000000000000);
+
+			mantissa = 0;
+			const char* digit = integerStart;
+			while ( mantissa < minimalNineteenDigits and digit != integerEnd )
+				mantissa = mantissa * 10 + ( *digit++ - '0' );
+
+			if ( mantissa >= minimalNineteenDigits )
+				exponent = ( integerEnd - digit ) + explicitExponent;
+			else {
+				digit = fractionStart;
+				while ( mantissa < minimalNineteenDigits and digit != fractionEnd )
+					mantissa = mantissa * 10 + ( *digit++ - '0' );
+				exponent = ( fractionStart - digit ) + explicitExponent;
+			}
+		}
+	}
+
+	//Fast path: Both mantissa and power of ten are exact doubles, so a single
+	//correctly rounded IEEE operation gives the correctly rounded result.
+#if FLT_EVAL_METHOD == 0
+	static const double exactPowersOfTen[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+	};
+	if ( not tooManyDigits and exponent >= -MaxFastPathExponent and exponent <= MaxFastPathExponent and
+		 mantissa <= ( UINT64_C(1) << ( DoubleMantissaBits + 1 ))) {
+		double result = (double)mantissa;
+		if ( exponent < 0 )
+			result /= exactPowersOfTen[-exponent];
+		else
+			result *= exactPowersOfTen[exponent];
+
+		*value = negative ? -result : result;
+		return WStringParseOk;
+	}
+#endif
+
+	AdjustedMantissa am = eiselLemire( exponent, mantissa );
+	if ( tooManyDigits ) {
+		AdjustedMantissa upper = eiselLemire( exponent, mantissa + 1 );
+		if ( am.mantissa != upper.mantissa or am.power2 != upper.power2 ) {
+			*value = parseDoubleSlow( bytes, current - bytes );
+			return isinf( *value ) ? WStringParseOutOfRange : WStringParseOk;
+		}
+	}
+
+	*value = toBinaryDouble( am, negative );
+	return am.power2 == DoubleInfinitePower ? WStringParseOutOfRange : WStringParseOk;
+}
+
+//---------------------------------------------------------------------------------
+//	Number formatting
+//---------------------------------------------------------------------------------
+
+static const char digitPairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+static size_t
+decimalLength( uint64_t value )
+{
+	size_t length = 1;
+	for (;;) {
+		if ( value < 10 ) return length;
+		if ( value < 100 ) return length + 1;
+		if ( value < 1000 ) return length + 2;
+		if ( value < 10000 ) return length + 3;
+		value /= 10000;
+		length += 4;
+	}
+}
+
+//Write the decimal digits of value, two at a time from the back. Returns the number of digits.
+static size_t
+formatUint64( char* buffer, uint64_t value )
+{
+	size_t length = decimalLength( value );
+	char* current = buffer + length;
+
+	while ( value >= 100 ) {
+		current -= 2;
+		memcpy( current, &digitPairs[( value % 100 ) * 2], 2 );
+		value /= 100;
+	}
+	if ( value >= 10 ) {
+		current -= 2;
+		memcpy( current, &digitPairs[value * 2], 2 );
+	}
+	else
+		*--current = (char)( '0' + value );
+
+	assert( current == buffer );
+	return length;
+}
+
+//---------------------------------------------------------------------------------
+
+enum RyuConstants {
+	DoubleExponentBits		= 11,
+	DoubleBias				= 1023,
+	DoublePow5InvBitCount	= 125,
+	DoublePow5BitCount		= 125,
+	DoublePow5InvTableSize	= 342,
+	DoublePow5TableSize		= 326,
+};
+
+//Ryu's tables of 2^k / 5^q and 5^q, both with 125 significant bits, low word first.
+static const uint64_t doublePow5InvSplit[DoublePow5InvTableSize][2];
+static const uint64_t doublePow5Split[DoublePow5TableSize][2];
+
+//The shortest decimal mantissa * 10^exponent that parses back to a given double.
+typedef struct {
+	uint64_t	mantissa;
+	int32_t		exponent;
+}DecimalDouble;
+
+static inline uint32_t
+pow5Factor( uint64_t value )
+{
+	uint32_t count = 0;
+	while ( value % 5 == 0 ) {
+		value /= 5;
+		count++;
+	}
+	return count;
+}
+
+static inline bool
+multipleOfPowerOf5( uint64_t value, uint32_t p )
+{
+	return pow5Factor( value ) >= p;
+}
+
+static inline bool
+multipleOfPowerOf2( uint64_t value, uint32_t p )
+{
+	return ( value & (( UINT64_C(1) << p ) - 1 )) == 0;
+}
+
+//ceil(log2(5^e)) for 0 <= e <= 3528
+static inline int32_t
+pow5Bits( int32_t e )
+{
+	return (int32_t)(((( uint32_t)e * 1217359 ) >> 19 ) + 1 );
+}
+
+//floor(log10(2^e)) for 0 <= e <= 1650
+static inline uint32_t
+log10Pow2( int32_t e )
+{
+	return ((uint32_t)e * 78913 ) >> 18;
+}
+
+//floor(log10(5^e)) for 0 <= e <= 2620
+static inline uint32_t
+log10Pow5( int32_t e )
+{
+	return ((uint32_t)e * 732923 ) >> 20;
+}
+
+//(m * mul) >> j, where mul is a 128 bit number and 64 < j < 128
+static inline uint64_t
+mulShift64( uint64_t m, const uint64_t mul[2], int32_t j )
+{
+	UInt128 low = multiply128( m, mul[0] );
+	UInt128 high = multiply128( m, mul[1] );
+
+	uint64_t sumLow = high.low + low.high;
+	uint64_t sumHigh = high.high + ( sumLow < low.high );
+
+	int32_t shift = j - 64;
+	assert( shift > 0 and shift < 64 );
+	return ( sumHigh << ( 64 - shift )) | ( sumLow >> shift );
+}
+
+//Compute the shortest representation with the Ryu algorithm by Ulf Adams.
+static DecimalDouble
+ryu( uint64_t ieeeMantissa, uint32_t ieeeExponent )
+{
+	int32_t e2;
+	uint64_t m2;
+	if ( ieeeExponent == 0 ) {
+		e2 = 1 - DoubleBias - DoubleMantissaBits - 2;
+		m2 = ieeeMantissa;
+	}
+	else {
+		e2 = (int32_t)ieeeExponent - DoubleBias - DoubleMantissaBits - 2;
+		m2 = ( UINT64_C(1) << DoubleMantissaBits ) | ieeeMantissa;
+	}
+	bool acceptBounds = ( m2 & 1 ) == 0;
+
+	//The value and its interval of numbers that round to it, all multiplied by 4.
+	uint64_t mv = 4 * m2;
+	uint32_t mmShift = ieeeMantissa != 0 or ieeeExponent <= 1;
+
+	//Convert the interval to decimal: vr * 10^e10, vp * 10^e10 and vm * 10^e10
+	uint64_t vr, vp, vm;
+	int32_t e10;
+	bool vmIsTrailingZeros = false;
+	bool vrIsTrailingZeros = false;
+	if ( e2 >= 0 ) {
+		uint32_t q = log10Pow2( e2 ) - ( e2 > 3 );
+		e10 = (int32_t)q;
+		int32_t k = DoublePow5InvBitCount + pow5Bits( (int32_t)q ) - 1;
+		int32_t i = -e2 + (int32_t)q + k;
+		vr = mulShift64( 4 * m2, doublePow5InvSplit[q], i );
+		vp = mulShift64( 4 * m2 + 2, doublePow5InvSplit[q], i );
+		vm = mulShift64( 4 * m2 - 1 - mmShift, doublePow5InvSplit[q], i );
+
+		if ( q <= 21 ) {
+			if ( mv % 5 == 0 )
+				vrIsTrailingZeros = multipleOfPowerOf5( mv, q );
+			else if ( acceptBounds )
+				vmIsTrailingZeros = multipleOfPowerOf5( mv - 1 - mmShift, q );
+			else
+				vp -= multipleOfPowerOf5( mv + 2, q );
+		}
+	}
+	else {
+		uint32_t q = log10Pow5( -e2 ) - ( -e2 > 1 );
+		e10 = (int32_t)q + e2;
+		int32_t i = -e2 - (int32_t)q;
+		int32_t k = pow5Bits( i ) - DoublePow5BitCount;
+		int32_t j = (int32_t)q - k;
+		vr = mulShift64( 4 * m2, doublePow5Split[i], j );
+		vp = mulShift64( 4 * m2 + 2, doublePow5Split[i], j );
+		vm = mulShift64( 4 * m2 - 1 - mmShift, doublePow5Split[i], j );
+
+		if ( q <= 1 ) {
+			vrIsTrailingZeros = true;
+			if ( acceptBounds )
+				vmIsTrailingZeros = mmShift == 1;
+			else
+				vp--;
+		}
+		else if ( q < 63 )
+			vrIsTrailingZeros = multipleOfPowerOf2( mv, q );
+	}
+
+	//Remove digits as long as the interval still contains a unique shortest number.
+	int32_t removed = 0;
+	uint8_t lastRemovedDigit = 0;
+	uint64_t output;
+	if ( vmIsTrailingZeros or vrIsTrailingZeros ) {
+		while ( vp / 10 > vm / 10 ) {
+			vmIsTrailingZeros &= vm % 10 == 0;
+			vrIsTrailingZeros &= lastRemovedDigit == 0;
+			lastRemovedDigit = (uint8_t)( vr % 10 );
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			removed++;
+		}
+		if ( vmIsTrailingZeros ) {
+			while ( vm % 10 == 0 ) {
+				vrIsTrailingZeros &= lastRemovedDigit == 0;
+				lastRemovedDigit = (uint8_t)( vr % 10 );
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+				removed++;
+			}
+		}
+		//Exactly in the middle: round to even
+		if ( vrIsTrailingZeros and lastRemovedDigit == 5 and vr % 2 == 0 )
+			lastRemovedDigit = 4;
+
+		output = vr + (( vr == vm and ( not acceptBounds or not vmIsTrailingZeros )) or lastRemovedDigit >= 5 );
+	}
+	else {
+		//The common case, which can skip the trailing zero bookkeeping.
+		bool roundUp = false;
+		if ( vp / 100 > vm / 100 ) {
+			roundUp = vr % 100 >= 50;
+			vr /= 100;
+			vp /= 100;
+			vm /= 100;
+			removed += 2;
+		}
+		while ( vp / 10 > vm / 10 ) {
+			roundUp = vr % 10 >= 5;
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			removed++;
+		}
+		output = vr + ( vr == vm or roundUp );
+	}
+
+	return (DecimalDouble){ .mantissa = output, .exponent = e10 + removed };
+}
+
+//Write a double like printf's "%.17g", but with the shortest round trip digits.
+//Returns the number of characters.
+static size_t
+formatDouble( char* buffer, double value )
+{
+	uint64_t bits;
+	memcpy( &bits, &value, sizeof( bits ));
+	bool negative = bits >> 63;
+	uint64_t ieeeMantissa = bits & (( UINT64_C(1) << DoubleMantissaBits ) - 1 );
+	uint32_t ieeeExponent = ( bits >> DoubleMantissaBits ) & (( 1u << DoubleExponentBits ) - 1 );
+
+	char* current = buffer;
+	if ( ieeeExponent == ( 1u << DoubleExponentBits ) - 1 and ieeeMantissa ) {
+		memcpy( current, "nan", 3 );
+		return 3;
+	}
+	if ( negative )
+		*current++ = '-';
+	if ( ieeeExponent == ( 1u << DoubleExponentBits ) - 1 ) {
+		memcpy( current, "inf", 3 );
+		return current + 3 - buffer;
+	}
+	if ( ieeeExponent == 0 and ieeeMantissa == 0 ) {
+		*current++ = '0';
+		return current - buffer;
+	}
+
+	DecimalDouble decimal = ryu( ieeeMantissa, ieeeExponent );
+	char digits[20];
+	size_t length = formatUint64( digits, decimal.mantissa );
+	while ( length > 1 and digits[length - 1] == '0' ) {
+		length--;
+		decimal.exponent++;
+	}
+
+	//Exponent of the first digit
+	int32_t exponent = decimal.exponent + (int32_t)length - 1;
+
+	if ( exponent >= -4 and exponent < 17 ) {
+		if ( exponent < 0 ) {
+			memcpy( current, "0.", 2 );
+			current += 2;
+			memset( current, '0', -exponent - 1 );
+			current += -exponent - 1;
+			memcpy( current, digits, length );
+			current += length;
+		}
+		else if ( (size_t)exponent + 1 >= length ) {
+			memcpy( current, digits, length );
+			current += length;
+			memset( current, '0', exponent + 1 - length );
+			current += exponent + 1 - length;
+		}
+		else {
+			memcpy( current, digits, exponent + 1 );
+			current += exponent + 1;
+			*current++ = '.';
+			memcpy( current, &digits[exponent + 1], length - exponent - 1 );
+			current += length - exponent - 1;
+		}
+	}
+	else {
+		*current++ = digits[0];
+		if ( length > 1 ) {
+			*current++ = '.';
+			memcpy( current, &digits[1], length - 1 );
+			current += length - 1;
+		}
+		*current++ = 'e';
+		*current++ = exponent < 0 ? '-' : '+';
+		uint32_t magnitude = exponent < 0 ? -exponent : exponent;
+		if ( magnitude < 10 )
+			*current++ = '0';
+		current += formatUint64( current, magnitude );
+	}
+
+	return current - buffer;
+}
+
+//---------------------------------------------------------------------------------
+//	Hashing
+//---------------------------------------------------------------------------------
+
+//Multiply two words and fold the 128 bit product, the mixing step of wyhash.
+static inline uint64_t
+hashMix( uint64_t a, uint64_t b )
+{
+	UInt128 product = multiply128( a, b );
+	return product.high ^ product.low;
+}
+
+//Load the last 1 to 7 bytes of a range, zero extended.
+static inline uint64_t
+hashLoadTail( const char* bytes, size_t length )
+{
+	assert( length < 8 );
+
+	char word[8] = { 0 };
+	memcpy( word, bytes, length );
+	return __wload8( word );
+}
+
+uint64_t
+wstring_hash( const WString* string )
+{
+	assert( string );
+
+	return wstring_hashView( wstring_view( string ));
+}
+
+uint64_t
+wstring_hashView( WStringView view )
+{
+	assert( view.bytes or view.length == 0 );
+
+	const uint64_t secret0 = 0xa0761d6478bd642f;
+	const uint64_t secret1 = 0xe7037ed1a0b428db;
+	const uint64_t secret2 = 0x8ebc6af09c88c6e3;
+
+	const char* current = view.bytes;
+	size_t rest = view.length;
+	uint64_t seed = hashMix( view.length ^ secret0, secret1 );
+
+	while ( rest > 16 ) {
+		seed = hashMix( __wload8( current ) ^ secret1, __wload8( current + 8 ) ^ seed );
+		current += 16;
+		rest -= 16;
+	}
+
+	uint64_t a = 0, b = 0;
+	if ( rest > 8 ) {
+		a = __wload8( current );
+		b = __wload8( current + rest - 8 );
+	}
+	else if ( rest == 8 )
+		a = __wload8( current );
+	else if ( rest > 0 )
+		a = hashLoadTail( current, rest );
+
+	return hashMix( secret1 ^ view.length, hashMix( a ^ secret2, b ^ seed ));
+}
+
+//---------------------------------------------------------------------------------
+//	Signatures
+//---------------------------------------------------------------------------------
+
+WStringSignature
+wstring_signature( const WString* string )
+{
+	assert( string );
+
+	return wstring_signatureView( wstring_view( string ));
+}
 
-	errno = 0;
-	double value = strtod( string->cstring, &endptr );
+WStringSignature
+wstring_signatureView( WStringView view )
+{
+	assert( view.bytes or view.length == 0 );
 
-	if (( errno == ERANGE and ( value == DBL_MAX or value == DBL_MIN )) or ( errno != 0 and value == 0.0 ))
-		return NAN;
+	WStringSignature signature = { { 0 } };
+	const unsigned char* bytes = (const unsigned char*)view.bytes;
 
-	if ( endptr == string->cstring )
-		return NAN;
+	//Fibonacci hashing of the 16 bit pair to the top 8 bits.
+	for ( size_t i = 1; i < view.length; i++ ) {
+		uint32_t pair = (uint32_t)bytes[i - 1] << 8 | bytes[i];
+		uint32_t bit = ( pair * 0x9E3779B1u ) >> 24;
+		signature.bits[bit / 64] |= (uint64_t)1 << ( bit % 64 );
+	}
 
-	return value;
+	return signature;
+}
+
+//---------------------------------------------------------------------------------
+//	Templates
+//---------------------------------------------------------------------------------
+
+enum TemplateConfiguration {
+	TemplateMaxValues		= 1024,
+	TemplateMaxNameLength	= 64,
+};
+
+typedef enum {
+	SegmentLiteral,
+	SegmentCString,
+	SegmentString,
+	SegmentInt,
+	SegmentUint,
+	SegmentDouble,
+}SegmentType;
+
+typedef struct {
+	SegmentType	type;
+	size_t		index;		//Value index, or the offset in the literal text for literals
+	size_t		sizeBytes;	//Literals only: Number of bytes
+	size_t		size;		//Literals only: Number of UTF8 characters
+}TemplateSegment;
+
+struct WStringTemplate {
+	TemplateSegment*	segments;
+	size_t				numberSegments;
+	size_t				numberValues;
+	size_t				valueCapacity;	//Number of entries of valueTypes and names
+	SegmentType*		valueTypes;
+	char**				names;			//NULL for positional templates
+	char*				literals;		//The literal text of all segments, one after another
+	size_t				literalSizeBytes;
+	size_t				literalSize;
+};
+
+static void
+addSegment( WStringTemplate* stringTemplate, size_t* capacity, TemplateSegment segment )
+{
+	if ( stringTemplate->numberSegments == *capacity ) {
+		*capacity = __wmax( 2 * *capacity, 8 );
+		stringTemplate->segments = __wxrealloc( stringTemplate->segments, *capacity * sizeof( TemplateSegment ));
+	}
+	stringTemplate->segments[stringTemplate->numberSegments++] = segment;
+}
+
+//Turn the literal text collected since the last placeholder into a segment.
+static void
+addLiteralSegment( WStringTemplate* stringTemplate, size_t* capacity, size_t start )
+{
+	size_t sizeBytes = stringTemplate->literalSizeBytes - start;
+	if ( sizeBytes == 0 ) return;
+
+	size_t size = __wutf8count( &stringTemplate->literals[start], sizeBytes );
+	addSegment( stringTemplate, capacity, (TemplateSegment){
+		.type = SegmentLiteral, .index = start, .sizeBytes = sizeBytes, .size = size
+	});
+	stringTemplate->literalSize += size;
+}
+
+static bool
+segmentTypeFromChar( char c, SegmentType* type )
+{
+	switch ( c ) {
+	case 's': *type = SegmentCString; return true;
+	case 'S': *type = SegmentString; return true;
+	case 'd': *type = SegmentInt; return true;
+	case 'u': *type = SegmentUint; return true;
+	case 'g': *type = SegmentDouble; return true;
+	default: return false;
+	}
+}
+
+//Make room for count values in valueTypes and names.
+static void
+reserveValues( WStringTemplate* stringTemplate, size_t count )
+{
+	assert( count <= TemplateMaxValues );
+	if ( count <= stringTemplate->valueCapacity )
+		return;
+
+	size_t capacity = __wmin( __wmax( count, stringTemplate->valueCapacity * 2 ), TemplateMaxValues );
+	stringTemplate->valueTypes = __wxrealloc( stringTemplate->valueTypes, capacity * sizeof( SegmentType ));
+	if ( stringTemplate->names )
+		stringTemplate->names = __wxrealloc( stringTemplate->names, capacity * sizeof( char* ));
+	stringTemplate->valueCapacity = capacity;
+}
+
+//Find or add the value index of a placeholder name. Returns false if the template is malformed.
+static bool
+templateValueIndex( WStringTemplate* stringTemplate, const char* name, size_t nameLength, size_t* autoIndex, size_t* index )
+{
+	bool positional = nameLength == 0 or isDigit( name[0] );
+	if ( stringTemplate->numberValues > 0 and positional == ( stringTemplate->names != NULL ))
+		return false;
+
+	if ( nameLength == 0 ) {
+		*index = (*autoIndex)++;
+		return true;
+	}
+
+	if ( positional ) {
+		uint64_t number;
+		size_t consumed;
+		if ( wstring_parseUint64( name, nameLength, &number, &consumed ) != WStringParseOk or consumed != nameLength )
+			return false;
+		if ( number >= TemplateMaxValues )
+			return false;
+		*index = number;
+		return true;
+	}
+
+	for ( size_t i = 0; i < stringTemplate->numberValues; i++ ) {
+		if ( strlen( stringTemplate->names[i] ) == nameLength and memcmp( stringTemplate->names[i], name, nameLength ) == 0 ) {
+			*index = i;
+			return true;
+		}
+	}
+
+	if ( stringTemplate->numberValues == TemplateMaxValues )
+		return false;
+	if ( not stringTemplate->names )
+		stringTemplate->names = __wxcalloc( __wmax( stringTemplate->valueCapacity, 1 ), sizeof( char* ));
+	reserveValues( stringTemplate, stringTemplate->numberValues + 1 );
+
+	*index = stringTemplate->numberValues;
+	stringTemplate->names[*index] = strndup( name, nameLength );
+	if ( not stringTemplate->names[*index] ) __wdie( "Out of memory." );
+	return true;
+}
+
+WStringTemplate*
+wstringtemplate_new( const char* format )
+{
+	assert( format );
+
+	size_t formatLength = strlen( format );
+	WStringTemplate* stringTemplate = __wxcalloc( 1, sizeof( WStringTemplate ));
+	stringTemplate->literals = __wxmalloc( formatLength + 1 );
+
+	size_t segmentCapacity = 0;
+	size_t autoIndex = 0;
+	size_t literalStart = 0;
+	const char* current = format;
+
+	while ( *current ) {
+		if (( current[0] == '{' and current[1] == '{' ) or ( current[0] == '}' and current[1] == '}' )) {
+			stringTemplate->literals[stringTemplate->literalSizeBytes++] = *current;
+			current += 2;
+			continue;
+		}
+		if ( current[0] == '}' )
+			goto malformed;
+		if ( current[0] != '{' ) {
+			stringTemplate->literals[stringTemplate->literalSizeBytes++] = *current++;
+			continue;
+		}
+
+		//A placeholder: {name:type}
+		addLiteralSegment( stringTemplate, &segmentCapacity, literalStart );
+
+		const char* name = ++current;
+		while ( isalnum( (unsigned char)*current ) or *current == '_' ) current++;
+		size_t nameLength = current - name;
+		if ( nameLength > TemplateMaxNameLength )
+			goto malformed;
+
+		SegmentType type = SegmentCString;
+		if ( *current == ':' ) {
+			if ( not segmentTypeFromChar( current[1], &type ))
+				goto malformed;
+			current += 2;
+		}
+		if ( *current++ != '}' )
+			goto malformed;
+
+		size_t index;
+		if ( not templateValueIndex( stringTemplate, name, nameLength, &autoIndex, &index ) or index >= TemplateMaxValues )
+			goto malformed;
+		reserveValues( stringTemplate, index + 1 );
+
+		//A value that appears more than once must always have the same type.
+		if ( index < stringTemplate->numberValues and stringTemplate->valueTypes[index] != SegmentLiteral and stringTemplate->valueTypes[index] != type )
+			goto malformed;
+		for ( size_t i = stringTemplate->numberValues; i <= index; i++ )
+			stringTemplate->valueTypes[i] = SegmentLiteral;
+		stringTemplate->valueTypes[index] = type;
+		stringTemplate->numberValues = __wmax( stringTemplate->numberValues, index + 1 );
+
+		addSegment( stringTemplate, &segmentCapacity, (TemplateSegment){ .type = type, .index = index });
+		literalStart = stringTemplate->literalSizeBytes;
+	}
+	addLiteralSegment( stringTemplate, &segmentCapacity, literalStart );
+
+	//Positional values must not leave gaps.
+	for ( size_t i = 0; i < stringTemplate->numberValues; i++ )
+		if ( stringTemplate->valueTypes[i] == SegmentLiteral )
+			goto malformed;
+
+	return stringTemplate;
+
+malformed:
+	wstringtemplate_delete( &stringTemplate );
+	return NULL;
+}
+
+void
+wstringtemplate_delete( WStringTemplate** stringTemplatePtr )
+{
+	if ( stringTemplatePtr == NULL or *stringTemplatePtr == NULL )
+		return;
+
+	WStringTemplate* stringTemplate = *stringTemplatePtr;
+
+	if ( stringTemplate->names ) {
+		for ( size_t i = 0; i < stringTemplate->numberValues; i++ )
+			free( stringTemplate->names[i] );
+		free( stringTemplate->names );
+	}
+	free( stringTemplate->segments );
+	free( stringTemplate->valueTypes );
+	free( stringTemplate->literals );
+	free( stringTemplate );
+	*stringTemplatePtr = NULL;
+}
+
+size_t
+wstringtemplate_countValues( const WStringTemplate* stringTemplate )
+{
+	assert( stringTemplate );
+
+	return stringTemplate->numberValues;
+}
+
+int
+wstringtemplate_index( const WStringTemplate* stringTemplate, const char* name )
+{
+	assert( stringTemplate );
+	assert( name );
+
+	if ( not stringTemplate->names )
+		return -1;
+
+	for ( size_t i = 0; i < stringTemplate->numberValues; i++ )
+		if ( strcmp( stringTemplate->names[i], name ) == 0 )
+			return (int)i;
+
+	return -1;
+}
+
+WString*
+wstring_appendTemplate( WString* string, const WStringTemplate* stringTemplate, const WStringValue values[] )
+{
+	assert( string );
+	assert( stringTemplate );
+	assert( values or stringTemplate->numberValues == 0 );
+
+	//Compute the size first: exactly for strings and integers, at most for doubles.
+	size_t sizeBytes = stringTemplate->literalSizeBytes;
+	for ( size_t i = 0; i < stringTemplate->numberSegments; i++ ) {
+		const TemplateSegment* segment = &stringTemplate->segments[i];
+		const WStringValue* value = &values[segment->index];
+
+		switch ( segment->type ) {
+		case SegmentLiteral:
+			break;
+		case SegmentCString:
+			assert( value->cstring );
+			sizeBytes += strlen( value->cstring );
+			break;
+		case SegmentString:
+			assert( value->string );
+			sizeBytes += value->string->sizeBytes - 1;
+			break;
+		case SegmentInt:
+			sizeBytes += ( value->i < 0 ) + decimalLength( value->i < 0 ? 0 - (uint64_t)value->i : (uint64_t)value->i );
+			break;
+		case SegmentUint:
+			sizeBytes += decimalLength( value->u );
+			break;
+		case SegmentDouble:
+			sizeBytes += MaxDoubleCharacters;
+			break;
+		}
+	}
+	//C string values may point into the string itself. Remember where its text was, so
+	//that they can be found again after resize().
+	uintptr_t oldText = (uintptr_t)string->cstring;
+	size_t oldLength = string->sizeBytes - 1;
+	resize( string, string->sizeBytes + sizeBytes );
+
+	char* start = &string->cstring[string->sizeBytes - 1];
+	char* current = start;
+	size_t size = stringTemplate->literalSize;
+
+	for ( size_t i = 0; i < stringTemplate->numberSegments; i++ ) {
+		const TemplateSegment* segment = &stringTemplate->segments[i];
+		const WStringValue* value = &values[segment->index];
+
+		switch ( segment->type ) {
+		case SegmentLiteral:
+			memcpy( current, &stringTemplate->literals[segment->index], segment->sizeBytes );
+			current += segment->sizeBytes;
+			break;
+		case SegmentCString:
+			if ( (uintptr_t)value->cstring >= oldText and (uintptr_t)value->cstring <= oldText + oldLength ) {
+				//Copy a part of the string itself only up to the old end, because its
+				//terminator is overwritten by now.
+				size_t offset = (uintptr_t)value->cstring - oldText;
+				size_t length = strnlen( &string->cstring[offset], oldLength - offset );
+				memmove( current, &string->cstring[offset], length );
+				size += __wutf8count( current, length );
+				current += length;
+				break;
+			}
+			for ( const char* from = value->cstring; *from; from++ ) {
+				size += ( *from & 0xC0 ) != 0x80;
+				*current++ = *from;
+			}
+			break;
+		case SegmentString:
+			memcpy( current, value->string->cstring, value->string->sizeBytes - 1 );
+			current += value->string->sizeBytes - 1;
+			size += characterCount( value->string );
+			break;
+		case SegmentInt: {
+			size_t length = 0;
+			if ( value->i < 0 )
+				current[length++] = '-';
+			length += formatUint64( &current[length], value->i < 0 ? 0 - (uint64_t)value->i : (uint64_t)value->i );
+			current += length;
+			size += length;
+			break;
+		}
+		case SegmentUint: {
+			size_t length = formatUint64( current, value->u );
+			current += length;
+			size += length;
+			break;
+		}
+		case SegmentDouble: {
+			size_t length = formatDouble( current, value->d );
+			current += length;
+			size += length;
+			break;
+		}
+		}
+	}
+
+	*current = '\0';
+	string->sizeBytes += current - start;
+	string->size += size;
+
+	assert( string );
+	return checkString( string );
+}
+
+//---------------------------------------------------------------------------------
+
+enum ReaderConfiguration {
+	ReaderDefaultCapacity	= 64 * 1024,
+};
+
+struct WStringReader {
+	int		fd;
+	char*	buffer;
+	size_t	capacity;
+	size_t	start;		//The unread bytes of the buffer are start to end
+	size_t	end;
+	bool	endOfFile;
+	int		error;		//errno of the failed read(), or 0
+};
+
+WString*
+wstring_readLine( WString* reuse, FILE* file )
+{
+	assert( file );
+
+	WString* string = reuse ? reuse : wstring_new( "", 0 );
+	wstring_clear( string );
+
+	//getdelim() grows the malloc()ed buffer of the string itself, and scans the buffer
+	//of the FILE with memchr().
+	ssize_t length = getdelim( &string->cstring, &string->capacity, '\n', file );
+	if ( length < 0 ) {
+		string->cstring[0] = '\0';
+		if ( not reuse )
+			wstring_delete( &string );
+		return NULL;
+	}
+
+	if ( length > 0 and string->cstring[length - 1] == '\n' )
+		string->cstring[--length] = '\0';
+	string->sizeBytes = length + 1;
+	string->size = __wutf8count( string->cstring, length );
+
+	assert( string );
+	return checkString( string );
+}
+
+WStringReader*
+wstringreader_new( int fd, size_t capacity )
+{
+	assert( fd >= 0 );
+
+	WStringReader* reader = __wxnew( WStringReader,
+		.fd = fd,
+		.capacity = capacity ? capacity : ReaderDefaultCapacity,
+	);
+	reader->buffer = __wxmalloc( reader->capacity );
+
+	assert( reader );
+	return reader;
+}
+
+void
+wstringreader_delete( WStringReader** readerPtr )
+{
+	if ( readerPtr == NULL or *readerPtr == NULL )
+		return;
+
+	free( (*readerPtr)->buffer );
+	free( *readerPtr );
+	*readerPtr = NULL;
+}
+
+//Refill the buffer of the reader. Return false at the end of the file or on errors,
+//which stop the reader for good.
+static bool
+fillReader( WStringReader* reader )
+{
+	if ( reader->endOfFile or reader->error )
+		return false;
+
+	ssize_t length;
+	do
+		length = read( reader->fd, reader->buffer, reader->capacity );
+	while ( length < 0 and errno == EINTR );
+
+	if ( length < 0 ) {
+		reader->error = errno;
+		return false;
+	}
+	if ( length == 0 ) {
+		reader->endOfFile = true;
+		return false;
+	}
+
+	reader->start = 0;
+	reader->end = length;
+	return true;
+}
+
+WString*
+wstring_readLineFd( WString* reuse, WStringReader* reader )
+{
+	assert( reader );
+
+	WString* string = reuse ? reuse : wstring_new( "", 0 );
+	wstring_clear( string );
+	bool found = false;
+
+	//Append the line chunk by chunk. Characters split between two chunks are counted
+	//correctly, because only their first bytes count.
+	while ( reader->start < reader->end or fillReader( reader )) {
+		const char* start = &reader->buffer[reader->start];
+		const char* newline = memchr( start, '\n', reader->end - reader->start );
+		size_t length = newline ? (size_t)( newline - start ) : reader->end - reader->start;
+
+		if ( length > 0 )
+			wstring_appendn( string, length, start );
+		reader->start += length + ( newline != NULL );
+		found = true;
+
+		if ( newline )
+			break;
+	}
+
+	//A line cut off by an error is not complete, so it is not returned.
+	if ( not found or reader->error ) {
+		if ( not reuse )
+			wstring_delete( &string );
+		errno = reader->error;
+		return NULL;
+	}
+
+	assert( string );
+	return checkString( string );
+}
+
+int
+wstringreader_error( const WStringReader* reader )
+{
+	assert( reader );
+
+	return reader->error;
+}
+
+struct WStringLines {
+	char*	bytes;		//The mapped file
+	size_t	length;
+	size_t	position;	//Byte offset of the next line
+	char	delimiter;
+};
+
+WStringLines*
+wstringlines_new( const char path[], char delimiter )
+{
+	assert( path );
+
+	//Lines are read once from front to back: The kernel may read ahead further and drop
+	//pages behind.
+	size_t length;
+	char* bytes = mapText( path, MADV_SEQUENTIAL, &length );
+	if ( not bytes ) return NULL;
+
+	WStringLines* lines = __wxnew( WStringLines,
+		.bytes = bytes,
+		.length = length,
+		.delimiter = delimiter,
+	);
+
+	assert( lines );
+	return lines;
+}
+
+void
+wstringlines_delete( WStringLines** linesPtr )
+{
+	if ( linesPtr == NULL or *linesPtr == NULL )
+		return;
+
+	unmapText( (*linesPtr)->bytes, (*linesPtr)->length + 1 );
+	free( *linesPtr );
+	*linesPtr = NULL;
+}
+
+//Return the offset of the first byte equal to value in bytes[start, length), or length.
+static size_t
+findByte( const char* bytes, size_t length, size_t start, char value )
+{
+	size_t position = start;
+	for ( ; position + 8 <= length; position += 8 ) {
+		uint64_t matches = swarEqualBytes( __wload8( &bytes[position] ), value );
+		if ( matches )
+			return position + __builtin_ctzll( matches ) / 8;
+	}
+
+	while ( position < length and bytes[position] != value )
+		position++;
+	return position;
+}
+
+bool
+wstringlines_next( WStringLines* lines, WStringView* line )
+{
+	assert( lines );
+	assert( line );
+
+	if ( lines->position >= lines->length )
+		return false;
+
+	size_t end = findByte( lines->bytes, lines->length, lines->position, lines->delimiter );
+	*line = (WStringView){ &lines->bytes[lines->position], end - lines->position };
+	lines->position = end + 1;
+
+	return true;
+}
+
+bool
+wstring_writeAll( int fd, const WString* strings[], size_t n )
+{
+	assert( fd >= 0 );
+	assert( strings or n == 0 );
+
+	struct iovec vectors[IOV_MAX];
+	size_t index = 0;	//The first string not written completely
+	size_t offset = 0;	//Bytes of that string already written
+
+	while ( index < n ) {
+		//Gather as many strings as writev() takes at once.
+		int count = 0;
+		for ( size_t i = index; i < n and count < IOV_MAX; i++ ) {
+			assert( strings[i] );
+			size_t skip = ( i == index ) ? offset : 0;
+			if ( strings[i]->sizeBytes - 1 > skip )
+				vectors[count++] = (struct iovec){ &strings[i]->cstring[skip], strings[i]->sizeBytes - 1 - skip };
+		}
+		if ( count == 0 )
+			break;
+
+		ssize_t written = writev( fd, vectors, count );
+		if ( written < 0 ) {
+			if ( errno == EINTR )
+				continue;
+			return false;
+		}
+
+		//Skip the written bytes, which may end within a string.
+		size_t remaining = written + offset;
+		while ( index < n and remaining >= strings[index]->sizeBytes - 1 ) {
+			remaining -= strings[index]->sizeBytes - 1;
+			index++;
+		}
+		offset = remaining;
+	}
+
+	return true;
 }
 
 //---------------------------------------------------------------------------------
@@ -957,8 +3670,11 @@ wstring_toDouble( const WString* string )
 static void
 resize( WString* string, size_t newCapacity )
 {
+	if ( string->capacity == 0 )
+		ownText( string, grownCapacity( string->sizeBytes, newCapacity ));
+	else
 	if ( newCapacity > string->capacity ) {
-		string->capacity = __wmax( newCapacity, string->capacity * WStringGrowthRate );
+		string->capacity = grownCapacity( string->capacity, newCapacity );
 		string->cstring = __wxrealloc( string->cstring, string->capacity );
 		string->cstring[string->capacity-1] = 0;
 	}
@@ -966,91 +3682,1425 @@ resize( WString* string, size_t newCapacity )
 //	checkString( string );
 }
 
-static uint32_t
-utf8NextChar( char** strPtr )
+//Return the size of the mapping for a mapped string of sizeBytes bytes.
+static size_t
+mappedSize( size_t sizeBytes )
 {
-	assert( strPtr );
-	assert( *strPtr );
-	const unsigned char* str = *(const unsigned char**)strPtr;
-
-	uint32_t result;
-	if (( *str & 0xf8) == 0xf0 ) {
-		result = (str[0] << 24) + (str[1] << 16) + (str[2] << 8) + str[3];
-		*strPtr += 4;
-	}
-	if (( *str & 0xf0 ) == 0xe0 ) {
-		result = (str[0] << 16) + (str[1] << 8) + str[2];
-		*strPtr += 3;
-	}
-	if (( *str & 0xe0 ) == 0xc0 ) {
-		result = (str[0] << 8) + str[1];
-		*strPtr += 2;
-	}
-	else {
-		result = str[0];
-		*strPtr += 1;
-	}
+	size_t pageSize = sysconf( _SC_PAGESIZE );
+	return ( sizeBytes + pageSize - 1 ) / pageSize * pageSize;
+}
 
-	return result;
+static void
+unmapText( char* bytes, size_t sizeBytes )
+{
+	munmap( bytes, mappedSize( sizeBytes ));
 }
 
-static bool
-utf8MoreChars( const char* str )
+//Copy the text of a mapped string into a heap buffer of at least the given capacity and
+//release the mapping. Strings on the heap are left as they are.
+static void
+ownText( WString* string, size_t capacity )
 {
-	assert( str );
+	if ( string->capacity > 0 )
+		return;
+
+	characterCount( string );
+	capacity = __wmax( capacity, string->sizeBytes );
+	char* bytes = __wxmalloc( capacity );
+	memcpy( bytes, string->cstring, string->sizeBytes );
+	bytes[capacity - 1] = '\0';
 
-	if ( *str ) return true;
-	else return false;
+	unmapText( string->cstring, string->sizeBytes );
+	string->cstring = bytes;
+	string->capacity = capacity;
 }
 
-//Taken from Github, UTF8.h (Public Domain), then modified
+//Round up to one of 4 size classes per power of two, like many allocators use, or to
+//whole pages for big sizes.
 static size_t
-utf8len( const char* str )
-{
-  const unsigned char* s = (const unsigned char* )str;
-  size_t length = 0;
-
-  while ('\0' != *s) {
-    if (0xf0 == (0xf8 & *s)) {
-      // 4-byte utf8 code point (began with 0b11110xxx)
-      s += 4;
-    } else if (0xe0 == (0xf0 & *s)) {
-      // 3-byte utf8 code point (began with 0b1110xxxx)
-      s += 3;
-    } else if (0xc0 == (0xe0 & *s)) {
-      // 2-byte utf8 code point (began with 0b110xxxxx)
-      s += 2;
-    } else { // if (0x00 == (0x80 & *s)) {
-      // 1-byte ascii (began with 0b0xxxxxxx)
-      s += 1;
-    }
+roundToSizeClass( size_t size )
+{
+	if ( size <= SmallestSizeClass )
+		return SmallestSizeClass;
+
+	size_t step = ( (size_t)1 << ( 63 - __builtin_clzll( size - 1 ))) / 4;
+	step = __wmin( __wmax( step, SmallestSizeClass ), LargestSizeClassStep );
+	return ( size + step - 1 ) & ~( step - 1 );
+}
 
-    // no matter the bytes we marched s forward by, it was
-    // only 1 utf8 codepoint
-    length++;
-  }
+//Return the capacity after growing for at least needed bytes, following the growth policy.
+static size_t
+grownCapacity( size_t capacity, size_t needed )
+{
+	size_t grown = capacity * growthPolicy.factor;
+	if ( growthPolicy.maximumGrowth > 0 and grown > capacity + growthPolicy.maximumGrowth )
+		grown = capacity + growthPolicy.maximumGrowth;
 
-  return length;
+	grown = __wmax( grown, needed );
+	return growthPolicy.sizeClasses ? roundToSizeClass( grown ) : grown;
 }
 
-/*Algorithm taken from the Github account from Stephen Mathieson, then modified.
-*/
+//Count the non-overlapping matches of search in a byte range.
 static size_t
-occurrences( const char *string, const char *search )
+occurrences( const char* bytes, size_t length, const char* search, size_t searchLength )
 {
-	assert( string );
+	assert( bytes );
 	assert( search );
+	assert( searchLength > 0 );
 
-	const char *selfPosition = string;
+	const char* end = &bytes[length];
+	const char* match;
 	size_t count = 0;
-	size_t searchLength = strlen( search );
 
-	while ( ( selfPosition = strstr( selfPosition, search ) ) ) {
-		selfPosition += searchLength;
+	while (( match = memmem( bytes, end - bytes, search, searchLength ))) {
+		bytes = match + searchLength;
 		count++;
 	}
 
 	return count;
 }
 
+//Compare two byte ranges like strcmp(), a shorter range first if it is a prefix of the other.
+static int
+compareBytes( const char* bytes, size_t length, const char* other, size_t otherLength )
+{
+	int result = memcmp( bytes, other, __wmin( length, otherLength ));
+	if ( result != 0 )
+		return result;
+
+	return ( length > otherLength ) - ( length < otherLength );
+}
+
+//---------------------------------------------------------------------------------
+
+static const uint64_t powersOfFive[2 * ( LargestPowerOfTen - SmallestPowerOfFive + 1 )] = {
+	0xeef453d6923bd65a, 0x113faa2906a13b3f,	//5^-342
+	0x9558b4661b6565f8, 0x4ac7ca59a424c507,	//5^-341
+	0xbaaee17fa23ebf76, 0x5d79bcf00d2df649,	//5^-340
+	0xe95a99df8ace6f53, 0xf4d82c2c107973dc,	//5^-339
+	0x91d8a02bb6c10594, 0x79071b9b8a4be869,	//5^-338
+	0xb64ec836a47146f9, 0x9748e2826cdee284,	//5^-337
+	0xe3e27a444d8d98b7, 0xfd1b1b2308169b25,	//5^-336
+	0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f7,	//5^-335
+	0xb208ef855c969f4f, 0xbdbd2d335e51a935,	//5^-334
+	0xde8b2b66b3bc4723, 0xad2c788035e61382,	//5^-333
+	0x8b16fb203055ac76, 0x4c3bcb5021afcc31,	//5^-332
+	0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3d,	//5^-331
+	0xd953e8624b85dd78, 0xd71d6dad34a2af0d,	//5^-330
+	0x87d4713d6f33aa6b, 0x8672648c40e5ad68,	//5^-329
+	0xa9c98d8ccb009506, 0x680efdaf511f18c2,	//5^-328
+	0xd43bf0effdc0ba48, 0x0212bd1b2566def2,	//5^-327
+	0x84a57695fe98746d, 0x014bb630f7604b57,	//5^-326
+	0xa5ced43b7e3e9188, 0x419ea3bd35385e2d,	//5^-325
+	0xcf42894a5dce35ea, 0x52064cac828675b9,	//5^-324
+	0x818995ce7aa0e1b2, 0x7343efebd1940993,	//5^-323
+	0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf8,	//5^-322
+	0xca66fa129f9b60a6, 0xd41a26e077774ef6,	//5^-321
+	0xfd00b897478238d0, 0x8920b098955522b4,	//5^-320
+	0x9e20735e8cb16382, 0x55b46e5f5d5535b0,	//5^-319
+	0xc5a890362fddbc62, 0xeb2189f734aa831d,	//5^-318
+	0xf712b443bbd52b7b, 0xa5e9ec7501d523e4,	//5^-317
+	0x9a6bb0aa55653b2d, 0x47b233c92125366e,	//5^-316
+	0xc1069cd4eabe89f8, 0x999ec0bb696e840a,	//5^-315
+	0xf148440a256e2c76, 0xc00670ea43ca250d,	//5^-314
+	0x96cd2a865764dbca, 0x380406926a5e5728,	//5^-313
+	0xbc807527ed3e12bc, 0xc605083704f5ecf2,	//5^-312
+	0xeba09271e88d976b, 0xf7864a44c633682e,	//5^-311
+	0x93445b8731587ea3, 0x7ab3ee6afbe0211d,	//5^-310
+	0xb8157268fdae9e4c, 0x5960ea05bad82964,	//5^-309
+	0xe61acf033d1a45df, 0x6fb92487298e33bd,	//5^-308
+	0x8fd0c16206306bab, 0xa5d3b6d479f8e056,	//5^-307
+	0xb3c4f1ba87bc8696, 0x8f48a4899877186c,	//5^-306
+	0xe0b62e2929aba83c, 0x331acdabfe94de87,	//5^-305
+	0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14,	//5^-304
+	0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dd9,	//5^-303
+	0xdb71e91432b1a24a, 0xc9e82cd9f69d6150,	//5^-302
+	0x892731ac9faf056e, 0xbe311c083a225cd2,	//5^-301
+	0xab70fe17c79ac6ca, 0x6dbd630a48aaf406,	//5^-300
+	0xd64d3d9db981787d, 0x092cbbccdad5b108,	//5^-299
+	0x85f0468293f0eb4e, 0x25bbf56008c58ea5,	//5^-298
+	0xa76c582338ed2621, 0xaf2af2b80af6f24e,	//5^-297
+	0xd1476e2c07286faa, 0x1af5af660db4aee1,	//5^-296
+	0x82cca4db847945ca, 0x50d98d9fc890ed4d,	//5^-295
+	0xa37fce126597973c, 0xe50ff107bab528a0,	//5^-294
+	0xcc5fc196fefd7d0c, 0x1e53ed49a96272c8,	//5^-293
+	0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7a,	//5^-292
+	0x9faacf3df73609b1, 0x77b191618c54e9ac,	//5^-291
+	0xc795830d75038c1d, 0xd59df5b9ef6a2417,	//5^-290
+	0xf97ae3d0d2446f25, 0x4b0573286b44ad1d,	//5^-289
+	0x9becce62836ac577, 0x4ee367f9430aec32,	//5^-288
+	0xc2e801fb244576d5, 0x229c41f793cda73f,	//5^-287
+	0xf3a20279ed56d48a, 0x6b43527578c1110f,	//5^-286
+	0x9845418c345644d6, 0x830a13896b78aaa9,	//5^-285
+	0xbe5691ef416bd60c, 0x23cc986bc656d553,	//5^-284
+	0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa8,	//5^-283
+	0x94b3a202eb1c3f39, 0x7bf7d71432f3d6a9,	//5^-282
+	0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc53,	//5^-281
+	0xe858ad248f5c22c9, 0xd1b3400f8f9cff68,	//5^-280
+	0x91376c36d99995be, 0x23100809b9c21fa1,	//5^-279
+	0xb58547448ffffb2d, 0xabd40a0c2832a78a,	//5^-278
+	0xe2e69915b3fff9f9, 0x16c90c8f323f516c,	//5^-277
+	0x8dd01fad907ffc3b, 0xae3da7d97f6792e3,	//5^-276
+	0xb1442798f49ffb4a, 0x99cd11cfdf41779c,	//5^-275
+	0xdd95317f31c7fa1d, 0x40405643d711d583,	//5^-274
+	0x8a7d3eef7f1cfc52, 0x482835ea666b2572,	//5^-273
+	0xad1c8eab5ee43b66, 0xda3243650005eecf,	//5^-272
+	0xd863b256369d4a40, 0x90bed43e40076a82,	//5^-271
+	0x873e4f75e2224e68, 0x5a7744a6e804a291,	//5^-270
+	0xa90de3535aaae202, 0x711515d0a205cb36,	//5^-269
+	0xd3515c2831559a83, 0x0d5a5b44ca873e03,	//5^-268
+	0x8412d9991ed58091, 0xe858790afe9486c2,	//5^-267
+	0xa5178fff668ae0b6, 0x626e974dbe39a872,	//5^-266
+	0xce5d73ff402d98e3, 0xfb0a3d212dc8128f,	//5^-265
+	0x80fa687f881c7f8e, 0x7ce66634bc9d0b99,	//5^-264
+	0xa139029f6a239f72, 0x1c1fffc1ebc44e80,	//5^-263
+	0xc987434744ac874e, 0xa327ffb266b56220,	//5^-262
+	0xfbe9141915d7a922, 0x4bf1ff9f0062baa8,	//5^-261
+	0x9d71ac8fada6c9b5, 0x6f773fc3603db4a9,	//5^-260
+	0xc4ce17b399107c22, 0xcb550fb4384d21d3,	//5^-259
+	0xf6019da07f549b2b, 0x7e2a53a146606a48,	//5^-258
+	0x99c102844f94e0fb, 0x2eda7444cbfc426d,	//5^-257
+	0xc0314325637a1939, 0xfa911155fefb5308,	//5^-256
+	0xf03d93eebc589f88, 0x793555ab7eba27ca,	//5^-255
+	0x96267c7535b763b5, 0x4bc1558b2f3458de,	//5^-254
+	0xbbb01b9283253ca2, 0x9eb1aaedfb016f16,	//5^-253
+	0xea9c227723ee8bcb, 0x465e15a979c1cadc,	//5^-252
+	0x92a1958a7675175f, 0x0bfacd89ec191ec9,	//5^-251
+	0xb749faed14125d36, 0xcef980ec671f667b,	//5^-250
+	0xe51c79a85916f484, 0x82b7e12780e7401a,	//5^-249
+	0x8f31cc0937ae58d2, 0xd1b2ecb8b0908810,	//5^-248
+	0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15,	//5^-247
+	0xdfbdcece67006ac9, 0x67a791e093e1d49a,	//5^-246
+	0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e0,	//5^-245
+	0xaecc49914078536d, 0x58fae9f773886e18,	//5^-244
+	0xda7f5bf590966848, 0xaf39a475506a899e,	//5^-243
+	0x888f99797a5e012d, 0x6d8406c952429603,	//5^-242
+	0xaab37fd7d8f58178, 0xc8e5087ba6d33b83,	//5^-241
+	0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a64,	//5^-240
+	0x855c3be0a17fcd26, 0x5cf2eea09a55067f,	//5^-239
+	0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481e,	//5^-238
+	0xd0601d8efc57b08b, 0xf13b94daf124da26,	//5^-237
+	0x823c12795db6ce57, 0x76c53d08d6b70858,	//5^-236
+	0xa2cb1717b52481ed, 0x54768c4b0c64ca6e,	//5^-235
+	0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09,	//5^-234
+	0xfe5d54150b090b02, 0xd3f93b35435d7c4c,	//5^-233
+	0x9efa548d26e5a6e1, 0xc47bc5014a1a6daf,	//5^-232
+	0xc6b8e9b0709f109a, 0x359ab6419ca1091b,	//5^-231
+	0xf867241c8cc6d4c0, 0xc30163d203c94b62,	//5^-230
+	0x9b407691d7fc44f8, 0x79e0de63425dcf1d,	//5^-229
+	0xc21094364dfb5636, 0x985915fc12f542e4,	//5^-228
+	0xf294b943e17a2bc4, 0x3e6f5b7b17b2939d,	//5^-227
+	0x979cf3ca6cec5b5a, 0xa705992ceecf9c42,	//5^-226
+	0xbd8430bd08277231, 0x50c6ff782a838353,	//5^-225
+	0xece53cec4a314ebd, 0xa4f8bf5635246428,	//5^-224
+	0x940f4613ae5ed136, 0x871b7795e136be99,	//5^-223
+	0xb913179899f68584, 0x28e2557b59846e3f,	//5^-222
+	0xe757dd7ec07426e5, 0x331aeada2fe589cf,	//5^-221
+	0x9096ea6f3848984f, 0x3ff0d2c85def7621,	//5^-220
+	0xb4bca50b065abe63, 0x0fed077a756b53a9,	//5^-219
+	0xe1ebce4dc7f16dfb, 0xd3e8495912c62894,	//5^-218
+	0x8d3360f09cf6e4bd, 0x64712dd7abbbd95c,	//5^-217
+	0xb080392cc4349dec, 0xbd8d794d96aacfb3,	//5^-216
+	0xdca04777f541c567, 0xecf0d7a0fc5583a0,	//5^-215
+	0x89e42caaf9491b60, 0xf41686c49db57244,	//5^-214
+	0xac5d37d5b79b6239, 0x311c2875c522ced5,	//5^-213
+	0xd77485cb25823ac7, 0x7d633293366b828b,	//5^-212
+	0x86a8d39ef77164bc, 0xae5dff9c02033197,	//5^-211
+	0xa8530886b54dbdeb, 0xd9f57f830283fdfc,	//5^-210
+	0xd267caa862a12d66, 0xd072df63c324fd7b,	//5^-209
+	0x8380dea93da4bc60, 0x4247cb9e59f71e6d,	//5^-208
+	0xa46116538d0deb78, 0x52d9be85f074e608,	//5^-207
+	0xcd795be870516656, 0x67902e276c921f8b,	//5^-206
+	0x806bd9714632dff6, 0x00ba1cd8a3db53b6,	//5^-205
+	0xa086cfcd97bf97f3, 0x80e8a40eccd228a4,	//5^-204
+	0xc8a883c0fdaf7df0, 0x6122cd128006b2cd,	//5^-203
+	0xfad2a4b13d1b5d6c, 0x796b805720085f81,	//5^-202
+	0x9cc3a6eec6311a63, 0xcbe3303674053bb0,	//5^-201
+	0xc3f490aa77bd60fc, 0xbedbfc4411068a9c,	//5^-200
+	0xf4f1b4d515acb93b, 0xee92fb5515482d44,	//5^-199
+	0x991711052d8bf3c5, 0x751bdd152d4d1c4a,	//5^-198
+	0xbf5cd54678eef0b6, 0xd262d45a78a0635d,	//5^-197
+	0xef340a98172aace4, 0x86fb897116c87c34,	//5^-196
+	0x9580869f0e7aac0e, 0xd45d35e6ae3d4da0,	//5^-195
+	0xbae0a846d2195712, 0x8974836059cca109,	//5^-194
+	0xe998d258869facd7, 0x2bd1a438703fc94b,	//5^-193
+	0x91ff83775423cc06, 0x7b6306a34627ddcf,	//5^-192
+	0xb67f6455292cbf08, 0x1a3bc84c17b1d542,	//5^-191
+	0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93,	//5^-190
+	0x8e938662882af53e, 0x547eb47b7282ee9c,	//5^-189
+	0xb23867fb2a35b28d, 0xe99e619a4f23aa43,	//5^-188
+	0xdec681f9f4c31f31, 0x6405fa00e2ec94d4,	//5^-187
+	0x8b3c113c38f9f37e, 0xde83bc408dd3dd04,	//5^-186
+	0xae0b158b4738705e, 0x9624ab50b148d445,	//5^-185
+	0xd98ddaee19068c76, 0x3badd624dd9b0957,	//5^-184
+	0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d6,	//5^-183
+	0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4c,	//5^-182
+	0xd47487cc8470652b, 0x7647c3200069671f,	//5^-181
+	0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073,	//5^-180
+	0xa5fb0a17c777cf09, 0xf468107100525890,	//5^-179
+	0xcf79cc9db955c2cc, 0x7182148d4066eeb4,	//5^-178
+	0x81ac1fe293d599bf, 0xc6f14cd848405530,	//5^-177
+	0xa21727db38cb002f, 0xb8ada00e5a506a7c,	//5^-176
+	0xca9cf1d206fdc03b, 0xa6d90811f0e4851c,	//5^-175
+	0xfd442e4688bd304a, 0x908f4a166d1da663,	//5^-174
+	0x9e4a9cec15763e2e, 0x9a598e4e043287fe,	//5^-173
+	0xc5dd44271ad3cdba, 0x40eff1e1853f29fd,	//5^-172
+	0xf7549530e188c128, 0xd12bee59e68ef47c,	//5^-171
+	0x9a94dd3e8cf578b9, 0x82bb74f8301958ce,	//5^-170
+	0xc13a148e3032d6e7, 0xe36a52363c1faf01,	//5^-169
+	0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac1,	//5^-168
+	0x96f5600f15a7b7e5, 0x29ab103a5ef8c0b9,	//5^-167
+	0xbcb2b812db11a5de, 0x7415d448f6b6f0e7,	//5^-166
+	0xebdf661791d60f56, 0x111b495b3464ad21,	//5^-165
+	0x936b9fcebb25c995, 0xcab10dd900beec34,	//5^-164
+	0xb84687c269ef3bfb, 0x3d5d514f40eea742,	//5^-163
+	0xe65829b3046b0afa, 0x0cb4a5a3112a5112,	//5^-162
+	0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ab,	//5^-161
+	0xb3f4e093db73a093, 0x59ed216765690f56,	//5^-160
+	0xe0f218b8d25088b8, 0x306869c13ec3532c,	//5^-159
+	0x8c974f7383725573, 0x1e414218c73a13fb,	//5^-158
+	0xafbd2350644eeacf, 0xe5d1929ef90898fa,	//5^-157
+	0xdbac6c247d62a583, 0xdf45f746b74abf39,	//5^-156
+	0x894bc396ce5da772, 0x6b8bba8c328eb783,	//5^-155
+	0xab9eb47c81f5114f, 0x066ea92f3f326564,	//5^-154
+	0xd686619ba27255a2, 0xc80a537b0efefebd,	//5^-153
+	0x8613fd0145877585, 0xbd06742ce95f5f36,	//5^-152
+	0xa798fc4196e952e7, 0x2c48113823b73704,	//5^-151
+	0xd17f3b51fca3a7a0, 0xf75a15862ca504c5,	//5^-150
+	0x82ef85133de648c4, 0x9a984d73dbe722fb,	//5^-149
+	0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebba,	//5^-148
+	0xcc963fee10b7d1b3, 0x318df905079926a8,	//5^-147
+	0xffbbcfe994e5c61f, 0xfdf17746497f7052,	//5^-146
+	0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa633,	//5^-145
+	0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc0,	//5^-144
+	0xf9bd690a1b68637b, 0x3dfdce7aa3c673b0,	//5^-143
+	0x9c1661a651213e2d, 0x06bea10ca65c084e,	//5^-142
+	0xc31bfa0fe5698db8, 0x486e494fcff30a62,	//5^-141
+	0xf3e2f893dec3f126, 0x5a89dba3c3efccfa,	//5^-140
+	0x986ddb5c6b3a76b7, 0xf89629465a75e01c,	//5^-139
+	0xbe89523386091465, 0xf6bbb397f1135823,	//5^-138
+	0xee2ba6c0678b597f, 0x746aa07ded582e2c,	//5^-137
+	0x94db483840b717ef, 0xa8c2a44eb4571cdc,	//5^-136
+	0xba121a4650e4ddeb, 0x92f34d62616ce413,	//5^-135
+	0xe896a0d7e51e1566, 0x77b020baf9c81d17,	//5^-134
+	0x915e2486ef32cd60, 0x0ace1474dc1d122e,	//5^-133
+	0xb5b5ada8aaff80b8, 0x0d819992132456ba,	//5^-132
+	0xe3231912d5bf60e6, 0x10e1fff697ed6c69,	//5^-131
+	0x8df5efabc5979c8f, 0xca8d3ffa1ef463c1,	//5^-130
+	0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb2,	//5^-129
+	0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde,	//5^-128
+	0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b,	//5^-127
+	0xad4ab7112eb3929d, 0x86c16c98d2c953c6,	//5^-126
+	0xd89d64d57a607744, 0xe871c7bf077ba8b7,	//5^-125
+	0x87625f056c7c4a8b, 0x11471cd764ad4972,	//5^-124
+	0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf,	//5^-123
+	0xd389b47879823479, 0x4aff1d108d4ec2c3,	//5^-122
+	0x843610cb4bf160cb, 0xcedf722a585139ba,	//5^-121
+	0xa54394fe1eedb8fe, 0xc2974eb4ee658828,	//5^-120
+	0xce947a3da6a9273e, 0x733d226229feea32,	//5^-119
+	0x811ccc668829b887, 0x0806357d5a3f525f,	//5^-118
+	0xa163ff802a3426a8, 0xca07c2dcb0cf26f7,	//5^-117
+	0xc9bcff6034c13052, 0xfc89b393dd02f0b5,	//5^-116
+	0xfc2c3f3841f17c67, 0xbbac2078d443ace2,	//5^-115
+	0x9d9ba7832936edc0, 0xd54b944b84aa4c0d,	//5^-114
+	0xc5029163f384a931, 0x0a9e795e65d4df11,	//5^-113
+	0xf64335bcf065d37d, 0x4d4617b5ff4a16d5,	//5^-112
+	0x99ea0196163fa42e, 0x504bced1bf8e4e45,	//5^-111
+	0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6,	//5^-110
+	0xf07da27a82c37088, 0x5d767327bb4e5a4c,	//5^-109
+	0x964e858c91ba2655, 0x3a6a07f8d510f86f,	//5^-108
+	0xbbe226efb628afea, 0x890489f70a55368b,	//5^-107
+	0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e,	//5^-106
+	0x92c8ae6b464fc96f, 0x3b0b8bc90012929d,	//5^-105
+	0xb77ada0617e3bbcb, 0x09ce6ebb40173744,	//5^-104
+	0xe55990879ddcaabd, 0xcc420a6a101d0515,	//5^-103
+	0x8f57fa54c2a9eab6, 0x9fa946824a12232d,	//5^-102
+	0xb32df8e9f3546564, 0x47939822dc96abf9,	//5^-101
+	0xdff9772470297ebd, 0x59787e2b93bc56f7,	//5^-100
+	0x8bfbea76c619ef36, 0x57eb4edb3c55b65a,	//5^-99
+	0xaefae51477a06b03, 0xede622920b6b23f1,	//5^-98
+	0xdab99e59958885c4, 0xe95fab368e45eced,	//5^-97
+	0x88b402f7fd75539b, 0x11dbcb0218ebb414,	//5^-96
+	0xaae103b5fcd2a881, 0xd652bdc29f26a119,	//5^-95
+	0xd59944a37c0752a2, 0x4be76d3346f0495f,	//5^-94
+	0x857fcae62d8493a5, 0x6f70a4400c562ddb,	//5^-93
+	0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952,	//5^-92
+	0xd097ad07a71f26b2, 0x7e2000a41346a7a7,	//5^-91
+	0x825ecc24c873782f, 0x8ed400668c0c28c8,	//5^-90
+	0xa2f67f2dfa90563b, 0x728900802f0f32fa,	//5^-89
+	0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9,	//5^-88
+	0xfea126b7d78186bc, 0xe2f610c84987bfa8,	//5^-87
+	0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9,	//5^-86
+	0xc6ede63fa05d3143, 0x91503d1c79720dbb,	//5^-85
+	0xf8a95fcf88747d94, 0x75a44c6397ce912a,	//5^-84
+	0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba,	//5^-83
+	0xc24452da229b021b, 0xfbe85badce996168,	//5^-82
+	0xf2d56790ab41c2a2, 0xfae27299423fb9c3,	//5^-81
+	0x97c560ba6b0919a5, 0xdccd879fc967d41a,	//5^-80
+	0xbdb6b8e905cb600f, 0x5400e987bbc1c920,	//5^-79
+	0xed246723473e3813, 0x290123e9aab23b68,	//5^-78
+	0x9436c0760c86e30b, 0xf9a0b6720aaf6521,	//5^-77
+	0xb94470938fa89bce, 0xf808e40e8d5b3e69,	//5^-76
+	0xe7958cb87392c2c2, 0xb60b1d1230b20e04,	//5^-75
+	0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2,	//5^-74
+	0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3,	//5^-73
+	0xe2280b6c20dd5232, 0x25c6da63c38de1b0,	//5^-72
+	0x8d590723948a535f, 0x579c487e5a38ad0e,	//5^-71
+	0xb0af48ec79ace837, 0x2d835a9df0c6d851,	//5^-70
+	0xdcdb1b2798182244, 0xf8e431456cf88e65,	//5^-69
+	0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff,	//5^-68
+	0xac8b2d36eed2dac5, 0xe272467e3d222f3f,	//5^-67
+	0xd7adf884aa879177, 0x5b0ed81dcc6abb0f,	//5^-66
+	0x86ccbb52ea94baea, 0x98e947129fc2b4e9,	//5^-65
+	0xa87fea27a539e9a5, 0x3f2398d747b36224,	//5^-64
+	0xd29fe4b18e88640e, 0x8eec7f0d19a03aad,	//5^-63
+	0x83a3eeeef9153e89, 0x1953cf68300424ac,	//5^-62
+	0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7,	//5^-61
+	0xcdb02555653131b6, 0x3792f412cb06794d,	//5^-60
+	0x808e17555f3ebf11, 0xe2bbd88bbee40bd0,	//5^-59
+	0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4,	//5^-58
+	0xc8de047564d20a8b, 0xf245825a5a445275,	//5^-57
+	0xfb158592be068d2e, 0xeed6e2f0f0d56712,	//5^-56
+	0x9ced737bb6c4183d, 0x55464dd69685606b,	//5^-55
+	0xc428d05aa4751e4c, 0xaa97e14c3c26b886,	//5^-54
+	0xf53304714d9265df, 0xd53dd99f4b3066a8,	//5^-53
+	0x993fe2c6d07b7fab, 0xe546a8038efe4029,	//5^-52
+	0xbf8fdb78849a5f96, 0xde98520472bdd033,	//5^-51
+	0xef73d256a5c0f77c, 0x963e66858f6d4440,	//5^-50
+	0x95a8637627989aad, 0xdde7001379a44aa8,	//5^-49
+	0xbb127c53b17ec159, 0x5560c018580d5d52,	//5^-48
+	0xe9d71b689dde71af, 0xaab8f01e6e10b4a6,	//5^-47
+	0x9226712162ab070d, 0xcab3961304ca70e8,	//5^-46
+	0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22,	//5^-45
+	0xe45c10c42a2b3b05, 0x8cb89a7db77c506a,	//5^-44
+	0x8eb98a7a9a5b04e3, 0x77f3608e92adb242,	//5^-43
+	0xb267ed1940f1c61c, 0x55f038b237591ed3,	//5^-42
+	0xdf01e85f912e37a3, 0x6b6c46dec52f6688,	//5^-41
+	0x8b61313bbabce2c6, 0x2323ac4b3b3da015,	//5^-40
+	0xae397d8aa96c1b77, 0xabec975e0a0d081a,	//5^-39
+	0xd9c7dced53c72255, 0x96e7bd358c904a21,	//5^-38
+	0x881cea14545c7575, 0x7e50d64177da2e54,	//5^-37
+	0xaa242499697392d2, 0xdde50bd1d5d0b9e9,	//5^-36
+	0xd4ad2dbfc3d07787, 0x955e4ec64b44e864,	//5^-35
+	0x84ec3c97da624ab4, 0xbd5af13bef0b113e,	//5^-34
+	0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e,	//5^-33
+	0xcfb11ead453994ba, 0x67de18eda5814af2,	//5^-32
+	0x81ceb32c4b43fcf4, 0x80eacf948770ced7,	//5^-31
+	0xa2425ff75e14fc31, 0xa1258379a94d028d,	//5^-30
+	0xcad2f7f5359a3b3e, 0x096ee45813a04330,	//5^-29
+	0xfd87b5f28300ca0d, 0x8bca9d6e188853fc,	//5^-28
+	0x9e74d1b791e07e48, 0x775ea264cf55347e,	//5^-27
+	0xc612062576589dda, 0x95364afe032a819e,	//5^-26
+	0xf79687aed3eec551, 0x3a83ddbd83f52205,	//5^-25
+	0x9abe14cd44753b52, 0xc4926a9672793543,	//5^-24
+	0xc16d9a0095928a27, 0x75b7053c0f178294,	//5^-23
+	0xf1c90080baf72cb1, 0x5324c68b12dd6339,	//5^-22
+	0x971da05074da7bee, 0xd3f6fc16ebca5e04,	//5^-21
+	0xbce5086492111aea, 0x88f4bb1ca6bcf585,	//5^-20
+	0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6,	//5^-19
+	0x9392ee8e921d5d07, 0x3aff322e62439fd0,	//5^-18
+	0xb877aa3236a4b449, 0x09befeb9fad487c3,	//5^-17
+	0xe69594bec44de15b, 0x4c2ebe687989a9b4,	//5^-16
+	0x901d7cf73ab0acd9, 0x0f9d37014bf60a11,	//5^-15
+	0xb424dc35095cd80f, 0x538484c19ef38c95,	//5^-14
+	0xe12e13424bb40e13, 0x2865a5f206b06fba,	//5^-13
+	0x8cbccc096f5088cb, 0xf93f87b7442e45d4,	//5^-12
+	0xafebff0bcb24aafe, 0xf78f69a51539d749,	//5^-11
+	0xdbe6fecebdedd5be, 0xb573440e5a884d1c,	//5^-10
+	0x89705f4136b4a597, 0x31680a88f8953031,	//5^-9
+	0xabcc77118461cefc, 0xfdc20d2b36ba7c3e,	//5^-8
+	0xd6bf94d5e57a42bc, 0x3d32907604691b4d,	//5^-7
+	0x8637bd05af6c69b5, 0xa63f9a49c2c1b110,	//5^-6
+	0xa7c5ac471b478423, 0x0fcf80dc33721d54,	//5^-5
+	0xd1b71758e219652b, 0xd3c36113404ea4a9,	//5^-4
+	0x83126e978d4fdf3b, 0x645a1cac083126ea,	//5^-3
+	0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4,	//5^-2
+	0xcccccccccccccccc, 0xcccccccccccccccd,	//5^-1
+	0x8000000000000000, 0x0000000000000000,	//5^0
+	0xa000000000000000, 0x0000000000000000,	//5^1
+	0xc800000000000000, 0x0000000000000000,	//5^2
+	0xfa00000000000000, 0x0000000000000000,	//5^3
+	0x9c40000000000000, 0x0000000000000000,	//5^4
+	0xc350000000000000, 0x0000000000000000,	//5^5
+	0xf424000000000000, 0x0000000000000000,	//5^6
+	0x9896800000000000, 0x0000000000000000,	//5^7
+	0xbebc200000000000, 0x0000000000000000,	//5^8
+	0xee6b280000000000, 0x0000000000000000,	//5^9
+	0x9502f90000000000, 0x0000000000000000,	//5^10
+	0xba43b74000000000, 0x0000000000000000,	//5^11
+	0xe8d4a51000000000, 0x0000000000000000,	//5^12
+	0x9184e72a00000000, 0x0000000000000000,	//5^13
+	0xb5e620f480000000, 0x0000000000000000,	//5^14
+	0xe35fa931a0000000, 0x0000000000000000,	//5^15
+	0x8e1bc9bf04000000, 0x0000000000000000,	//5^16
+	0xb1a2bc2ec5000000, 0x0000000000000000,	//5^17
+	0xde0b6b3a76400000, 0x0000000000000000,	//5^18
+	0x8ac7230489e80000, 0x0000000000000000,	//5^19
+	0xad78ebc5ac620000, 0x0000000000000000,	//5^20
+	0xd8d726b7177a8000, 0x0000000000000000,	//5^21
+	0x878678326eac9000, 0x0000000000000000,	//5^22
+	0xa968163f0a57b400, 0x0000000000000000,	//5^23
+	0xd3c21bcecceda100, 0x0000000000000000,	//5^24
+	0x84595161401484a0, 0x0000000000000000,	//5^25
+	0xa56fa5b99019a5c8, 0x0000000000000000,	//5^26
+	0xcecb8f27f4200f3a, 0x0000000000000000,	//5^27
+	0x813f3978f8940984, 0x4000000000000000,	//5^28
+	0xa18f07d736b90be5, 0x5000000000000000,	//5^29
+	0xc9f2c9cd04674ede, 0xa400000000000000,	//5^30
+	0xfc6f7c4045812296, 0x4d00000000000000,	//5^31
+	0x9dc5ada82b70b59d, 0xf020000000000000,	//5^32
+	0xc5371912364ce305, 0x6c28000000000000,	//5^33
+	0xf684df56c3e01bc6, 0xc732000000000000,	//5^34
+	0x9a130b963a6c115c, 0x3c7f400000000000,	//5^35
+	0xc097ce7bc90715b3, 0x4b9f100000000000,	//5^36
+	0xf0bdc21abb48db20, 0x1e86d40000000000,	//5^37
+	0x96769950b50d88f4, 0x1314448000000000,	//5^38
+	0xbc143fa4e250eb31, 0x17d955a000000000,	//5^39
+	0xeb194f8e1ae525fd, 0x5dcfab0800000000,	//5^40
+	0x92efd1b8d0cf37be, 0x5aa1cae500000000,	//5^41
+	0xb7abc627050305ad, 0xf14a3d9e40000000,	//5^42
+	0xe596b7b0c643c719, 0x6d9ccd05d0000000,	//5^43
+	0x8f7e32ce7bea5c6f, 0xe4820023a2000000,	//5^44
+	0xb35dbf821ae4f38b, 0xdda2802c8a800000,	//5^45
+	0xe0352f62a19e306e, 0xd50b2037ad200000,	//5^46
+	0x8c213d9da502de45, 0x4526f422cc340000,	//5^47
+	0xaf298d050e4395d6, 0x9670b12b7f410000,	//5^48
+	0xdaf3f04651d47b4c, 0x3c0cdd765f114000,	//5^49
+	0x88d8762bf324cd0f, 0xa5880a69fb6ac800,	//5^50
+	0xab0e93b6efee0053, 0x8eea0d047a457a00,	//5^51
+	0xd5d238a4abe98068, 0x72a4904598d6d880,	//5^52
+	0x85a36366eb71f041, 0x47a6da2b7f864750,	//5^53
+	0xa70c3c40a64e6c51, 0x999090b65f67d924,	//5^54
+	0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d,	//5^55
+	0x82818f1281ed449f, 0xbff8f10e7a8921a4,	//5^56
+	0xa321f2d7226895c7, 0xaff72d52192b6a0d,	//5^57
+	0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490,	//5^58
+	0xfee50b7025c36a08, 0x02f236d04753d5b4,	//5^59
+	0x9f4f2726179a2245, 0x01d762422c946590,	//5^60
+	0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5,	//5^61
+	0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2,	//5^62
+	0x9b934c3b330c8577, 0x63cc55f49f88eb2f,	//5^63
+	0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb,	//5^64
+	0xf316271c7fc3908a, 0x8bef464e3945ef7a,	//5^65
+	0x97edd871cfda3a56, 0x97758bf0e3cbb5ac,	//5^66
+	0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317,	//5^67
+	0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd,	//5^68
+	0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a,	//5^69
+	0xb975d6b6ee39e436, 0xb3e2fd538e122b44,	//5^70
+	0xe7d34c64a9c85d44, 0x60dbbca87196b616,	//5^71
+	0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd,	//5^72
+	0xb51d13aea4a488dd, 0x6babab6398bdbe41,	//5^73
+	0xe264589a4dcdab14, 0xc696963c7eed2dd1,	//5^74
+	0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2,	//5^75
+	0xb0de65388cc8ada8, 0x3b25a55f43294bcb,	//5^76
+	0xdd15fe86affad912, 0x49ef0eb713f39ebe,	//5^77
+	0x8a2dbf142dfcc7ab, 0x6e3569326c784337,	//5^78
+	0xacb92ed9397bf996, 0x49c2c37f07965404,	//5^79
+	0xd7e77a8f87daf7fb, 0xdc33745ec97be906,	//5^80
+	0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3,	//5^81
+	0xa8acd7c0222311bc, 0xc40832ea0d68ce0c,	//5^82
+	0xd2d80db02aabd62b, 0xf50a3fa490c30190,	//5^83
+	0x83c7088e1aab65db, 0x792667c6da79e0fa,	//5^84
+	0xa4b8cab1a1563f52, 0x577001b891185938,	//5^85
+	0xcde6fd5e09abcf26, 0xed4c0226b55e6f86,	//5^86
+	0x80b05e5ac60b6178, 0x544f8158315b05b4,	//5^87
+	0xa0dc75f1778e39d6, 0x696361ae3db1c721,	//5^88
+	0xc913936dd571c84c, 0x03bc3a19cd1e38e9,	//5^89
+	0xfb5878494ace3a5f, 0x04ab48a04065c723,	//5^90
+	0x9d174b2dcec0e47b, 0x62eb0d64283f9c76,	//5^91
+	0xc45d1df942711d9a, 0x3ba5d0bd324f8394,	//5^92
+	0xf5746577930d6500, 0xca8f44ec7ee36479,	//5^93
+	0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb,	//5^94
+	0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e,	//5^95
+	0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e,	//5^96
+	0x95d04aee3b80ece5, 0xbba1f1d158724a12,	//5^97
+	0xbb445da9ca61281f, 0x2a8a6e45ae8edc97,	//5^98
+	0xea1575143cf97226, 0xf52d09d71a3293bd,	//5^99
+	0x924d692ca61be758, 0x593c2626705f9c56,	//5^100
+	0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c,	//5^101
+	0xe498f455c38b997a, 0x0b6dfb9c0f956447,	//5^102
+	0x8edf98b59a373fec, 0x4724bd4189bd5eac,	//5^103
+	0xb2977ee300c50fe7, 0x58edec91ec2cb657,	//5^104
+	0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed,	//5^105
+	0x8b865b215899f46c, 0xbd79e0d20082ee74,	//5^106
+	0xae67f1e9aec07187, 0xecd8590680a3aa11,	//5^107
+	0xda01ee641a708de9, 0xe80e6f4820cc9495,	//5^108
+	0x884134fe908658b2, 0x3109058d147fdcdd,	//5^109
+	0xaa51823e34a7eede, 0xbd4b46f0599fd415,	//5^110
+	0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a,	//5^111
+	0x850fadc09923329e, 0x03e2cf6bc604ddb0,	//5^112
+	0xa6539930bf6bff45, 0x84db8346b786151c,	//5^113
+	0xcfe87f7cef46ff16, 0xe612641865679a63,	//5^114
+	0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e,	//5^115
+	0xa26da3999aef7749, 0xe3be5e330f38f09d,	//5^116
+	0xcb090c8001ab551c, 0x5cadf5bfd3072cc5,	//5^117
+	0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6,	//5^118
+	0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa,	//5^119
+	0xc646d63501a1511d, 0xb281e1fd541501b8,	//5^120
+	0xf7d88bc24209a565, 0x1f225a7ca91a4226,	//5^121
+	0x9ae757596946075f, 0x3375788de9b06958,	//5^122
+	0xc1a12d2fc3978937, 0x0052d6b1641c83ae,	//5^123
+	0xf209787bb47d6b84, 0xc0678c5dbd23a49a,	//5^124
+	0x9745eb4d50ce6332, 0xf840b7ba963646e0,	//5^125
+	0xbd176620a501fbff, 0xb650e5a93bc3d898,	//5^126
+	0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe,	//5^127
+	0x93ba47c980e98cdf, 0xc66f336c36b10137,	//5^128
+	0xb8a8d9bbe123f017, 0xb80b0047445d4184,	//5^129
+	0xe6d3102ad96cec1d, 0xa60dc059157491e5,	//5^130
+	0x9043ea1ac7e41392, 0x87c89837ad68db2f,	//5^131
+	0xb454e4a179dd1877, 0x29babe4598c311fb,	//5^132
+	0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a,	//5^133
+	0x8ce2529e2734bb1d, 0x1899e4a65f58660c,	//5^134
+	0xb01ae745b101e9e4, 0x5ec05dcff72e7f8f,	//5^135
+	0xdc21a1171d42645d, 0x76707543f4fa1f73,	//5^136
+	0x899504ae72497eba, 0x6a06494a791c53a8,	//5^137
+	0xabfa45da0edbde69, 0x0487db9d17636892,	//5^138
+	0xd6f8d7509292d603, 0x45a9d2845d3c42b6,	//5^139
+	0x865b86925b9bc5c2, 0x0b8a2392ba45a9b2,	//5^140
+	0xa7f26836f282b732, 0x8e6cac7768d7141e,	//5^141
+	0xd1ef0244af2364ff, 0x3207d795430cd926,	//5^142
+	0x8335616aed761f1f, 0x7f44e6bd49e807b8,	//5^143
+	0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6,	//5^144
+	0xcd036837130890a1, 0x36dba887c37a8c0f,	//5^145
+	0x802221226be55a64, 0xc2494954da2c9789,	//5^146
+	0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6c,	//5^147
+	0xc83553c5c8965d3d, 0x6f92829494e5acc7,	//5^148
+	0xfa42a8b73abbf48c, 0xcb772339ba1f17f9,	//5^149
+	0x9c69a97284b578d7, 0xff2a760414536efb,	//5^150
+	0xc38413cf25e2d70d, 0xfef5138519684aba,	//5^151
+	0xf46518c2ef5b8cd1, 0x7eb258665fc25d69,	//5^152
+	0x98bf2f79d5993802, 0xef2f773ffbd97a61,	//5^153
+	0xbeeefb584aff8603, 0xaafb550ffacfd8fa,	//5^154
+	0xeeaaba2e5dbf6784, 0x95ba2a53f983cf38,	//5^155
+	0x952ab45cfa97a0b2, 0xdd945a747bf26183,	//5^156
+	0xba756174393d88df, 0x94f971119aeef9e4,	//5^157
+	0xe912b9d1478ceb17, 0x7a37cd5601aab85d,	//5^158
+	0x91abb422ccb812ee, 0xac62e055c10ab33a,	//5^159
+	0xb616a12b7fe617aa, 0x577b986b314d6009,	//5^160
+	0xe39c49765fdf9d94, 0xed5a7e85fda0b80b,	//5^161
+	0x8e41ade9fbebc27d, 0x14588f13be847307,	//5^162
+	0xb1d219647ae6b31c, 0x596eb2d8ae258fc8,	//5^163
+	0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bb,	//5^164
+	0x8aec23d680043bee, 0x25de7bb9480d5854,	//5^165
+	0xada72ccc20054ae9, 0xaf561aa79a10ae6a,	//5^166
+	0xd910f7ff28069da4, 0x1b2ba1518094da04,	//5^167
+	0x87aa9aff79042286, 0x90fb44d2f05d0842,	//5^168
+	0xa99541bf57452b28, 0x353a1607ac744a53,	//5^169
+	0xd3fa922f2d1675f2, 0x42889b8997915ce8,	//5^170
+	0x847c9b5d7c2e09b7, 0x69956135febada11,	//5^171
+	0xa59bc234db398c25, 0x43fab9837e699095,	//5^172
+	0xcf02b2c21207ef2e, 0x94f967e45e03f4bb,	//5^173
+	0x8161afb94b44f57d, 0x1d1be0eebac278f5,	//5^174
+	0xa1ba1ba79e1632dc, 0x6462d92a69731732,	//5^175
+	0xca28a291859bbf93, 0x7d7b8f7503cfdcfe,	//5^176
+	0xfcb2cb35e702af78, 0x5cda735244c3d43e,	//5^177
+	0x9defbf01b061adab, 0x3a0888136afa64a7,	//5^178
+	0xc56baec21c7a1916, 0x088aaa1845b8fdd0,	//5^179
+	0xf6c69a72a3989f5b, 0x8aad549e57273d45,	//5^180
+	0x9a3c2087a63f6399, 0x36ac54e2f678864b,	//5^181
+	0xc0cb28a98fcf3c7f, 0x84576a1bb416a7dd,	//5^182
+	0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d5,	//5^183
+	0x969eb7c47859e743, 0x9f644ae5a4b1b325,	//5^184
+	0xbc4665b596706114, 0x873d5d9f0dde1fee,	//5^185
+	0xeb57ff22fc0c7959, 0xa90cb506d155a7ea,	//5^186
+	0x9316ff75dd87cbd8, 0x09a7f12442d588f2,	//5^187
+	0xb7dcbf5354e9bece, 0x0c11ed6d538aeb2f,	//5^188
+	0xe5d3ef282a242e81, 0x8f1668c8a86da5fa,	//5^189
+	0x8fa475791a569d10, 0xf96e017d694487bc,	//5^190
+	0xb38d92d760ec4455, 0x37c981dcc395a9ac,	//5^191
+	0xe070f78d3927556a, 0x85bbe253f47b1417,	//5^192
+	0x8c469ab843b89562, 0x93956d7478ccec8e,	//5^193
+	0xaf58416654a6babb, 0x387ac8d1970027b2,	//5^194
+	0xdb2e51bfe9d0696a, 0x06997b05fcc0319e,	//5^195
+	0x88fcf317f22241e2, 0x441fece3bdf81f03,	//5^196
+	0xab3c2fddeeaad25a, 0xd527e81cad7626c3,	//5^197
+	0xd60b3bd56a5586f1, 0x8a71e223d8d3b074,	//5^198
+	0x85c7056562757456, 0xf6872d5667844e49,	//5^199
+	0xa738c6bebb12d16c, 0xb428f8ac016561db,	//5^200
+	0xd106f86e69d785c7, 0xe13336d701beba52,	//5^201
+	0x82a45b450226b39c, 0xecc0024661173473,	//5^202
+	0xa34d721642b06084, 0x27f002d7f95d0190,	//5^203
+	0xcc20ce9bd35c78a5, 0x31ec038df7b441f4,	//5^204
+	0xff290242c83396ce, 0x7e67047175a15271,	//5^205
+	0x9f79a169bd203e41, 0x0f0062c6e984d386,	//5^206
+	0xc75809c42c684dd1, 0x52c07b78a3e60868,	//5^207
+	0xf92e0c3537826145, 0xa7709a56ccdf8a82,	//5^208
+	0x9bbcc7a142b17ccb, 0x88a66076400bb691,	//5^209
+	0xc2abf989935ddbfe, 0x6acff893d00ea435,	//5^210
+	0xf356f7ebf83552fe, 0x0583f6b8c4124d43,	//5^211
+	0x98165af37b2153de, 0xc3727a337a8b704a,	//5^212
+	0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5c,	//5^213
+	0xeda2ee1c7064130c, 0x1162def06f79df73,	//5^214
+	0x9485d4d1c63e8be7, 0x8addcb5645ac2ba8,	//5^215
+	0xb9a74a0637ce2ee1, 0x6d953e2bd7173692,	//5^216
+	0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0437,	//5^217
+	0x910ab1d4db9914a0, 0x1d9c9892400a22a2,	//5^218
+	0xb54d5e4a127f59c8, 0x2503beb6d00cab4b,	//5^219
+	0xe2a0b5dc971f303a, 0x2e44ae64840fd61d,	//5^220
+	0x8da471a9de737e24, 0x5ceaecfed289e5d2,	//5^221
+	0xb10d8e1456105dad, 0x7425a83e872c5f47,	//5^222
+	0xdd50f1996b947518, 0xd12f124e28f77719,	//5^223
+	0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f,	//5^224
+	0xace73cbfdc0bfb7b, 0x636cc64d1001550b,	//5^225
+	0xd8210befd30efa5a, 0x3c47f7e05401aa4e,	//5^226
+	0x8714a775e3e95c78, 0x65acfaec34810a71,	//5^227
+	0xa8d9d1535ce3b396, 0x7f1839a741a14d0d,	//5^228
+	0xd31045a8341ca07c, 0x1ede48111209a050,	//5^229
+	0x83ea2b892091e44d, 0x934aed0aab460432,	//5^230
+	0xa4e4b66b68b65d60, 0xf81da84d5617853f,	//5^231
+	0xce1de40642e3f4b9, 0x36251260ab9d668e,	//5^232
+	0x80d2ae83e9ce78f3, 0xc1d72b7c6b426019,	//5^233
+	0xa1075a24e4421730, 0xb24cf65b8612f81f,	//5^234
+	0xc94930ae1d529cfc, 0xdee033f26797b627,	//5^235
+	0xfb9b7cd9a4a7443c, 0x169840ef017da3b1,	//5^236
+	0x9d412e0806e88aa5, 0x8e1f289560ee864e,	//5^237
+	0xc491798a08a2ad4e, 0xf1a6f2bab92a27e2,	//5^238
+	0xf5b5d7ec8acb58a2, 0xae10af696774b1db,	//5^239
+	0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29,	//5^240
+	0xbff610b0cc6edd3f, 0x17fd090a58d32af3,	//5^241
+	0xeff394dcff8a948e, 0xddfc4b4cef07f5b0,	//5^242
+	0x95f83d0a1fb69cd9, 0x4abdaf101564f98e,	//5^243
+	0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f1,	//5^244
+	0xea53df5fd18d5513, 0x84c86189216dc5ed,	//5^245
+	0x92746b9be2f8552c, 0x32fd3cf5b4e49bb4,	//5^246
+	0xb7118682dbb66a77, 0x3fbc8c33221dc2a1,	//5^247
+	0xe4d5e82392a40515, 0x0fabaf3feaa5334a,	//5^248
+	0x8f05b1163ba6832d, 0x29cb4d87f2a7400e,	//5^249
+	0xb2c71d5bca9023f8, 0x743e20e9ef511012,	//5^250
+	0xdf78e4b2bd342cf6, 0x914da9246b255416,	//5^251
+	0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e,	//5^252
+	0xae9672aba3d0c320, 0xa184ac2473b529b1,	//5^253
+	0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741e,	//5^254
+	0x8865899617fb1871, 0x7e2fa67c7a658892,	//5^255
+	0xaa7eebfb9df9de8d, 0xddbb901b98feeab7,	//5^256
+	0xd51ea6fa85785631, 0x552a74227f3ea565,	//5^257
+	0x8533285c936b35de, 0xd53a88958f87275f,	//5^258
+	0xa67ff273b8460356, 0x8a892abaf368f137,	//5^259
+	0xd01fef10a657842c, 0x2d2b7569b0432d85,	//5^260
+	0x8213f56a67f6b29b, 0x9c3b29620e29fc73,	//5^261
+	0xa298f2c501f45f42, 0x8349f3ba91b47b8f,	//5^262
+	0xcb3f2f7642717713, 0x241c70a936219a73,	//5^263
+	0xfe0efb53d30dd4d7, 0xed238cd383aa0110,	//5^264
+	0x9ec95d1463e8a506, 0xf4363804324a40aa,	//5^265
+	0xc67bb4597ce2ce48, 0xb143c6053edcd0d5,	//5^266
+	0xf81aa16fdc1b81da, 0xdd94b7868e94050a,	//5^267
+	0x9b10a4e5e9913128, 0xca7cf2b4191c8326,	//5^268
+	0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f0,	//5^269
+	0xf24a01a73cf2dccf, 0xbc633b39673c8cec,	//5^270
+	0x976e41088617ca01, 0xd5be0503e085d813,	//5^271
+	0xbd49d14aa79dbc82, 0x4b2d8644d8a74e18,	//5^272
+	0xec9c459d51852ba2, 0xddf8e7d60ed1219e,	//5^273
+	0x93e1ab8252f33b45, 0xcabb90e5c942b503,	//5^274
+	0xb8da1662e7b00a17, 0x3d6a751f3b936243,	//5^275
+	0xe7109bfba19c0c9d, 0x0cc512670a783ad4,	//5^276
+	0x906a617d450187e2, 0x27fb2b80668b24c5,	//5^277
+	0xb484f9dc9641e9da, 0xb1f9f660802dedf6,	//5^278
+	0xe1a63853bbd26451, 0x5e7873f8a0396973,	//5^279
+	0x8d07e33455637eb2, 0xdb0b487b6423e1e8,	//5^280
+	0xb049dc016abc5e5f, 0x91ce1a9a3d2cda62,	//5^281
+	0xdc5c5301c56b75f7, 0x7641a140cc7810fb,	//5^282
+	0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9d,	//5^283
+	0xac2820d9623bf429, 0x546345fa9fbdcd44,	//5^284
+	0xd732290fbacaf133, 0xa97c177947ad4095,	//5^285
+	0x867f59a9d4bed6c0, 0x49ed8eabcccc485d,	//5^286
+	0xa81f301449ee8c70, 0x5c68f256bfff5a74,	//5^287
+	0xd226fc195c6a2f8c, 0x73832eec6fff3111,	//5^288
+	0x83585d8fd9c25db7, 0xc831fd53c5ff7eab,	//5^289
+	0xa42e74f3d032f525, 0xba3e7ca8b77f5e55,	//5^290
+	0xcd3a1230c43fb26f, 0x28ce1bd2e55f35eb,	//5^291
+	0x80444b5e7aa7cf85, 0x7980d163cf5b81b3,	//5^292
+	0xa0555e361951c366, 0xd7e105bcc332621f,	//5^293
+	0xc86ab5c39fa63440, 0x8dd9472bf3fefaa7,	//5^294
+	0xfa856334878fc150, 0xb14f98f6f0feb951,	//5^295
+	0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d3,	//5^296
+	0xc3b8358109e84f07, 0x0a862f80ec4700c8,	//5^297
+	0xf4a642e14c6262c8, 0xcd27bb612758c0fa,	//5^298
+	0x98e7e9cccfbd7dbd, 0x8038d51cb897789c,	//5^299
+	0xbf21e44003acdd2c, 0xe0470a63e6bd56c3,	//5^300
+	0xeeea5d5004981478, 0x1858ccfce06cac74,	//5^301
+	0x95527a5202df0ccb, 0x0f37801e0c43ebc8,	//5^302
+	0xbaa718e68396cffd, 0xd30560258f54e6ba,	//5^303
+	0xe950df20247c83fd, 0x47c6b82ef32a2069,	//5^304
+	0x91d28b7416cdd27e, 0x4cdc331d57fa5441,	//5^305
+	0xb6472e511c81471d, 0xe0133fe4adf8e952,	//5^306
+	0xe3d8f9e563a198e5, 0x58180fddd97723a6,	//5^307
+	0x8e679c2f5e44ff8f, 0x570f09eaa7ea7648,	//5^308
+};
+
+//---------------------------------------------------------------------------------
+
+static const uint64_t doublePow5InvSplit[DoublePow5InvTableSize][2] = {
+	{ 0x0000000000000001, 0x2000000000000000 },	//5^-0
+	{ 0x999999999999999a, 0x1999999999999999 },	//5^-1
+	{ 0x47ae147ae147ae15, 0x147ae147ae147ae1 },	//5^-2
+	{ 0x6c8b4395810624de, 0x10624dd2f1a9fbe7 },	//5^-3
+	{ 0x7a786c226809d496, 0x1a36e2eb1c432ca5 },	//5^-4
+	{ 0x61f9f01b866e43ab, 0x14f8b588e368f084 },	//5^-5
+	{ 0xb4c7f34938583622, 0x10c6f7a0b5ed8d36 },	//5^-6
+	{ 0x87a6520ec08d236a, 0x1ad7f29abcaf4857 },	//5^-7
+	{ 0x9fb841a566d74f88, 0x15798ee2308c39df },	//5^-8
+	{ 0xe62d01511f12a607, 0x112e0be826d694b2 },	//5^-9
+	{ 0xd6ae6881cb5109a4, 0x1b7cdfd9d7bdbab7 },	//5^-10
+	{ 0xdef1ed34a2a73aea, 0x15fd7fe17964955f },	//5^-11
+	{ 0x7f27f0f6e885c8bb, 0x119799812dea1119 },	//5^-12
+	{ 0x650cb4be40d60df8, 0x1c25c268497681c2 },	//5^-13
+	{ 0xea70909833de7193, 0x16849b86a12b9b01 },	//5^-14
+	{ 0x21f3a6e0297ec143, 0x1203af9ee756159b },	//5^-15
+	{ 0x6985d7cd0f313537, 0x1cd2b297d889bc2b },	//5^-16
+	{ 0x2137dfd73f5a90f9, 0x170ef54646d49689 },	//5^-17
+	{ 0xe75fe645cc4873fa, 0x12725dd1d243aba0 },	//5^-18
+	{ 0xa5663d3c7a0d865d, 0x1d83c94fb6d2ac34 },	//5^-19
+	{ 0x511e976394d79eb1, 0x179ca10c9242235d },	//5^-20
+	{ 0xda7edf82dd794bc1, 0x12e3b40a0e9b4f7d },	//5^-21
+	{ 0x2a6498d1625bac68, 0x1e392010175ee596 },	//5^-22
+	{ 0xeeb6e0a781e2f053, 0x182db34012b25144 },	//5^-23
+	{ 0x58924d52ce4f26a9, 0x1357c299a88ea76a },	//5^-24
+	{ 0x27507bb7b07ea441, 0x1ef2d0f5da7dd8aa },	//5^-25
+	{ 0x52a6c95fc0655034, 0x18c240c4aecb13bb },	//5^-26
+	{ 0x0eebd44c99eaa690, 0x13ce9a36f23c0fc9 },	//5^-27
+	{ 0xb17953adc3110a80, 0x1fb0f6be50601941 },	//5^-28
+	{ 0xc12ddc8b02740867, 0x195a5efea6b34767 },	//5^-29
+	{ 0x3424b06f3529a052, 0x14484bfeebc29f86 },	//5^-30
+	{ 0x901d59f290ee19db, 0x1039d66589687f9e },	//5^-31
+	{ 0x4cfbc31db4b0295f, 0x19f623d5a8a73297 },	//5^-32
+	{ 0x3d9635b15d59bab2, 0x14c4e977ba1f5bac },	//5^-33
+	{ 0x97ab5e277de16228, 0x109d8792fb4c4956 },	//5^-34
+	{ 0xf2abc9d8c9689d0d, 0x1a95a5b7f87a0ef0 },	//5^-35
+	{ 0x5bbca17a3aba173e, 0x154484932d2e725a },	//5^-36
+	{ 0xafca1ac82efb45cb, 0x11039d428a8b8eae },	//5^-37
+	{ 0xb2dcf7a6b1920945, 0x1b38fb9daa78e44a },	//5^-38
+	{ 0xf57d92ebc141a104, 0x15c72fb1552d836e },	//5^-39
+	{ 0xc46475896767b403, 0x116c262777579c58 },	//5^-40
+	{ 0x6d6d88dbd8a5ecd2, 0x1be03d0bf225c6f4 },	//5^-41
+	{ 0x8abe071646eb23db, 0x164cfda3281e38c3 },	//5^-42
+	{ 0x6efe6c11d255b649, 0x11d7314f534b609c },	//5^-43
+	{ 0xb197134fb6ef8a0e, 0x1c8b821885456760 },	//5^-44
+	{ 0x27ac0f72f8bfa1a5, 0x16d601ad376ab91a },	//5^-45
+	{ 0xb95672c260994e1e, 0x1244ce242c5560e1 },	//5^-46
+	{ 0xf5571e03cdc21695, 0x1d3ae36d13bbce35 },	//5^-47
+	{ 0x2aac18030b01abab, 0x17624f8a762fd82b },	//5^-48
+	{ 0xbbbce0026f348956, 0x12b50c6ec4f31355 },	//5^-49
+	{ 0x92c7ccd0b1eda889, 0x1dee7a4ad4b81eef },	//5^-50
+	{ 0xdbd30a408e57ba07, 0x17f1fb6f10934bf2 },	//5^-51
+	{ 0x7ca8d50071dfc806, 0x1327fc58da0f6ff5 },	//5^-52
+	{ 0xfaa7bb33e9660cd6, 0x1ea6608e29b24cbb },	//5^-53
+	{ 0x9552fc298784d711, 0x18851a0b548ea3c9 },	//5^-54
+	{ 0xaaa8c9bad2d0ac0e, 0x139dae6f76d88307 },	//5^-55
+	{ 0xdddadc5e1e1aace3, 0x1f62b0b257c0d1a5 },	//5^-56
+	{ 0x7e48b04b4b488a4f, 0x191bc08eac9a4151 },	//5^-57
+	{ 0xcb6d59d5d5d3a1d9, 0x141633a556e1cdda },	//5^-58
+	{ 0x3c577b1177dc817b, 0x1011c2eaabe7d7e2 },	//5^-59
+	{ 0xc6f25e825960cf2a, 0x19b604aaaca62636 },	//5^-60
+	{ 0x6bf518684780a5bb, 0x14919d5556eb51c5 },	//5^-61
+	{ 0x232a79ed06008496, 0x10747ddddf22a7d1 },	//5^-62
+	{ 0xd1dd8fe1a3340756, 0x1a53fc9631d10c81 },	//5^-63
+	{ 0xa7e4731ae8f66c45, 0x150ffd44f4a73d34 },	//5^-64
+	{ 0x531d28e253f8569e, 0x10d9976a5d52975d },	//5^-65
+	{ 0xeb61db03b98d5762, 0x1af5bf109550f22e },	//5^-66
+	{ 0xbc4e48cfc7a445e8, 0x159165a6ddda5b58 },	//5^-67
+	{ 0x6371d3d96c836b20, 0x11411e1f17e1e2ad },	//5^-68
+	{ 0x9f1c8628ad9f11cd, 0x1b9b6364f3030448 },	//5^-69
+	{ 0xe5b06b53be18db0b, 0x1615e91d8f359d06 },	//5^-70
+	{ 0xeaf3890fcb4715a2, 0x11ab20e472914a6b },	//5^-71
+	{ 0x44b8db4c7871bc37, 0x1c45016d841baa46 },	//5^-72
+	{ 0x03c715d6c6c1635f, 0x169d9abe03495505 },	//5^-73
+	{ 0x3638de456bcde919, 0x1217aefe69077737 },	//5^-74
+	{ 0x56c163a2461641c1, 0x1cf2b1970e725858 },	//5^-75
+	{ 0xdf011c81d1ab67ce, 0x17288e1271f51379 },	//5^-76
+	{ 0x7f3416ce4155eca5, 0x1286d80ec190dc61 },	//5^-77
+	{ 0x6520247d3556476e, 0x1da48ce468e7c702 },	//5^-78
+	{ 0xea801d30f7783925, 0x17b6d71d20b96c01 },	//5^-79
+	{ 0xbb99b0f3f92cfa84, 0x12f8ac174d612334 },	//5^-80
+	{ 0x5f5c4e532847f739, 0x1e5aacf215683854 },	//5^-81
+	{ 0x7f7d0b75b9d32c2e, 0x18488a5b44536043 },	//5^-82
+	{ 0x9930d5f7c7dc2358, 0x136d3b7c36a919cf },	//5^-83
+	{ 0x8eb4898c72f9d226, 0x1f152bf9f10e8fb2 },	//5^-84
+	{ 0x722a07a38f2e41b8, 0x18ddbcc7f40ba628 },	//5^-85
+	{ 0xc1bb394fa5be9afa, 0x13e497065cd61e86 },	//5^-86
+	{ 0x9c5ec2190930f7f6, 0x1fd424d6faf030d7 },	//5^-87
+	{ 0x49e56814075a5ff8, 0x197683df2f268d79 },	//5^-88
+	{ 0x6e51201005e1e660, 0x145ecfe5bf520ac7 },	//5^-89
+	{ 0xf1da800cd181851a, 0x104bd984990e6f05 },	//5^-90
+	{ 0x4fc400148268d4f5, 0x1a12f5a0f4e3e4d6 },	//5^-91
+	{ 0xd96999aa01ed772b, 0x14dbf7b3f71cb711 },	//5^-92
+	{ 0xadee1488018ac5bc, 0x10aff95cc5b09274 },	//5^-93
+	{ 0x497ceda668de092c, 0x1ab328946f80ea54 },	//5^-94
+	{ 0x3aca57b853e4d424, 0x155c2076bf9a5510 },	//5^-95
+	{ 0x623b7960431d7683, 0x1116805effaeaa73 },	//5^-96
+	{ 0x9d2bf566d1c8bd9e, 0x1b5733cb32b110b8 },	//5^-97
+	{ 0x7dbcc452416d647f, 0x15df5ca28ef40d60 },	//5^-98
+	{ 0xcafd69db678ab6cc, 0x117f7d4ed8c33de6 },	//5^-99
+	{ 0xab2f0fc572778adf, 0x1bff2ee48e052fd7 },	//5^-100
+	{ 0x88f273045b92d580, 0x1665bf1d3e6a8cac },	//5^-101
+	{ 0xd3f528d049424466, 0x11eaff4a98553d56 },	//5^-102
+	{ 0xb988414d4203a0a3, 0x1cab3210f3bb9557 },	//5^-103
+	{ 0x6139cdd76802e6e9, 0x16ef5b40c2fc7779 },	//5^-104
+	{ 0xe761717920025254, 0x125915cd68c9f92d },	//5^-105
+	{ 0xa568b58e999d5086, 0x1d5b561574765b7c },	//5^-106
+	{ 0x5120913ee14aa6d2, 0x177c44ddf6c515fd },	//5^-107
+	{ 0xa74d40ff1aa21f0e, 0x12c9d0b1923744ca },	//5^-108
+	{ 0x0baece64f769cb4a, 0x1e0fb44f50586e11 },	//5^-109
+	{ 0x3c8bd850c5ee3c3b, 0x180c903f7379f1a7 },	//5^-110
+	{ 0xca0979da37f1c9c9, 0x133d4032c2c7f485 },	//5^-111
+	{ 0xa9a8c2f6bfe942db, 0x1ec866b79e0cba6f },	//5^-112
+	{ 0x2153cf2bccba9be3, 0x18a0522c7e709526 },	//5^-113
+	{ 0x1aa9728970954982, 0x13b374f06526ddb8 },	//5^-114
+	{ 0xf775840f1a88759d, 0x1f8587e7083e2f8c },	//5^-115
+	{ 0x5f9136727ba05e17, 0x19379fec0698260a },	//5^-116
+	{ 0x1940f85b9619e4df, 0x142c7ff0054684d5 },	//5^-117
+	{ 0xe100c6afab47ea4c, 0x1023998cd1053710 },	//5^-118
+	{ 0xce67a44c453fdd47, 0x19d28f47b4d524e7 },	//5^-119
+	{ 0xd852e9d69dccb106, 0x14a8729fc3ddb71f },	//5^-120
+	{ 0x79dbee454b0a2738, 0x1086c219697e2c19 },	//5^-121
+	{ 0x295fe3a211a9d859, 0x1a71368f0f30468f },	//5^-122
+	{ 0xbab31c81a7bb137a, 0x15275ed8d8f36ba5 },	//5^-123
+	{ 0x6228e39aec95a92f, 0x10ec4be0ad8f8951 },	//5^-124
+	{ 0x9d0e38f7e0ef7517, 0x1b13ac9aaf4c0ee8 },	//5^-125
+	{ 0xb0d82d931a592a79, 0x15a956e225d67253 },	//5^-126
+	{ 0x8d79be0f4847552e, 0x11544581b7dec1dc },	//5^-127
+	{ 0x158f967eda0bbb7c, 0x1bba08cf8c979c94 },	//5^-128
+	{ 0x77a611ff14d62f97, 0x162e6d72d6dfb076 },	//5^-129
+	{ 0xf951a7ff43de8c79, 0x11bebdf578b2f391 },	//5^-130
+	{ 0xc21c3ffed2fdad8e, 0x1c6463225ab7ec1c },	//5^-131
+	{ 0x01b0333242648ad8, 0x16b6b5b5155ff017 },	//5^-132
+	{ 0x0159c28e9b83a246, 0x122bc490dde659ac },	//5^-133
+	{ 0xcef604175f3903a3, 0x1d12d41afca3c2ac },	//5^-134
+	{ 0x725e69ac4c2d9c83, 0x17424348ca1c9bbd },	//5^-135
+	{ 0xf5185489d68ae39c, 0x129b69070816e2fd },	//5^-136
+	{ 0xee8d540fbdab05c6, 0x1dc574d80cf16b2f },	//5^-137
+	{ 0xbed77672fe226b05, 0x17d12a4670c1228c },	//5^-138
+	{ 0xff12c528cb4ebc04, 0x130dbb6b8d674ed6 },	//5^-139
+	{ 0xcb513b74787df9a0, 0x1e7c5f127bd87e24 },	//5^-140
+	{ 0x090dc929f9fe614d, 0x18637f41fcad31b7 },	//5^-141
+	{ 0xa0d7d42194cb810a, 0x1382cc34ca2427c5 },	//5^-142
+	{ 0x67bfb9cf5478ce77, 0x1f37ad21436d0c6f },	//5^-143
+	{ 0x1fcc94a5dd2d71f9, 0x18f9574dcf8a7059 },	//5^-144
+	{ 0x7fd6dd517dbdf4c7, 0x13faac3e3fa1f37a },	//5^-145
+	{ 0xffbe2ee8c92fee0b, 0x1ff779fd329cb8c3 },	//5^-146
+	{ 0x6631bf20a0f324d6, 0x1992c7fdc216fa36 },	//5^-147
+	{ 0xb827cc1a1a5c1d78, 0x14756ccb01abfb5e },	//5^-148
+	{ 0x935309ae7b7ce460, 0x105df0a267bcc918 },	//5^-149
+	{ 0x1eeb42b0c594a099, 0x1a2fe76a3f9474f4 },	//5^-150
+	{ 0xe58902270476e6e1, 0x14f31f8832dd2a5c },	//5^-151
+	{ 0xb7a0ce859d2bebe7, 0x10c27fa028b0eeb0 },	//5^-152
+	{ 0x59014a6f61dfdfd8, 0x1ad0cc33744e4ab4 },	//5^-153
+	{ 0xe0cdd525e7e64cad, 0x1573d68f903ea229 },	//5^-154
+	{ 0x4d7177518651d6f1, 0x11297872d9cbb4ee },	//5^-155
+	{ 0x7be8bee8d6e957e8, 0x1b758d848fac54b0 },	//5^-156
+	{ 0xfcba3253df211320, 0x15f7a46a0c89dd59 },	//5^-157
+	{ 0x63c8284318e74280, 0x1192e9ee706e4aae },	//5^-158
+	{ 0x060d0d3827d86a66, 0x1c1e43171a4a1117 },	//5^-159
+	{ 0x6b3da42cecad21eb, 0x167e9c127b6e7412 },	//5^-160
+	{ 0x88fe1cf0bd574e56, 0x11fee341fc585cdb },	//5^-161
+	{ 0x419694b462254a23, 0x1ccb0536608d615f },	//5^-162
+	{ 0x67abaa29e81dd4e9, 0x1708d0f84d3de77f },	//5^-163
+	{ 0xb95621bb2017dd87, 0x126d73f9d764b932 },	//5^-164
+	{ 0xc223692b668c95a5, 0x1d7becc2f23ac1ea },	//5^-165
+	{ 0xce82ba891ed6de1d, 0x179657025b6234bb },	//5^-166
+	{ 0xa53562074bdf1818, 0x12deac01e2b4f6fc },	//5^-167
+	{ 0x3b889cd87964f359, 0x1e3113363787f194 },	//5^-168
+	{ 0xfc6d4a46c783f5e1, 0x18274291c6065adc },	//5^-169
+	{ 0x30576e9f06032b1a, 0x13529ba7d19eaf17 },	//5^-170
+	{ 0x1a257dcb3cd1de90, 0x1eea92a61c311825 },	//5^-171
+	{ 0x481dfe3c30a7e540, 0x18bba884e35a79b7 },	//5^-172
+	{ 0xd34b31c9c0865100, 0x13c9539d82aec7c5 },	//5^-173
+	{ 0x5211e942cda3b4cd, 0x1fa885c8d117a609 },	//5^-174
+	{ 0x74db21023e1c90a4, 0x19539e3a40dfb807 },	//5^-175
+	{ 0xf715b401cb4a0d50, 0x1442e4fb67196005 },	//5^-176
+	{ 0xf8de299b09080aa7, 0x103583fc527ab337 },	//5^-177
+	{ 0x8e304291a80cddd7, 0x19ef3993b72ab859 },	//5^-178
+	{ 0x3e8d020e200a4b13, 0x14bf6142f8eef9e1 },	//5^-179
+	{ 0x653d9b3e80083c0f, 0x10991a9bfa58c7e7 },	//5^-180
+	{ 0x6ec8f864000d2ce4, 0x1a8e90f9908e0ca5 },	//5^-181
+	{ 0x8bd3f9e999a423ea, 0x153eda614071a3b7 },	//5^-182
+	{ 0x3ca994bae1501cbb, 0x10ff151a99f482f9 },	//5^-183
+	{ 0xc775bac49bb3612b, 0x1b31bb5dc320d18e },	//5^-184
+	{ 0xd2c4956a16291a89, 0x15c162b168e70e0b },	//5^-185
+	{ 0xdbd0778811ba7ba1, 0x11678227871f3e6f },	//5^-186
+	{ 0x2c80bf401c5d929b, 0x1bd8d03f3e9863e6 },	//5^-187
+	{ 0xbd33cc3349e47549, 0x16470cff6546b651 },	//5^-188
+	{ 0xca8fd68f6e505dd4, 0x11d270cc51055ea7 },	//5^-189
+	{ 0x4419574be3b3c953, 0x1c83e7ad4e6efdd9 },	//5^-190
+	{ 0x0347790982f63aa9, 0x16cfec8aa52597e1 },	//5^-191
+	{ 0xcf6c60d468c4fbba, 0x123ff06eea847980 },	//5^-192
+	{ 0xe57a34870e07f92a, 0x1d331a4b10d3f59a },	//5^-193
+	{ 0x512e906c0b399422, 0x175c1508da432ae2 },	//5^-194
+	{ 0xda8ba6bcd5c7a9b5, 0x12b010d3e1cf5581 },	//5^-195
+	{ 0x90df712e22d90f87, 0x1de6815302e5559c },	//5^-196
+	{ 0xda4c5a8b4f140c6c, 0x17eb9aa8cf1dde16 },	//5^-197
+	{ 0xaea37ba2a5a9a38a, 0x1322e220a5b17e78 },	//5^-198
+	{ 0x7dd25f6aa2a905a9, 0x1e9e369aa2b59727 },	//5^-199
+	{ 0x97db7f888220d154, 0x187e92154ef7ac1f },	//5^-200
+	{ 0x797c6606ce80a777, 0x139874ddd8c6234c },	//5^-201
+	{ 0x8f2d700ae4010bf1, 0x1f5a549627a36bad },	//5^-202
+	{ 0x0c2459a25000d65a, 0x191510781fb5efbe },	//5^-203
+	{ 0x701d1481d99a4515, 0x1410d9f9b2f7f2fe },	//5^-204
+	{ 0xc017439b147b6a77, 0x100d7b2e28c65bfe },	//5^-205
+	{ 0xccf205c4ed9243f2, 0x19af2b7d0e0a2cca },	//5^-206
+	{ 0x0a5b37d0be0e9cc2, 0x148c22ca71a1bd6f },	//5^-207
+	{ 0x0848f973cb3ee3ce, 0x10701bd527b4978c },	//5^-208
+	{ 0xda0e5bec78649fb0, 0x1a4cf9550c5425ac },	//5^-209
+	{ 0x7b3eaff060507fc0, 0x150a6110d6a9b7bd },	//5^-210
+	{ 0x95cbbff380406633, 0x10d51a73deee2c97 },	//5^-211
+	{ 0xefac665266cd7052, 0x1aee90b964b04758 },	//5^-212
+	{ 0x2623850eb8a459db, 0x158ba6fab6f36c47 },	//5^-213
+	{ 0x1e82d0d893b6ae49, 0x113c85955f29236c },	//5^-214
+	{ 0xfd9e1af41f8ab075, 0x1b9408eefea838ac },	//5^-215
+	{ 0x97b1af29b2d559f7, 0x16100725988693bd },	//5^-216
+	{ 0xac8e25baf5777b2c, 0x11a66c1e139edc97 },	//5^-217
+	{ 0x7a7d092b2258c513, 0x1c3d79c9b8fe2dbf },	//5^-218
+	{ 0x61fda0ef4ead6a76, 0x169794a160cb57cc },	//5^-219
+	{ 0xe7fe1a590bbdeec5, 0x1212dd4de7091309 },	//5^-220
+	{ 0xa6635d5b45fcb13a, 0x1ceafbafd80e84dc },	//5^-221
+	{ 0x851c4aaf6b308dc8, 0x172262f3133ed0b0 },	//5^-222
+	{ 0xd0e36ef2bc26d7d4, 0x1281e8c275cbda26 },	//5^-223
+	{ 0xb49f17eac6a48c86, 0x1d9ca79d894629d7 },	//5^-224
+	{ 0x2a18dfef0550706b, 0x17b08617a104ee46 },	//5^-225
+	{ 0x54e0b3259dd9f389, 0x12f39e794d9d8b6b },	//5^-226
+	{ 0x87cdeb6f62f65274, 0x1e5297287c2f4578 },	//5^-227
+	{ 0xd30b22bf825ea85d, 0x18421286c9bf6ac6 },	//5^-228
+	{ 0x0f3c1bcc684bb9e4, 0x13680ed23aff889f },	//5^-229
+	{ 0x18602c7a4079296d, 0x1f0ce4839198da98 },	//5^-230
+	{ 0x46b356c833942124, 0x18d71d360e13e213 },	//5^-231
+	{ 0x388f78a029434db6, 0x13df4a91a4dcb4dc },	//5^-232
+	{ 0x5a7f2766a86baf8a, 0x1fcbaa82a1612160 },	//5^-233
+	{ 0x153285ebb9efbfa2, 0x196fbb9bb44db44d },	//5^-234
+	{ 0xaa8ed189618c994e, 0x145962e2f6a4903d },	//5^-235
+	{ 0xeed8a7a11ad6e10c, 0x1047824f2bb6d9ca },	//5^-236
+	{ 0x7e27729b5e249b45, 0x1a0c03b1df8af611 },	//5^-237
+	{ 0xfe85f549181d4904, 0x14d6695b193bf80d },	//5^-238
+	{ 0xcb9e5dd4134aa0d0, 0x10ab877c142ff9a4 },	//5^-239
+	{ 0xdf63c9535211014d, 0x1aac0bf9b9e65c3a },	//5^-240
+	{ 0x191ca10f74da6771, 0x15566ffafb1eb02f },	//5^-241
+	{ 0xadb080d92a4852c1, 0x1111f32f2f4bc025 },	//5^-242
+	{ 0x15e7348eaa0d5134, 0x1b4feb7eb212cd09 },	//5^-243
+	{ 0xab1f5d3eee710dc4, 0x15d98932280f0a6d },	//5^-244
+	{ 0xbc1917658b8da49d, 0x117ad428200c0857 },	//5^-245
+	{ 0x2cf4f23c127c3a94, 0x1bf7b9d9cce00d59 },	//5^-246
+	{ 0xf0c3f4fcdb969543, 0x165fc7e170b33de0 },	//5^-247
+	{ 0x5a365d9716121103, 0x11e6398126f5cb1a },	//5^-248
+	{ 0x9056fc24f01ce804, 0x1ca38f350b22de90 },	//5^-249
+	{ 0xd9df301d8ce3ecd0, 0x16e93f5da2824ba6 },	//5^-250
+	{ 0xe17f59b13d8323da, 0x125432b14ecea2eb },	//5^-251
+	{ 0x68cbc2b52f38395c, 0x1d53844ee47dd179 },	//5^-252
+	{ 0x53d6355dbf602de3, 0x177603725064a794 },	//5^-253
+	{ 0xa9782ab165e68b1c, 0x12c4cf8ea6b6ec76 },	//5^-254
+	{ 0x0f26aab56fd744fa, 0x1e07b27dd78b13f1 },	//5^-255
+	{ 0x3f52222abfdf6a62, 0x18062864ac6f4327 },	//5^-256
+	{ 0x65db4e88997f884e, 0x1338205089f29c1f },	//5^-257
+	{ 0x6fc54a7428cc0d4a, 0x1ec033b40fea9365 },	//5^-258
+	{ 0x596aa1f68709a43b, 0x1899c2f673220f84 },	//5^-259
+	{ 0xadeee7f86c07b696, 0x13ae3591f5b4d936 },	//5^-260
+	{ 0x497e3ff3e00c5756, 0x1f7d228322baf524 },	//5^-261
+	{ 0xd464fff64cd6ac45, 0x1930e868e89590e9 },	//5^-262
+	{ 0x4383fff83d7889d1, 0x14272053ed4473ee },	//5^-263
+	{ 0xcf9cccc69793a174, 0x101f4d0ff1038ff1 },	//5^-264
+	{ 0x7f6147a425b90252, 0x19cbae7fe805b31c },	//5^-265
+	{ 0xcc4dd2e9b7c7350f, 0x14a2f1ffecd15c16 },	//5^-266
+	{ 0x3d0b0f215fd290d9, 0x10825b3323dab012 },	//5^-267
+	{ 0x61ab4b689950e7c1, 0x1a6a2b85062ab350 },	//5^-268
+	{ 0x4e22a2ba1440b967, 0x1521bc6a6b555c40 },	//5^-269
+	{ 0x0b4ee894dd009453, 0x10e7c9eebc4449cd },	//5^-270
+	{ 0x1217da87c800ed51, 0x1b0c764ac6d3a948 },	//5^-271
+	{ 0xdb46486ca000bdda, 0x15a391d56bdc876c },	//5^-272
+	{ 0x490506bd4ccd64af, 0x114fa7ddefe39f8a },	//5^-273
+	{ 0xa8080ac87ae23ab1, 0x1bb2a62fe638ff43 },	//5^-274
+	{ 0x5339a239fbe82ef4, 0x162884f31e93ff69 },	//5^-275
+	{ 0x75c7b4fb2fecf25d, 0x11ba03f5b20fff87 },	//5^-276
+	{ 0x22d92191e647ea2e, 0x1c5cd322b67fff3f },	//5^-277
+	{ 0xb57a8141850654f2, 0x16b0a8e891ffff65 },	//5^-278
+	{ 0xc4620101373843f5, 0x1226ed86db3332b7 },	//5^-279
+	{ 0x3a366801f1f39fee, 0x1d0b15a491eb8459 },	//5^-280
+	{ 0xfb5eb99b27f6198b, 0x173c115074bc69e0 },	//5^-281
+	{ 0x2f7efae2865e7ad6, 0x129674405d6387e7 },	//5^-282
+	{ 0xe597f7d0d6fd9156, 0x1dbd86cd6238d971 },	//5^-283
+	{ 0x8479930d78cadaab, 0x17cad23de82d7ac1 },	//5^-284
+	{ 0xd06142712d6f1556, 0x1308a831868ac89a },	//5^-285
+	{ 0x4d686a4eaf182222, 0x1e74404f3daada91 },	//5^-286
+	{ 0xa453883ef279b4e8, 0x185d003f6488aeda },	//5^-287
+	{ 0xe9dc6cff28615d87, 0x137d99cc506d58ae },	//5^-288
+	{ 0xa960ae650d6895a4, 0x1f2f5c7a1a488de4 },	//5^-289
+	{ 0xbab3beb73ded4483, 0x18f2b061aea07183 },	//5^-290
+	{ 0x2ef6322c318a9d36, 0x13f559e7bee6c136 },	//5^-291
+	{ 0xe4bd1d13827761f0, 0x1feef63f97d79b89 },	//5^-292
+	{ 0x83ca7da9352c4e5a, 0x198bf832dfdfafa1 },	//5^-293
+	{ 0x9ca1fe20f756a515, 0x146ff9c24cb2f2e7 },	//5^-294
+	{ 0x4a1b31b3f9121daa, 0x1059949b708f28b9 },	//5^-295
+	{ 0x435eb5ecc1b695dd, 0x1a28edc580e50df5 },	//5^-296
+	{ 0x35e55e57015ede4a, 0x14ed8b04671da4c4 },	//5^-297
+	{ 0xc4b77eac0118b1d5, 0x10be08d0527e1d69 },	//5^-298
+	{ 0xa12597799b5ab622, 0x1ac9a7b3b7302f0f },	//5^-299
+	{ 0x4db7ac6149155e81, 0x156e1fc2f8f358d9 },	//5^-300
+	{ 0xd7c6238107444b9b, 0x1124e63593f5e0ad },	//5^-301
+	{ 0x593d059b3ed3ac2b, 0x1b6e3d2286563449 },	//5^-302
+	{ 0xe0fd9e15cbdc89bc, 0x15f1ca820511c36d },	//5^-303
+	{ 0xb3fe18116fe3a163, 0x118e3b9b37416924 },	//5^-304
+	{ 0x866359b57fd29bd1, 0x1c16c5c525357507 },	//5^-305
+	{ 0xd1e91491330ee30e, 0x16789e3750f790d2 },	//5^-306
+	{ 0x74ba76da8f3f1c0b, 0x11fa182c40c60d75 },	//5^-307
+	{ 0xedf72490e531c678, 0x1cc359e067a348bb },	//5^-308
+	{ 0x8b2c1d40b75b052d, 0x1702ae4d1fb5d3c9 },	//5^-309
+	{ 0x6f567dcd5f7c0424, 0x12688b70e62b0fd4 },	//5^-310
+	{ 0x7ef0c94898c66d06, 0x1d74124e3d11b2ed },	//5^-311
+	{ 0x98c0a106e09ebd9f, 0x17900ea4fda7c257 },	//5^-312
+	{ 0x470080d24d4bcae6, 0x12d9a550caec9b79 },	//5^-313
+	{ 0xd800ce1d487944a2, 0x1e29088144adc58e },	//5^-314
+	{ 0x1333d8176d2dd082, 0x1820d39a9d57d13f },	//5^-315
+	{ 0xa8f646792424a6ce, 0x134d76154aaca765 },	//5^-316
+	{ 0x74bd3d8ea03aa47d, 0x1ee25688777aa56f },	//5^-317
+	{ 0x5d64313ee6955064, 0x18b51206c5fbb78c },	//5^-318
+	{ 0x4ab68dcbebaaa6b7, 0x13c40e6bd1962c70 },	//5^-319
+	{ 0x1124161312aaa457, 0x1fa01712e8f0471a },	//5^-320
+	{ 0xda8344dc0eeee9df, 0x194cdf4253f36c14 },	//5^-321
+	{ 0xe2029d7cd8bf2180, 0x143d7f6843292343 },	//5^-322
+	{ 0x4e687dfd7a328133, 0x103132b9cf541c36 },	//5^-323
+	{ 0x4a40c9959050ceb8, 0x19e851294bb9c6bd },	//5^-324
+	{ 0x0833d477a6a70bc6, 0x14b9da876fc7d231 },	//5^-325
+	{ 0xa02976c61eec096b, 0x1094aed2bfd30e8d },	//5^-326
+	{ 0x004257a364acdbdf, 0x1a877e1dffb81749 },	//5^-327
+	{ 0xcd01dfb5ea23e319, 0x153931b1996012a0 },	//5^-328
+	{ 0x70ce4c91881cb5ae, 0x10fa8e27ade6754d },	//5^-329
+	{ 0x1ae3adb5a69455e2, 0x1b2a7d0c4970bbaf },	//5^-330
+	{ 0x7be957c4854377e8, 0x15bb973d078d62f2 },	//5^-331
+	{ 0xc987796a0435f987, 0x1162df64060ab58e },	//5^-332
+	{ 0x75a58f1006bcc271, 0x1bd1656cd67788e4 },	//5^-333
+	{ 0xf7b7a5a66bca3527, 0x16411df0ab92d3e9 },	//5^-334
+	{ 0x5fc61e1ebca1c41f, 0x11cdb18d560f0fee },	//5^-335
+	{ 0xffa363646102d365, 0x1c7c4f4889b1b316 },	//5^-336
+	{ 0x32e91c504d9bdc51, 0x16c9d906d48e28df },	//5^-337
+	{ 0x8f20e37371497d0e, 0x123b140576d820b2 },	//5^-338
+	{ 0x7e9b0585820f2e7c, 0x1d2b533bf159cdea },	//5^-339
+	{ 0xcbaf379e01a5beca, 0x1755dc2ff447d7ee },	//5^-340
+	{ 0x0958f94b348498a1, 0x12ab168cc36cacbf },	//5^-341
+};
+
+static const uint64_t doublePow5Split[DoublePow5TableSize][2] = {
+	{ 0x0000000000000000, 0x1000000000000000 },	//5^0
+	{ 0x0000000000000000, 0x1400000000000000 },	//5^1
+	{ 0x0000000000000000, 0x1900000000000000 },	//5^2
+	{ 0x0000000000000000, 0x1f40000000000000 },	//5^3
+	{ 0x0000000000000000, 0x1388000000000000 },	//5^4
+	{ 0x0000000000000000, 0x186a000000000000 },	//5^5
+	{ 0x0000000000000000, 0x1e84800000000000 },	//5^6
+	{ 0x0000000000000000, 0x1312d00000000000 },	//5^7
+	{ 0x0000000000000000, 0x17d7840000000000 },	//5^8
+	{ 0x0000000000000000, 0x1dcd650000000000 },	//5^9
+	{ 0x0000000000000000, 0x12a05f2000000000 },	//5^10
+	{ 0x0000000000000000, 0x174876e800000000 },	//5^11
+	{ 0x0000000000000000, 0x1d1a94a200000000 },	//5^12
+	{ 0x0000000000000000, 0x12309ce540000000 },	//5^13
+	{ 0x0000000000000000, 0x16bcc41e90000000 },	//5^14
+	{ 0x0000000000000000, 0x1c6bf52634000000 },	//5^15
+	{ 0x0000000000000000, 0x11c37937e0800000 },	//5^16
+	{ 0x0000000000000000, 0x16345785d8a00000 },	//5^17
+	{ 0x0000000000000000, 0x1bc16d674ec80000 },	//5^18
+	{ 0x0000000000000000, 0x1158e460913d0000 },	//5^19
+	{ 0x0000000000000000, 0x15af1d78b58c4000 },	//5^20
+	{ 0x0000000000000000, 0x1b1ae4d6e2ef5000 },	//5^21
+	{ 0x0000000000000000, 0x10f0cf064dd59200 },	//5^22
+	{ 0x0000000000000000, 0x152d02c7e14af680 },	//5^23
+	{ 0x0000000000000000, 0x1a784379d99db420 },	//5^24
+	{ 0x0000000000000000, 0x108b2a2c28029094 },	//5^25
+	{ 0x0000000000000000, 0x14adf4b7320334b9 },	//5^26
+	{ 0x4000000000000000, 0x19d971e4fe8401e7 },	//5^27
+	{ 0x8800000000000000, 0x1027e72f1f128130 },	//5^28
+	{ 0xaa00000000000000, 0x1431e0fae6d7217c },	//5^29
+	{ 0xd480000000000000, 0x193e5939a08ce9db },	//5^30
+	{ 0xc9a0000000000000, 0x1f8def8808b02452 },	//5^31
+	{ 0xbe04000000000000, 0x13b8b5b5056e16b3 },	//5^32
+	{ 0xad85000000000000, 0x18a6e32246c99c60 },	//5^33
+	{ 0xd8e6400000000000, 0x1ed09bead87c0378 },	//5^34
+	{ 0x878fe80000000000, 0x13426172c74d822b },	//5^35
+	{ 0x6973e20000000000, 0x1812f9cf7920e2b6 },	//5^36
+	{ 0x03d0da8000000000, 0x1e17b84357691b64 },	//5^37
+	{ 0x8262889000000000, 0x12ced32a16a1b11e },	//5^38
+	{ 0x22fb2ab400000000, 0x178287f49c4a1d66 },	//5^39
+	{ 0xabb9f56100000000, 0x1d6329f1c35ca4bf },	//5^40
+	{ 0xcb54395ca0000000, 0x125dfa371a19e6f7 },	//5^41
+	{ 0xbe2947b3c8000000, 0x16f578c4e0a060b5 },	//5^42
+	{ 0x2db399a0ba000000, 0x1cb2d6f618c878e3 },	//5^43
+	{ 0xfc90400474400000, 0x11efc659cf7d4b8d },	//5^44
+	{ 0x7bb4500591500000, 0x166bb7f0435c9e71 },	//5^45
+	{ 0xdaa16406f5a40000, 0x1c06a5ec5433c60d },	//5^46
+	{ 0xa8a4de8459868000, 0x118427b3b4a05bc8 },	//5^47
+	{ 0xd2ce16256fe82000, 0x15e531a0a1c872ba },	//5^48
+	{ 0x87819baecbe22800, 0x1b5e7e08ca3a8f69 },	//5^49
+	{ 0xf4b1014d3f6d5900, 0x111b0ec57e6499a1 },	//5^50
+	{ 0x71dd41a08f48af40, 0x1561d276ddfdc00a },	//5^51
+	{ 0x0e549208b31adb10, 0x1aba4714957d300d },	//5^52
+	{ 0x28f4db456ff0c8ea, 0x10b46c6cdd6e3e08 },	//5^53
+	{ 0x33321216cbecfb24, 0x14e1878814c9cd8a },	//5^54
+	{ 0xbffe969c7ee839ed, 0x1a19e96a19fc40ec },	//5^55
+	{ 0xf7ff1e21cf512434, 0x105031e2503da893 },	//5^56
+	{ 0xf5fee5aa43256d41, 0x14643e5ae44d12b8 },	//5^57
+	{ 0x337e9f14d3eec892, 0x197d4df19d605767 },	//5^58
+	{ 0x005e46da08ea7ab6, 0x1fdca16e04b86d41 },	//5^59
+	{ 0xa03aec4845928cb2, 0x13e9e4e4c2f34448 },	//5^60
+	{ 0xc849a75a56f72fde, 0x18e45e1df3b0155a },	//5^61
+	{ 0x7a5c1130ecb4fbd6, 0x1f1d75a5709c1ab1 },	//5^62
+	{ 0xec798abe93f11d65, 0x13726987666190ae },	//5^63
+	{ 0xa797ed6e38ed64bf, 0x184f03e93ff9f4da },	//5^64
+	{ 0x517de8c9c728bdef, 0x1e62c4e38ff87211 },	//5^65
+	{ 0xd2eeb17e1c7976b5, 0x12fdbb0e39fb474a },	//5^66
+	{ 0x87aa5ddda397d462, 0x17bd29d1c87a191d },	//5^67
+	{ 0xe994f5550c7dc97b, 0x1dac74463a989f64 },	//5^68
+	{ 0x11fd195527ce9ded, 0x128bc8abe49f639f },	//5^69
+	{ 0xd67c5faa71c24568, 0x172ebad6ddc73c86 },	//5^70
+	{ 0x8c1b77950e32d6c2, 0x1cfa698c95390ba8 },	//5^71
+	{ 0x57912abd28dfc639, 0x121c81f7dd43a749 },	//5^72
+	{ 0xad75756c7317b7c8, 0x16a3a275d494911b },	//5^73
+	{ 0x98d2d2c78fdda5ba, 0x1c4c8b1349b9b562 },	//5^74
+	{ 0x9f83c3bcb9ea8794, 0x11afd6ec0e14115d },	//5^75
+	{ 0x0764b4abe8652979, 0x161bcca7119915b5 },	//5^76
+	{ 0x493de1d6e27e73d7, 0x1ba2bfd0d5ff5b22 },	//5^77
+	{ 0x6dc6ad264d8f0866, 0x1145b7e285bf98f5 },	//5^78
+	{ 0xc938586fe0f2ca80, 0x159725db272f7f32 },	//5^79
+	{ 0x7b866e8bd92f7d20, 0x1afcef51f0fb5eff },	//5^80
+	{ 0xad34051767bdae34, 0x10de1593369d1b5f },	//5^81
+	{ 0x9881065d41ad19c1, 0x15159af804446237 },	//5^82
+	{ 0x7ea147f492186032, 0x1a5b01b605557ac5 },	//5^83
+	{ 0x6f24ccf8db4f3c1f, 0x1078e111c3556cbb },	//5^84
+	{ 0x4aee003712230b27, 0x14971956342ac7ea },	//5^85
+	{ 0xdda98044d6abcdf0, 0x19bcdfabc13579e4 },	//5^86
+	{ 0x0a89f02b062b60b6, 0x10160bcb58c16c2f },	//5^87
+	{ 0xcd2c6c35c7b638e4, 0x141b8ebe2ef1c73a },	//5^88
+	{ 0x8077874339a3c71d, 0x1922726dbaae3909 },	//5^89
+	{ 0xe0956914080cb8e4, 0x1f6b0f092959c74b },	//5^90
+	{ 0x6c5d61ac8507f38e, 0x13a2e965b9d81c8f },	//5^91
+	{ 0x4774ba17a649f072, 0x188ba3bf284e23b3 },	//5^92
+	{ 0x1951e89d8fdc6c8f, 0x1eae8caef261aca0 },	//5^93
+	{ 0x0fd3316279e9c3d9, 0x132d17ed577d0be4 },	//5^94
+	{ 0x13c7fdbb186434cf, 0x17f85de8ad5c4edd },	//5^95
+	{ 0x58b9fd29de7d4203, 0x1df67562d8b36294 },	//5^96
+	{ 0xb7743e3a2b0e4942, 0x12ba095dc7701d9c },	//5^97
+	{ 0xe5514dc8b5d1db92, 0x17688bb5394c2503 },	//5^98
+	{ 0xdea5a13ae3465277, 0x1d42aea2879f2e44 },	//5^99
+	{ 0x0b2784c4ce0bf38a, 0x1249ad2594c37ceb },	//5^100
+	{ 0xcdf165f6018ef06d, 0x16dc186ef9f45c25 },	//5^101
+	{ 0x416dbf7381f2ac88, 0x1c931e8ab871732f },	//5^102
+	{ 0x88e497a83137abd5, 0x11dbf316b346e7fd },	//5^103
+	{ 0xeb1dbd923d8596ca, 0x1652efdc6018a1fc },	//5^104
+	{ 0x25e52cf6cce6fc7d, 0x1be7abd3781eca7c },	//5^105
+	{ 0x97af3c1a40105dce, 0x1170cb642b133e8d },	//5^106
+	{ 0xfd9b0b20d0147542, 0x15ccfe3d35d80e30 },	//5^107
+	{ 0x3d01cde904199292, 0x1b403dcc834e11bd },	//5^108
+	{ 0x462120b1a28ffb9b, 0x1108269fd210cb16 },	//5^109
+	{ 0xd7a968de0b33fa82, 0x154a3047c694fddb },	//5^110
+	{ 0xcd93c3158e00f923, 0x1a9cbc59b83a3d52 },	//5^111
+	{ 0xc07c59ed78c09bb6, 0x10a1f5b813246653 },	//5^112
+	{ 0xb09b7068d6f0c2a3, 0x14ca732617ed7fe8 },	//5^113
+	{ 0xdcc24c830cacf34c, 0x19fd0fef9de8dfe2 },	//5^114
+	{ 0xc9f96fd1e7ec180f, 0x103e29f5c2b18bed },	//5^115
+	{ 0x3c77cbc661e71e13, 0x144db473335deee9 },	//5^116
+	{ 0x8b95beb7fa60e598, 0x1961219000356aa3 },	//5^117
+	{ 0x6e7b2e65f8f91efe, 0x1fb969f40042c54c },	//5^118
+	{ 0xc50cfcffbb9bb35f, 0x13d3e2388029bb4f },	//5^119
+	{ 0xb6503c3faa82a037, 0x18c8dac6a0342a23 },	//5^120
+	{ 0xa3e44b4f95234844, 0x1efb1178484134ac },	//5^121
+	{ 0xe66eaf11bd360d2b, 0x135ceaeb2d28c0eb },	//5^122
+	{ 0xe00a5ad62c839075, 0x183425a5f872f126 },	//5^123
+	{ 0x980cf18bb7a47493, 0x1e412f0f768fad70 },	//5^124
+	{ 0x5f0816f752c6c8dc, 0x12e8bd69aa19cc66 },	//5^125
+	{ 0xf6ca1cb527787b13, 0x17a2ecc414a03f7f },	//5^126
+	{ 0xf47ca3e2715699d7, 0x1d8ba7f519c84f5f },	//5^127
+	{ 0xf8cde66d86d62026, 0x127748f9301d319b },	//5^128
+	{ 0xf7016008e88ba830, 0x17151b377c247e02 },	//5^129
+	{ 0xb4c1b80b22ae923c, 0x1cda62055b2d9d83 },	//5^130
+	{ 0x50f91306f5ad1b65, 0x12087d4358fc8272 },	//5^131
+	{ 0xe53757c8b318623f, 0x168a9c942f3ba30e },	//5^132
+	{ 0x9e852dbadfde7acf, 0x1c2d43b93b0a8bd2 },	//5^133
+	{ 0xa3133c94cbeb0cc1, 0x119c4a53c4e69763 },	//5^134
+	{ 0x8bd80bb9fee5cff1, 0x16035ce8b6203d3c },	//5^135
+	{ 0xaece0ea87e9f43ee, 0x1b843422e3a84c8b },	//5^136
+	{ 0x4d40c9294f238a75, 0x1132a095ce492fd7 },	//5^137
+	{ 0x2090fb73a2ec6d12, 0x157f48bb41db7bcd },	//5^138
+	{ 0x68b53a508ba78856, 0x1adf1aea12525ac0 },	//5^139
+	{ 0x417144725748b536, 0x10cb70d24b7378b8 },	//5^140
+	{ 0x51cd958eed1ae283, 0x14fe4d06de5056e6 },	//5^141
+	{ 0xe640faf2a8619b24, 0x1a3de04895e46c9f },	//5^142
+	{ 0xefe89cd7a93d00f7, 0x1066ac2d5daec3e3 },	//5^143
+	{ 0xebe2c40d938c4134, 0x14805738b51a74dc },	//5^144
+	{ 0x26db7510f86f5181, 0x19a06d06e2611214 },	//5^145
+	{ 0x9849292a9b4592f1, 0x100444244d7cab4c },	//5^146
+	{ 0xbe5b73754216f7ad, 0x1405552d60dbd61f },	//5^147
+	{ 0xadf25052929cb598, 0x1906aa78b912cba7 },	//5^148
+	{ 0x996ee4673743e2ff, 0x1f485516e7577e91 },	//5^149
+	{ 0xffe54ec0828a6ddf, 0x138d352e5096af1a },	//5^150
+	{ 0xbfdea270a32d0957, 0x18708279e4bc5ae1 },	//5^151
+	{ 0x2fd64b0ccbf84bad, 0x1e8ca3185deb719a },	//5^152
+	{ 0x5de5eee7ff7b2f4c, 0x1317e5ef3ab32700 },	//5^153
+	{ 0x755f6aa1ff59fb1f, 0x17dddf6b095ff0c0 },	//5^154
+	{ 0x92b7454a7f3079e7, 0x1dd55745cbb7ecf0 },	//5^155
+	{ 0x5bb28b4e8f7e4c30, 0x12a5568b9f52f416 },	//5^156
+	{ 0xf29f2e22335ddf3c, 0x174eac2e8727b11b },	//5^157
+	{ 0xef46f9aac035570b, 0x1d22573a28f19d62 },	//5^158
+	{ 0xd58c5c0ab8215667, 0x123576845997025d },	//5^159
+	{ 0x4aef730d6629ac01, 0x16c2d4256ffcc2f5 },	//5^160
+	{ 0x9dab4fd0bfb41701, 0x1c73892ecbfbf3b2 },	//5^161
+	{ 0xa28b11e277d08e60, 0x11c835bd3f7d784f },	//5^162
+	{ 0x8b2dd65b15c4b1f9, 0x163a432c8f5cd663 },	//5^163
+	{ 0x6df94bf1db35de77, 0x1bc8d3f7b3340bfc },	//5^164
+	{ 0xc4bbcf772901ab0a, 0x115d847ad000877d },	//5^165
+	{ 0x35eac354f34215cd, 0x15b4e5998400a95d },	//5^166
+	{ 0x8365742a30129b40, 0x1b221effe500d3b4 },	//5^167
+	{ 0xd21f689a5e0ba108, 0x10f5535fef208450 },	//5^168
+	{ 0x06a742c0f58e894a, 0x1532a837eae8a565 },	//5^169
+	{ 0x4851137132f22b9d, 0x1a7f5245e5a2cebe },	//5^170
+	{ 0xed32ac26bfd75b42, 0x108f936baf85c136 },	//5^171
+	{ 0xa87f57306fcd3212, 0x14b378469b673184 },	//5^172
+	{ 0xd29f2cfc8bc07e97, 0x19e056584240fde5 },	//5^173
+	{ 0xa3a37c1dd7584f1e, 0x102c35f729689eaf },	//5^174
+	{ 0x8c8c5b254d2e62e6, 0x14374374f3c2c65b },	//5^175
+	{ 0x6faf71eea079fb9f, 0x1945145230b377f2 },	//5^176
+	{ 0x0b9b4e6a48987a87, 0x1f965966bce055ef },	//5^177
+	{ 0x674111026d5f4c94, 0x13bdf7e0360c35b5 },	//5^178
+	{ 0xc111554308b71fba, 0x18ad75d8438f4322 },	//5^179
+	{ 0x7155aa93cae4e7a8, 0x1ed8d34e547313eb },	//5^180
+	{ 0x26d58a9c5ecf10c9, 0x13478410f4c7ec73 },	//5^181
+	{ 0xf08aed437682d4fb, 0x1819651531f9e78f },	//5^182
+	{ 0xecada89454238a3a, 0x1e1fbe5a7e786173 },	//5^183
+	{ 0x73ec895cb4963664, 0x12d3d6f88f0b3ce8 },	//5^184
+	{ 0x90e7abb3e1bbc3fd, 0x1788ccb6b2ce0c22 },	//5^185
+	{ 0x352196a0da2ab4fd, 0x1d6affe45f818f2b },	//5^186
+	{ 0x0134fe24885ab11e, 0x1262dfeebbb0f97b },	//5^187
+	{ 0xc1823dadaa715d65, 0x16fb97ea6a9d37d9 },	//5^188
+	{ 0x31e2cd19150db4bf, 0x1cba7de5054485d0 },	//5^189
+	{ 0x1f2dc02fad2890f7, 0x11f48eaf234ad3a2 },	//5^190
+	{ 0xa6f9303b9872b535, 0x1671b25aec1d888a },	//5^191
+	{ 0x50b77c4a7e8f6282, 0x1c0e1ef1a724eaad },	//5^192
+	{ 0x5272adae8f199d91, 0x1188d357087712ac },	//5^193
+	{ 0x670f591a32e004f6, 0x15eb082cca94d757 },	//5^194
+	{ 0x40d32f60bf980633, 0x1b65ca37fd3a0d2d },	//5^195
+	{ 0x4883fd9c77bf03e0, 0x111f9e62fe44483c },	//5^196
+	{ 0x5aa4fd0395aec4d8, 0x156785fbbdd55a4b },	//5^197
+	{ 0x314e3c447b1a760e, 0x1ac1677aad4ab0de },	//5^198
+	{ 0xded0e5aaccf089c9, 0x10b8e0acac4eae8a },	//5^199
+	{ 0x96851f15802cac3b, 0x14e718d7d7625a2d },	//5^200
+	{ 0xfc2666dae037d74a, 0x1a20df0dcd3af0b8 },	//5^201
+	{ 0x9d980048cc22e68e, 0x10548b68a044d673 },	//5^202
+	{ 0x84fe005aff2ba032, 0x1469ae42c8560c10 },	//5^203
+	{ 0xa63d8071bef6883e, 0x198419d37a6b8f14 },	//5^204
+	{ 0xcfcce08e2eb42a4e, 0x1fe52048590672d9 },	//5^205
+	{ 0x21e00c58dd309a70, 0x13ef342d37a407c8 },	//5^206
+	{ 0x2a580f6f147cc10d, 0x18eb0138858d09ba },	//5^207
+	{ 0xb4ee134ad99bf150, 0x1f25c186a6f04c28 },	//5^208
+	{ 0x7114cc0ec80176d2, 0x137798f428562f99 },	//5^209
+	{ 0xcd59ff127a01d486, 0x18557f31326bbb7f },	//5^210
+	{ 0xc0b07ed7188249a8, 0x1e6adefd7f06aa5f },	//5^211
+	{ 0xd86e4f466f516e09, 0x1302cb5e6f642a7b },	//5^212
+	{ 0xce89e3180b25c98b, 0x17c37e360b3d351a },	//5^213
+	{ 0x822c5bde0def3bee, 0x1db45dc38e0c8261 },	//5^214
+	{ 0xf15bb96ac8b58575, 0x1290ba9a38c7d17c },	//5^215
+	{ 0x2db2a7c57ae2e6d2, 0x1734e940c6f9c5dc },	//5^216
+	{ 0x391f51b6d99ba086, 0x1d022390f8b83753 },	//5^217
+	{ 0x03b3931248014454, 0x1221563a9b732294 },	//5^218
+	{ 0x04a077d6da019569, 0x16a9abc9424feb39 },	//5^219
+	{ 0x45c895cc9081fac3, 0x1c5416bb92e3e607 },	//5^220
+	{ 0x8b9d5d9fda513cba, 0x11b48e353bce6fc4 },	//5^221
+	{ 0xae84b507d0e58be8, 0x1621b1c28ac20bb5 },	//5^222
+	{ 0x1a25e249c51eeee3, 0x1baa1e332d728ea3 },	//5^223
+	{ 0xf057ad6e1b33554d, 0x114a52dffc679925 },	//5^224
+	{ 0x6c6d98c9a2002aa1, 0x159ce797fb817f6f },	//5^225
+	{ 0x4788fefc0a803549, 0x1b04217dfa61df4b },	//5^226
+	{ 0x0cb59f5d8690214e, 0x10e294eebc7d2b8f },	//5^227
+	{ 0xcfe30734e83429a1, 0x151b3a2a6b9c7672 },	//5^228
+	{ 0x83dbc9022241340a, 0x1a6208b50683940f },	//5^229
+	{ 0xb2695da15568c086, 0x107d457124123c89 },	//5^230
+	{ 0x1f03b509aac2f0a7, 0x149c96cd6d16cbac },	//5^231
+	{ 0x26c4a24c1573acd1, 0x19c3bc80c85c7e97 },	//5^232
+	{ 0x783ae56f8d684c03, 0x101a55d07d39cf1e },	//5^233
+	{ 0x16499ecb70c25f03, 0x1420eb449c8842e6 },	//5^234
+	{ 0x9bdc067e4cf2f6c4, 0x19292615c3aa539f },	//5^235
+	{ 0x82d3081de02fb476, 0x1f736f9b3494e887 },	//5^236
+	{ 0xb1c3e512ac1dd0c9, 0x13a825c100dd1154 },	//5^237
+	{ 0xde34de57572544fc, 0x18922f31411455a9 },	//5^238
+	{ 0x55c215ed2cee963b, 0x1eb6bafd91596b14 },	//5^239
+	{ 0xb5994db43c151de5, 0x133234de7ad7e2ec },	//5^240
+	{ 0xe2ffa1214b1a655e, 0x17fec216198ddba7 },	//5^241
+	{ 0xdbbf89699de0feb6, 0x1dfe729b9ff15291 },	//5^242
+	{ 0x2957b5e202ac9f31, 0x12bf07a143f6d39b },	//5^243
+	{ 0xf3ada35a8357c6fe, 0x176ec98994f48881 },	//5^244
+	{ 0x70990c31242db8bd, 0x1d4a7bebfa31aaa2 },	//5^245
+	{ 0x865fa79eb69c9376, 0x124e8d737c5f0aa5 },	//5^246
+	{ 0xe7f791866443b854, 0x16e230d05b76cd4e },	//5^247
+	{ 0xa1f575e7fd54a669, 0x1c9abd04725480a2 },	//5^248
+	{ 0xa53969b0fe54e801, 0x11e0b622c774d065 },	//5^249
+	{ 0x0e87c41d3dea2202, 0x1658e3ab7952047f },	//5^250
+	{ 0xd229b5248d64aa82, 0x1bef1c9657a6859e },	//5^251
+	{ 0x435a1136d85eea91, 0x117571ddf6c81383 },	//5^252
+	{ 0x143095848e76a536, 0x15d2ce55747a1864 },	//5^253
+	{ 0x193cbae5b2144e83, 0x1b4781ead1989e7d },	//5^254
+	{ 0x2fc5f4cf8f4cb112, 0x110cb132c2ff630e },	//5^255
+	{ 0xbbb77203731fdd56, 0x154fdd7f73bf3bd1 },	//5^256
+	{ 0x2aa54e844fe7d4ac, 0x1aa3d4df50af0ac6 },	//5^257
+	{ 0xdaa75112b1f0e4eb, 0x10a6650b926d66bb },	//5^258
+	{ 0xd15125575e6d1e26, 0x14cffe4e7708c06a },	//5^259
+	{ 0x85a56ead360865b0, 0x1a03fde214caf085 },	//5^260
+	{ 0x7387652c41c53f8e, 0x10427ead4cfed653 },	//5^261
+	{ 0x50693e7752368f71, 0x14531e58a03e8be8 },	//5^262
+	{ 0x64838e1526c4334e, 0x1967e5eec84e2ee2 },	//5^263
+	{ 0xfda4719a70754022, 0x1fc1df6a7a61ba9a },	//5^264
+	{ 0xde86c70086494815, 0x13d92ba28c7d14a0 },	//5^265
+	{ 0x162878c0a7db9a1a, 0x18cf768b2f9c59c9 },	//5^266
+	{ 0x5bb296f0d1d280a1, 0x1f03542dfb83703b },	//5^267
+	{ 0x194f9e5683239064, 0x1362149cbd322625 },	//5^268
+	{ 0x5fa385ec23ec747e, 0x183a99c3ec7eafae },	//5^269
+	{ 0xf78c67672ce7919d, 0x1e494034e79e5b99 },	//5^270
+	{ 0x3ab7c0a07c10bb02, 0x12edc82110c2f940 },	//5^271
+	{ 0x4965b0c89b14e9c3, 0x17a93a2954f3b790 },	//5^272
+	{ 0x5bbf1cfac1da2433, 0x1d9388b3aa30a574 },	//5^273
+	{ 0xb957721cb92856a0, 0x127c35704a5e6768 },	//5^274
+	{ 0xe7ad4ea3e7726c48, 0x171b42cc5cf60142 },	//5^275
+	{ 0xa198a24ce14f075a, 0x1ce2137f74338193 },	//5^276
+	{ 0x44ff65700cd16498, 0x120d4c2fa8a030fc },	//5^277
+	{ 0x563f3ecc1005bdbe, 0x16909f3b92c83d3b },	//5^278
+	{ 0x2bcf0e7f14072d2e, 0x1c34c70a777a4c8a },	//5^279
+	{ 0x5b61690f6c847c3d, 0x11a0fc668aac6fd6 },	//5^280
+	{ 0xf239c35347a59b4c, 0x16093b802d578bcb },	//5^281
+	{ 0xeec83428198f021f, 0x1b8b8a6038ad6ebe },	//5^282
+	{ 0x553d20990ff96153, 0x1137367c236c6537 },	//5^283
+	{ 0x2a8c68bf53f7b9a8, 0x1585041b2c477e85 },	//5^284
+	{ 0x752f82ef28f5a812, 0x1ae64521f7595e26 },	//5^285
+	{ 0x093db1d57999890b, 0x10cfeb353a97dad8 },	//5^286
+	{ 0x0b8d1e4ad7ffeb4e, 0x1503e602893dd18e },	//5^287
+	{ 0x8e7065dd8dffe622, 0x1a44df832b8d45f1 },	//5^288
+	{ 0xf9063faa78bfefd5, 0x106b0bb1fb384bb6 },	//5^289
+	{ 0xb747cf9516efebca, 0x1485ce9e7a065ea4 },	//5^290
+	{ 0xe519c37a5cabe6bd, 0x19a742461887f64d },	//5^291
+	{ 0xaf301a2c79eb7036, 0x1008896bcf54f9f0 },	//5^292
+	{ 0xdafc20b798664c43, 0x140aabc6c32a386c },	//5^293
+	{ 0x11bb28e57e7fdf54, 0x190d56b873f4c688 },	//5^294
+	{ 0x1629f31ede1fd72a, 0x1f50ac6690f1f82a },	//5^295
+	{ 0x4dda37f34ad3e67a, 0x13926bc01a973b1a },	//5^296
+	{ 0xe150c5f01d88e019, 0x187706b0213d09e0 },	//5^297
+	{ 0x19a4f76c24eb181f, 0x1e94c85c298c4c59 },	//5^298
+	{ 0xb0071aa39712ef13, 0x131cfd3999f7afb7 },	//5^299
+	{ 0x9c08e14c7cd7aad8, 0x17e43c8800759ba5 },	//5^300
+	{ 0x030b199f9c0d958e, 0x1ddd4baa0093028f },	//5^301
+	{ 0x61e6f003c1887d79, 0x12aa4f4a405be199 },	//5^302
+	{ 0xba60ac04b1ea9cd7, 0x1754e31cd072d9ff },	//5^303
+	{ 0xa8f8d705de65440d, 0x1d2a1be4048f907f },	//5^304
+	{ 0xc99b8663aaff4a88, 0x123a516e82d9ba4f },	//5^305
+	{ 0xbc0267fc95bf1d2a, 0x16c8e5ca239028e3 },	//5^306
+	{ 0xab0301fbbb2ee474, 0x1c7b1f3cac74331c },	//5^307
+	{ 0xeae1e13d54fd4ec9, 0x11ccf385ebc89ff1 },	//5^308
+	{ 0x659a598caa3ca27b, 0x1640306766bac7ee },	//5^309
+	{ 0xff00efefd4cbcb1a, 0x1bd03c81406979e9 },	//5^310
+	{ 0x3f6095f5e4ff5ef0, 0x116225d0c841ec32 },	//5^311
+	{ 0xcf38bb735e3f36ac, 0x15baaf44fa52673e },	//5^312
+	{ 0x8306ea5035cf0457, 0x1b295b1638e7010e },	//5^313
+	{ 0x11e4527221a162b6, 0x10f9d8ede39060a9 },	//5^314
+	{ 0x565d670eaa09bb64, 0x15384f295c7478d3 },	//5^315
+	{ 0x2bf4c0d2548c2a3d, 0x1a8662f3b3919708 },	//5^316
+	{ 0x1b78f88374d79a66, 0x1093fdd8503afe65 },	//5^317
+	{ 0x625736a4520d8100, 0x14b8fd4e6449bdfe },	//5^318
+	{ 0xfaed044d6690e140, 0x19e73ca1fd5c2d7d },	//5^319
+	{ 0xbcd422b0601a8cc8, 0x103085e53e599c6e },	//5^320
+	{ 0x6c092b5c78212ffa, 0x143ca75e8df0038a },	//5^321
+	{ 0x070b763396297bf8, 0x194bd136316c046d },	//5^322
+	{ 0x48ce53c07bb3daf6, 0x1f9ec583bdc70588 },	//5^323
+	{ 0x2d80f4584d5068da, 0x13c33b72569c6375 },	//5^324
+	{ 0x78e1316e60a48310, 0x18b40a4eec437c52 },	//5^325
+};
+
 //---------------------------------------------------------------------------------
@@ -25,6 +25,8 @@
 #include <stdio.h>
 #include <stdbool.h>	//bool
 #include <stddef.h>		//size_t
+#include <stdint.h>		//int64_t, uint64_t
+#include <string.h>		//strlen
 
 //TODO: Improve overall UTF8 support
 
@@ -40,14 +42,45 @@
 
 /** String type that can grow when necessary. Supports many common operations
 	like search, replace, compare, split or trim. Supports UTF-8 strings.
+
+	All operations use the stored length instead of looking for the 0 terminator, so
+	strings created with wstring_newBytes() or wstring_fromView() may also contain 0
+	bytes. Only the functions taking C strings stop at the first 0 byte of these.
 */
 typedef struct WString {
 	char*	cstring;	///<Public member: A 0-terminated C string, may contain UTF8 characters.
 	size_t	size;		//<Private member: Do not use. Number of contained UTF8 characters excluding the 0 terminator
 	size_t	sizeBytes;	//<Private member: Do not use. Number of contained bytes including the 0 terminator
 	size_t	capacity;	//<Private member: Do not use. Maximum number of bytes including the 0 terminator. If sizeBytes > capacity, cstring must be realloced.
+	struct WStringCharacterIndex*	index;	//<Private member: Do not use. Byte offsets of some characters for wstring_at(), or NULL.
 }WString;
 
+/**	A read-only range of bytes, for example a part of a string or of a buffer.
+
+	Views do not own their bytes and are not 0-terminated. They are cheap to copy and
+	are passed by value.
+*/
+typedef struct WStringView {
+	const char*	bytes;		///<Start of the viewed bytes
+	size_t		length;		///<Number of viewed bytes
+}WStringView;
+
+/**	How strings grow when they need more capacity. See wstring_setGrowthPolicy().
+*/
+typedef struct WStringGrowthPolicy {
+	double	factor;				///<The old capacity is multiplied by this factor, at least 1. Default 2.
+	size_t	maximumGrowth;		///<At most this many bytes are added at once, 0 for no limit. Default 0.
+	size_t	defaultCapacity;	///<Capacity of new strings that get capacity 0. Default 100.
+	bool	sizeClasses;		///<Round capacities up to the size classes of common allocators. Default false.
+}WStringGrowthPolicy;
+
+/**	A compact summary of the byte pairs of a string, to reject substring searches
+	without reading the string. See wstring_signature().
+*/
+typedef struct WStringSignature {
+	uint64_t	bits[4];	///<One bit per hash value of a byte pair
+}WStringSignature;
+
 //---------------------------------------------------------------------------------
 //	String creation and destruction
 //---------------------------------------------------------------------------------
@@ -57,6 +90,15 @@ typedef struct WString {
 WString*
 wstring_new( const char cstring[], size_t capacity );
 
+/**	Create a string from a byte range, which may contain 0 bytes.
+
+	@param bytes Need not be 0-terminated
+	@param length Number of bytes
+	@return A new string, 0-terminated behind the bytes
+*/
+WString*
+wstring_newBytes( const char bytes[], size_t length );
+
 /**	Create a string from a C string.
 */
 WString*
@@ -94,10 +136,65 @@ wstring_clear( WString* string );
 char*
 wstring_steal( WString** stringPointer );
 
+/**	Create a string that takes over a buffer allocated with malloc(), without copying it.
+	The opposite of wstring_steal().
+
+	Example:
+	\code
+	char* buffer = malloc( 4096 );
+	ssize_t n = read( fd, buffer, 4095 );
+	WString* string = wstring_adopt( buffer, n, 4096 );
+	\endcode
+
+	@param buffer Freed by the string later, may contain 0 bytes
+	@param length Number of used bytes
+	@param capacity Number of allocated bytes. If there is no room for the 0 terminator
+		behind the used bytes, the buffer is reallocated.
+	@return A new string
+*/
+WString*
+wstring_adopt( char* buffer, size_t length, size_t capacity );
+
+/**	Create a string on a read-only memory mapping of a file, without reading or copying it.
+
+	The pages of the file are read when they are used. Functions that need the number of
+	characters, like wstring_size(), count them on first use. Because this count is stored
+	in the string, a mapped string must not be read by different threads at the same time
+	until it has been counted, for example by calling wstring_size() once before sharing
+	it. The first change of the string copies its text to the heap and releases the
+	mapping. The file must not be truncated as long as it is mapped.
+
+	Example:
+	\code
+	WString* reference = wstring_mapFile( "reference.txt" );
+	if ( reference == NULL )
+		perror( "reference.txt" );
+	\endcode
+
+	@param path A regular file, which may contain 0 bytes
+	@return A new string, or NULL with errno set if the file could not be mapped
+*/
+WString*
+wstring_mapFile( const char path[] );
+
+/**	Copy the text of a string created by wstring_mapFile() to the heap and release the
+	mapping. Does nothing for other strings.
+
+	@param string
+	@return string
+*/
+WString*
+wstring_unmap( WString* string );
+
+/**	Return whether the text of the string is still a mapped file.
+*/
+bool
+wstring_mapped( const WString* string );
+
 /**	Returns a copy of the contained char*.
 
 	@param string
-	@return The copied char*
+	@return The copied char*, with all wstring_sizeBytes() bytes of the string
 */
 char*
 wstring_cstring( const WString* string );
@@ -107,6 +204,28 @@ wstring_cstring( const WString* string );
 void
 wstring_assign( WString** stringPointer, WString* other );
 
+/**	Exchange the texts of two strings without copying them.
+*/
+void
+wstring_swap( WString* string, WString* other );
+
+/**	Create a string from the bytes of a view, which may contain 0 bytes.
+*/
+WString*
+wstring_fromView( WStringView view );
+
+/**	Return a view on the whole text of a string.
+
+	The view is valid as long as the string is not changed.
+*/
+static inline WStringView
+wstring_view( const WString* string ) { return (WStringView){ string->cstring, string->sizeBytes - 1 }; }
+
+/**	Return a view on a C string without its 0 terminator.
+*/
+static inline WStringView
+wstring_viewc( const char cstring[] ) { return (WStringView){ cstring, strlen( cstring ) }; }
+
 //---------------------------------------------------------------------------------
 
 /**	Return the number of UTF8 characters
@@ -119,6 +238,46 @@ wstring_size( const WString* string );
 size_t
 wstring_sizeBytes( const WString* string );
 
+/**	Return the number of allocated bytes, at least wstring_sizeBytes(), or 0 while the
+	text is a mapped file.
+*/
+size_t
+wstring_capacity( const WString* string );
+
+/**	Make sure that the string can grow to a number of bytes without reallocation.
+
+	@param string
+	@param capacity Number of bytes including the 0 terminator
+	@return string
+*/
+WString*
+wstring_reserve( WString* string, size_t capacity );
+
+/**	Release the unused capacity of the string, for example of long-lived strings after
+	wstring_trim(), wstring_truncate() or wstring_clear().
+
+	@param string
+	@return string
+*/
+WString*
+wstring_shrinkToFit( WString* string );
+
+/**	Set how all strings grow when their capacity is exhausted.
+
+	Growing by a smaller factor or by at most maximumGrowth bytes wastes less memory in
+	big strings, but reallocates more often while they grow. Rounding to size classes
+	uses the bytes that the allocator would add anyway.
+
+	The policy is global. Set it at program start, before other threads use strings.
+*/
+void
+wstring_setGrowthPolicy( WStringGrowthPolicy policy );
+
+/**	Return the current growth policy.
+*/
+WStringGrowthPolicy
+wstring_growthPolicy( void );
+
 /**	Check if the string is empty.
 */
 bool
@@ -138,20 +297,28 @@ wstring_nonEmpty( const WString* string ) { return !wstring_empty( string ); }
 bool
 wstring_equals( const WString* string, const WString* other );
 
-/**	Compare two strings with each other.
+/**	Compare two strings with each other byte by byte, like memcmp(). If one string
+	is a prefix of the other, it comes first.
 
 	@param string
 	@param other
-	@return
+	@return <0, 0 or >0
 */
 int
 wstring_compare( const WString* string, const WString* other );
 
 /**	Compare two strings with each other ignoring case differences.
 
+	Blocks of ASCII characters are compared 8 bytes at a time. Other characters are
+	compared after towlower(), so it basically works for non-ASCII characters with the
+	known limitations of the wchar_t functions. The order is the order of the lower case
+	characters, like with wstring_sortKey() and WStringCollationIgnoreCase.
+
 	@param string
 	@param other
-	@return
+	@return <0, 0 or >0 like wstring_compare()
+	@pre string != NULL
+	@pre other != NULL
 */
 int
 wstring_compareCase( const WString* string, const WString* other );
@@ -181,6 +348,32 @@ wstring_similarity( const WString* string, const WString* other );
 bool
 wstring_contains( const WString* string, const WString* other );
 
+/**	Check if a string contains another string, ignoring case differences.
+
+	Compares like wstring_compareCase(). Skips 8 bytes at a time to the possible
+	starts of a match.
+
+	@param string
+	@param other
+	@return
+	@pre string != NULL
+	@pre other != NULL
+*/
+bool
+wstring_containsCase( const WString* string, const WString* other );
+
+/**	Find the first match of another string in a string, ignoring case differences.
+
+	@param string
+	@param other The string to be searched for
+	@return The matching part of string. It may be longer or shorter than other, if
+		upper and lower case characters differ in length. NULL bytes if not found.
+	@pre string != NULL
+	@pre other != NULL
+*/
+WStringView
+wstring_findCase( const WString* string, const WString* other );
+
 /**	Check if a string starts with another string.
 
 	@param string
@@ -199,6 +392,62 @@ wstring_startsWith( const WString* string, const WString* other );
 bool
 wstring_endsWith( const WString* string, const WString* other );
 
+/**	Compute a 64 bit hash value of a string, for example for hash tables.
+
+	Reads 16 bytes at a time. Not suitable for cryptographic purposes.
+
+	@param string
+	@return The hash value, equal strings have equal hash values
+*/
+uint64_t
+wstring_hash( const WString* string );
+
+/**	Compute the hash value of a view.
+
+	@param view
+	@return The hash value, equal to the one of a string with the same text
+*/
+uint64_t
+wstring_hashView( WStringView view );
+
+/**	Compute the signature of a string: a Bloom filter of 256 bits with one bit for the
+	hash of each pair of neighbouring bytes (bigram).
+
+	A string can only contain another string if its signature has all bits of the
+	other's signature, so most strings not containing a search string are rejected by
+	wstring_signatureMayContain() with a few word operations. Compute the signatures of
+	stored strings once and check them before each search.
+
+	Strings with up to about 100 different byte pairs reject well. Search strings with
+	less than 2 bytes have an empty signature and are never rejected.
+
+	@param string
+	@return The signature
+*/
+WStringSignature
+wstring_signature( const WString* string );
+
+/**	Compute the signature of the bytes of a view, like wstring_signature().
+*/
+WStringSignature
+wstring_signatureView( WStringView view );
+
+/**	Check if a string may contain a search string, by their signatures.
+
+	@param signature The signature of the string
+	@param searchSignature The signature of the search string
+	@return false if the string cannot contain the search string, else true
+*/
+static inline bool
+wstring_signatureMayContain( const WStringSignature* signature, const WStringSignature* searchSignature )
+{
+	uint64_t missing = 0;
+	for ( int i = 0; i < 4; i++ )
+		missing |= searchSignature->bits[i] & ~signature->bits[i];
+
+	return missing == 0;
+}
+
 //---------------------------------------------------------------------------------
 
 /**	Append a string to another string.
@@ -210,6 +459,16 @@ wstring_endsWith( const WString* string, const WString* other );
 WString*
 wstring_append( WString* string, const WString* other );
 
+/**	Append a string and destroy it. Instead of copying, its buffer is taken over if
+	string is empty, or if it has room for both texts while string has not.
+
+	@param string The string the other string gets appended to
+	@param otherPointer The appended string, destroyed and set to NULL
+	@return string
+*/
+WString*
+wstring_appendMove( WString* string, WString** otherPointer );
+
 /**	Prepend a string before another string.
 */
 WString*
@@ -236,6 +495,11 @@ wstring_appendn( WString* string, size_t n, const char buffer[] );
 
 /**	Appends a printf-like string to another string.
 
+	The text is formatted directly into the unused capacity of the string. Only if it
+	does not fit, the string grows and the text is formatted a second time. Only string
+	values ("%s") that point into the string itself are formatted into a temporary buffer
+	first, so they are allowed too.
+
 	@param string The string the other string gets appended to.
 	@param format Format string like in printf()
 	@param ... one or more values according to the format string
@@ -244,16 +508,142 @@ wstring_appendn( WString* string, size_t n, const char buffer[] );
 WString*
 wstring_appendf( WString* string, const char format[], ... ) PRINTF(2, 3);
 
-//String*
-//TODO: wstring_insert( String* string, size_t position );
+/**	Replaces the text of a string by a printf-like string.
+
+	Like wstring_printf(), but reuses the already allocated memory of the string.
+	The values may point into the string itself.
+
+	@param string The string that gets the new text.
+	@param format Format string like in printf()
+	@param ... one or more values according to the format string
+	@return string
+*/
+WString*
+wstring_setf( WString* string, const char format[], ... ) PRINTF(2, 3);
+
+/**	Appends a signed integer as decimal number.
+
+	Faster than wstring_appendf( string, "%lld", value ), because the digits are written
+	directly into the string without any format parsing or temporary buffers.
+
+	@param string The string the number gets appended to.
+	@param value
+	@return string
+*/
+WString*
+wstring_appendInt( WString* string, int64_t value );
+
+/**	Appends an unsigned integer as decimal number.
+
+	@param string The string the number gets appended to.
+	@param value
+	@return string
+*/
+WString*
+wstring_appendUint( WString* string, uint64_t value );
+
+/**	Appends a double with the shortest number of digits that still parse back to the
+	same double.
+
+	The notation follows printf's "%g": Plain decimal notation like "0.1" or "1234.5"
+	for decimal exponents from -4 to 16, otherwise exponential notation like "1.5e+300".
+	Infinity and NaN are written as "inf", "-inf" and "nan". Uses the Ryu algorithm,
+	so no vsnprintf() is involved and the result is independent of the locale.
+
+	@param string The string the number gets appended to.
+	@param value
+	@return string
+*/
+WString*
+wstring_appendDouble( WString* string, double value );
+
+/**	Join many strings into a new string, with a separator between each two of them.
+
+	The size of the result is computed first, so it is allocated exactly once and
+	each part is copied exactly once.
+
+	@param separator Put between each two strings, may be ""
+	@param strings Array of strings
+	@param n Number of strings in the array
+	@return A new string
+
+	Example:
+	\code
+	WString* words[] = { wstring_dup( "Weiße" ), wstring_dup( "Möhren" ) };
+	WString* joined = wstring_join( ", ", words, 2 );
+	assert( strcmp( joined->cstring, "Weiße, Möhren" ) == 0 );
+	\endcode
+*/
+WString*
+wstring_join( const char separator[], WString* const strings[], size_t n );
+
+/**	Join many views into a new string, with a separator between each two of them.
+
+	Like wstring_join(), but for views.
+
+	@param separator Put between each two views
+	@param views Array of views
+	@param n Number of views in the array
+	@return A new string
+*/
+WString*
+wstring_joinViews( WStringView separator, const WStringView views[], size_t n );
+
+/**	Insert a text before a character position.
+
+	Moves the rest of the string. For many edits near one place see WStringGapBuffer.
+
+	@param string
+	@param position Character position, at most wstring_size()
+	@param text
+	@return The string
+*/
+WString*
+wstring_insert( WString* string, size_t position, const char text[] );
+
+/**	Remove characters from a character position on.
+
+	@param string
+	@param position Character position, at most wstring_size()
+	@param length Number of characters, cut at the end of the string
+	@return The string
+*/
+WString*
+wstring_erase( WString* string, size_t position, size_t length );
 
 //---------------------------------------------------------------------------------
 
-//uint32_t
-//TODO: wstring_at( const String* string, size_t position );
+/**	Return the character at a character position as a Unicode code point.
 
-//String*
-//TODO: wstring_slice( const String* string, size_t start, size_t end );
+	Pure ASCII strings are indexed directly. For other strings the byte offsets of every
+	64th character are collected on first use, so that later calls only step over a
+	few characters. Functions that change the string drop these offsets again, except
+	for appending. Because of this cache, the same string must not be read with
+	wstring_at() or wstring_slice() by different threads at the same time.
+
+	@param string
+	@param position Character position, less than wstring_size()
+	@return The code point
+*/
+uint32_t
+wstring_at( const WString* string, size_t position );
+
+/**	Create a string with the characters from start up to end.
+
+	Positions are cut at the end of the string. Uses the same cache as wstring_at().
+
+	Example:
+	\code
+	WString* slice = wstring_slice( string, 1, 4 );	//"rüß" of "Grüße"
+	\endcode
+
+	@param string
+	@param start Character position of the first character
+	@param end Character position after the last character
+	@return A new string
+*/
+WString*
+wstring_slice( const WString* string, size_t start, size_t end );
 
 
 //---------------------------------------------------------------------------------
@@ -278,6 +668,17 @@ wstring_replace( WString* string, const char search[], const char replace[] );
 WString*
 wstring_replaceAll( WString* string, const char search[], const char replace[] );
 
+/**	Replaces all matches of a search string with a replacement string, ignoring case
+	differences like wstring_compareCase().
+
+	@param string
+	@param search Nothing is replaced if it is empty
+	@param replace
+	@return
+*/
+WString*
+wstring_replaceAllCase( WString* string, const char search[], const char replace[] );
+
 //---------------------------------------------------------------------------------
 
 /**	Remove characters from the start and end.
@@ -423,8 +824,61 @@ wstring_split( const WString* string, const char delimiters[], void foreach( con
 
 //---------------------------------------------------------------------------------
 
+/**	Sort an array of strings in the order of wstring_compare().
+
+	Uses multikey quicksort on cached 8 byte prefixes of the strings. Common prefixes
+	are therefore compared 8 bytes at a time and only once per partition, instead of
+	from the first byte in every comparison like with qsort() and wstring_compare().
+	The sort is not stable.
+
+	@param strings The array of strings, gets sorted in place
+	@param n Number of strings in the array
+*/
+void
+wstring_sortArray( WString* strings[], size_t n );
+
+/**	Collations for wstring_sortKey().
+*/
+typedef enum WStringCollation {
+	WStringCollationIgnoreCase,	///<Order of the lower case strings, like wstring_compare() after wstring_toLower()
+	WStringCollationSimple,		///<Ignores accents and case first, then accents only, then nothing
+}WStringCollation;
+
+/**	Create a sort key of a string: The byte order of the keys, like with memcmp(),
+	wstring_compare() or wstring_sortArray(), is the order of the strings in the collation.
+
+	Computing the keys once is much cheaper than folding the case again in every
+	comparison, for example when sorting repeatedly or searching in sorted ranges. Compare
+	the keys with wstring_compare(), so that prefixes sort first. Keys of strings with 0
+	bytes contain 0 bytes too, so the 0 terminator does not mark their end.
+
+	WStringCollationSimple builds a key of three levels, like the Unicode collation
+	algorithm, separated by the byte 0x01:
+	- The lower case base letters: the accents of the Latin-1 and Latin Extended-A letters
+	  are removed, and ß, æ, œ etc. become ss, ae, oe. Control characters are ignored.
+	- The lower case letters with accents. Control characters are ignored.
+	- The original string, so upper case sorts before lower case.
+
+	So "Apfel" < "Äpfel" < "äpfel" < "apple" < "Bar" < "bar" < "Bär".
+
+	Uses internally the wchar_t standard library functions for non-ASCII characters,
+	like wstring_toLower().
+
+	@param string The string
+	@param collation The wanted order
+	@return The key, a new string
+	@pre string != NULL
+*/
+WString*
+wstring_sortKey( const WString* string, WStringCollation collation );
+
+//---------------------------------------------------------------------------------
+
 /**	Parse a string and convert it to an integer.
 
+	Leading whitespace is skipped, trailing characters are ignored. Independent of the
+	locale, see wstring_parseInt64().
+
 	@param string
 	@return The resulting integer or INT_MIN if the string could not be parsed.
 */
@@ -433,6 +887,9 @@ wstring_toInt( const WString* string );
 
 /**	Parse a string and convert it to a double.
 
+	Leading whitespace is skipped, trailing characters are ignored. Independent of the
+	locale, see wstring_parseDouble().
+
 	@param string
 	@return The resulting double or NAN if the string could not be parsed.
 
@@ -452,4 +909,291 @@ wstring_toDouble( const WString* string );
 
 //---------------------------------------------------------------------------------
 
+/**	Result of the wstring_parseXyz() functions.
+*/
+typedef enum WStringParseStatus {
+	WStringParseOk = 0,			///<A number was parsed.
+	WStringParseNoNumber,		///<The bytes do not start with a number, nothing was consumed.
+	WStringParseOutOfRange,		///<A number was parsed, but it does not fit into the result type.
+}WStringParseStatus;
+
+/**	Parse a decimal signed 64 bit integer from a byte range.
+
+	Independent of the locale and does not touch errno. Accepts an optional '+' or '-'
+	followed by decimal digits. Leading whitespace is not skipped. Parsing stops at the
+	first byte that is not a digit. Eight digits at a time are parsed in parallel.
+
+	@param bytes Start of the byte range, does not need to be 0-terminated
+	@param length Number of bytes in the range
+	@param value Receives the number. Saturates to INT64_MIN/INT64_MAX if out of range.
+	@param consumed Optional, receives the number of bytes belonging to the number
+	@return WStringParseOk, WStringParseNoNumber or WStringParseOutOfRange
+
+	Example:
+	\code
+	const char field[] = "-1234;5678";
+	int64_t value;
+	size_t consumed;
+	if ( wstring_parseInt64( field, strlen( field ), &value, &consumed ) == WStringParseOk )
+		assert( value == -1234 and consumed == 5 );
+	\endcode
+*/
+WStringParseStatus
+wstring_parseInt64( const char bytes[], size_t length, int64_t* value, size_t* consumed );
+
+/**	Parse a decimal unsigned 64 bit integer from a byte range.
+
+	Like wstring_parseInt64(), but accepts no '-' sign.
+
+	@param bytes Start of the byte range, does not need to be 0-terminated
+	@param length Number of bytes in the range
+	@param value Receives the number. Saturates to UINT64_MAX if out of range.
+	@param consumed Optional, receives the number of bytes belonging to the number
+	@return WStringParseOk, WStringParseNoNumber or WStringParseOutOfRange
+*/
+WStringParseStatus
+wstring_parseUint64( const char bytes[], size_t length, uint64_t* value, size_t* consumed );
+
+/**	Parse a hexadecimal unsigned 64 bit integer from a byte range.
+
+	Accepts an optional "0x" or "0X" prefix followed by the digits 0-9, a-f and A-F.
+	No sign is accepted.
+
+	@param bytes Start of the byte range, does not need to be 0-terminated
+	@param length Number of bytes in the range
+	@param value Receives the number. Saturates to UINT64_MAX if out of range.
+	@param consumed Optional, receives the number of bytes belonging to the number
+	@return WStringParseOk, WStringParseNoNumber or WStringParseOutOfRange
+*/
+WStringParseStatus
+wstring_parseHex( const char bytes[], size_t length, uint64_t* value, size_t* consumed );
+
+/**	Parse a decimal floating point number from a byte range.
+
+	Independent of the locale, the decimal separator is always '.'. Accepts an optional
+	sign, digits with an optional fraction and an optional exponent ("-12.5e-3"), as well
+	as "inf", "infinity" and "nan" in any case. Leading whitespace is not skipped.
+
+	The result is always correctly rounded. Uses the Eisel-Lemire algorithm, which needs
+	no big number arithmetic for the vast majority of inputs.
+
+	@param bytes Start of the byte range, does not need to be 0-terminated
+	@param length Number of bytes in the range
+	@param value Receives the number. Is +/-INFINITY if out of range.
+	@param consumed Optional, receives the number of bytes belonging to the number
+	@return WStringParseOk, WStringParseNoNumber or WStringParseOutOfRange
+*/
+WStringParseStatus
+wstring_parseDouble( const char bytes[], size_t length, double* value, size_t* consumed );
+
+//---------------------------------------------------------------------------------
+//	Templates
+//---------------------------------------------------------------------------------
+
+/**	A format string compiled once into literal text and typed placeholders, so that it
+	can be rendered many times without parsing the format again.
+
+	Placeholders are written in braces. They are either positional, "{}" for the next
+	value or "{2}" for the value with index 2, or named like "{user}". Positional and
+	named placeholders cannot be mixed in one template. Named values get their index
+	in the order of their first appearance, see wstringtemplate_index().
+
+	The type of a value follows after a colon, the default is a C string:
+	- {:s} C string, WStringValue.cstring
+	- {:S} WString, WStringValue.string
+	- {:d} Signed integer, WStringValue.i
+	- {:u} Unsigned integer, WStringValue.u
+	- {:g} Double in the shortest form, like wstring_appendDouble(), WStringValue.d
+
+	"{{" and "}}" stand for literal braces.
+*/
+typedef struct WStringTemplate WStringTemplate;
+
+/**	A value for a placeholder of a WStringTemplate.
+*/
+typedef union WStringValue {
+	const char*		cstring;	///<For {:s}
+	const WString*	string;		///<For {:S}
+	int64_t			i;			///<For {:d}
+	uint64_t		u;			///<For {:u}
+	double			d;			///<For {:g}
+}WStringValue;
+
+/**	Compile a format string into a template.
+
+	@param format The format string, see WStringTemplate
+	@return The new template or NULL if the format string is malformed.
+
+	Example:
+	\code
+	WStringTemplate* logLine = wstringtemplate_new( "{method} {path} -> {status:d} in {time:g}s\n" );
+	WString* line = wstring_new( "", 0 );
+
+	wstring_appendTemplate( line, logLine, (WStringValue[]){
+		{ .cstring = "GET" }, { .cstring = "/index.html" }, { .i = 200 }, { .d = 0.25 }
+	});
+	assert( strcmp( line->cstring, "GET /index.html -> 200 in 0.25s\n" ) == 0 );
+	\endcode
+*/
+WStringTemplate*
+wstringtemplate_new( const char format[] );
+
+/**	Destroys a template.
+*/
+void
+wstringtemplate_delete( WStringTemplate** stringTemplatePointer );
+
+/**	Return the number of values the template needs for rendering.
+*/
+size_t
+wstringtemplate_countValues( const WStringTemplate* stringTemplate );
+
+/**	Return the index of a named value.
+
+	@param stringTemplate
+	@param name The name of the placeholder without braces and type
+	@return The index in the values array of wstring_appendTemplate() or -1 if there
+		is no such name.
+*/
+int
+wstringtemplate_index( const WStringTemplate* stringTemplate, const char name[] );
+
+/**	Renders a template and appends the result to a string.
+
+	The size of the result is computed first, so the string grows at most once. Like
+	with wstring_appendf(), values may point into the string itself.
+
+	@param string The string the result gets appended to.
+	@param stringTemplate
+	@param values One value for each index of the template, of the placeholder's type
+	@return string
+*/
+WString*
+wstring_appendTemplate( WString* string, const WStringTemplate* stringTemplate, const WStringValue values[] );
+
+//---------------------------------------------------------------------------------
+//	Reading and writing
+//---------------------------------------------------------------------------------
+
+/**	Read the next line of a file into a string, without the '\n'.
+
+	The text of the string is replaced, but its buffer is kept, so reading many lines
+	into the same string allocates only for lines longer than all lines before.
+
+	Example:
+	\code
+	WString* line = wstring_new( "", 0 );
+	while ( wstring_readLine( line, stdin ))
+		puts( line->cstring );
+	wstring_delete( &line );
+	\endcode
+
+	@param reuse The string to read into, or NULL for a new string
+	@param file
+	@return reuse or the new string, or NULL at the end of the file or on errors, see
+		ferror(). reuse is then empty, but still belongs to the caller.
+*/
+WString*
+wstring_readLine( WString* reuse, FILE* file );
+
+/**	A buffer for reading lines from a file descriptor with wstring_readLineFd().
+*/
+typedef struct WStringReader WStringReader;
+
+/**	Create a reader for a file descriptor, which stays open and belongs to the caller.
+
+	@param fd
+	@param capacity Size of the read buffer in bytes, 0 for 64 KiB
+	@return The new reader
+*/
+WStringReader*
+wstringreader_new( int fd, size_t capacity );
+
+/**	Destroys a reader. Bytes read ahead of the last line are lost.
+*/
+void
+wstringreader_delete( WStringReader** readerPointer );
+
+/**	Read the next line from a file descriptor into a string, without the '\n'.
+	Like wstring_readLine(), but reads through the buffer of the reader.
+
+	A read error stops the reader: This and all later calls return NULL, also if a part
+	of the line was read before. The part is left in reuse.
+
+	@param reuse The string to read into, or NULL for a new string
+	@param reader
+	@return reuse or the new string, or NULL at the end of the file with errno set to 0,
+		or NULL on errors with errno set, see wstringreader_error().
+*/
+WString*
+wstring_readLineFd( WString* reuse, WStringReader* reader );
+
+/**	Return the errno of the read error that stopped the reader, or 0. Like ferror(),
+	this tells errors from the end of the file.
+*/
+int
+wstringreader_error( const WStringReader* reader );
+
+/**	An iterator over the lines or other records of a file mapped into memory, without
+	copying them.
+*/
+typedef struct WStringLines WStringLines;
+
+/**	Map a file for reading its records from front to back.
+
+	Example:
+	\code
+	WStringLines* lines = wstringlines_new( "access.log", '\n' );
+	WStringView line;
+	while ( wstringlines_next( lines, &line ))
+		if ( memmem( line.bytes, line.length, "ERROR", 5 ))
+			printf( "%.*s\n", (int)line.length, line.bytes );
+	wstringlines_delete( &lines );
+	\endcode
+
+	@param path A regular file, which must not be truncated while it is mapped
+	@param delimiter The byte after each record, usually '\n'
+	@return The new iterator, or NULL with errno set if the file could not be mapped
+*/
+WStringLines*
+wstringlines_new( const char path[], char delimiter );
+
+/**	Destroys the iterator and unmaps the file. All views of its records become invalid.
+*/
+void
+wstringlines_delete( WStringLines** linesPointer );
+
+/**	Get the next record.
+
+	@param lines
+	@param line Set to a view on the next record without the delimiter, which stays
+		valid until wstringlines_delete(). It is not 0 terminated.
+	@return false after the last record. A delimiter at the end of the file does not
+		start another, empty record.
+*/
+bool
+wstringlines_next( WStringLines* lines, WStringView* line );
+
+/**	Write the texts of many strings to a file descriptor, without joining them first.
+
+	The strings are written with writev() in batches of up to IOV_MAX strings. Partial
+	writes are continued until all bytes are written.
+
+	Example:
+	\code
+	const WString* response[] = { statusLine, headers, body };
+	if ( not wstring_writeAll( socket, response, 3 ))
+		perror( "write" );
+	\endcode
+
+	@param fd
+	@param strings
+	@param n Number of strings
+	@return true if all bytes were written, false with errno set otherwise
+*/
+bool
+wstring_writeAll( int fd, const WString* strings[], size_t n );
+
+//---------------------------------------------------------------------------------
+
 #endif // WSTRING_H_INCLUDED
@@ -0,0 +1,371 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "wstring_dict.h"
+#include "wstring_internal.h"
+#include <assert.h>
+#include <iso646.h>
+
+//---------------------------------------------------------------------------------
+
+enum WStringDictConfiguration {
+	WStringDictBlockSize	= 16,	//Strings per block, the first of each is stored completely
+	MaxVarintBytes			= 10,
+};
+
+struct WStringDict {
+	char*	bytes;			//The encoded blocks, one after another
+	size_t	sizeBytes;
+	size_t*	blocks;			//Start of each block in bytes
+	size_t	numberBlocks;
+	size_t	size;			//Number of strings
+	size_t	maxLength;		//Length of the longest string
+};
+
+//Iterates over the strings from the start of a block, decoding each into a buffer.
+typedef struct {
+	const WStringDict*	dict;
+	const char*		position;	//Next encoded string
+	size_t			index;		//Index of the next string
+	char*			buffer;		//The decoded string, maxLength + 1 bytes
+	size_t			length;
+}DictCursor;
+
+static WStringDict*
+checkDict( const WStringDict* dict )
+{
+	assert( dict->bytes );
+	assert( dict->blocks );
+	assert( dict->numberBlocks == ( dict->size + WStringDictBlockSize - 1 ) / WStringDictBlockSize );
+
+	return (WStringDict*)dict;
+}
+
+//---------------------------------------------------------------------------------
+//	Encoding
+//---------------------------------------------------------------------------------
+
+//Write a number with 7 bits per byte, the high bit marks following bytes (LEB128).
+static inline size_t
+writeVarint( char* bytes, size_t value )
+{
+	size_t length = 0;
+	while ( value >= 0x80 ) {
+		bytes[length++] = (char)( value | 0x80 );
+		value >>= 7;
+	}
+	bytes[length++] = (char)value;
+
+	return length;
+}
+
+static inline size_t
+readVarint( const char** bytes )
+{
+	const unsigned char* p = (const unsigned char*)*bytes;
+	size_t value = 0;
+	for ( unsigned shift = 0; ; shift += 7 ) {
+		unsigned char byte = *p++;
+		value |= (size_t)( byte & 0x7F ) << shift;
+		if ( byte < 0x80 ) break;
+	}
+
+	*bytes = (const char*)p;
+	return value;
+}
+
+static inline size_t
+commonPrefixLength( const char* bytes, size_t length, const char* other, size_t otherLength )
+{
+	size_t limit = __wmin( length, otherLength );
+	size_t i = 0;
+	while ( i < limit and bytes[i] == other[i] ) i++;
+
+	return i;
+}
+
+//Compare a string with a key, knowing that their first matched bytes are equal.
+static inline int
+compareFrom( const char* bytes, size_t length, WStringView key, size_t matched )
+{
+	if ( matched == length or matched == key.length )
+		return ( matched < length ) - ( matched < key.length );
+
+	return (unsigned char)bytes[matched] < (unsigned char)key.bytes[matched] ? -1 : 1;
+}
+
+//---------------------------------------------------------------------------------
+//	Dictionary creation and destruction
+//---------------------------------------------------------------------------------
+
+WStringDict*
+wstringdict_new( WString* const strings[], size_t n )
+{
+	assert( strings or n == 0 );
+
+	size_t capacityBytes = 1;
+	for ( size_t i = 0; i < n; i++ ) {
+		assert( strings[i] );
+		assert( i == 0 or wstring_compare( strings[i - 1], strings[i] ) <= 0 );
+		capacityBytes += strings[i]->sizeBytes - 1 + 2 * MaxVarintBytes;
+	}
+
+	WStringDict* dict = __wxnew( WStringDict );
+	dict->bytes = __wxmalloc( capacityBytes );
+	dict->blocks = __wxmalloc(( n / WStringDictBlockSize + 1 ) * sizeof( size_t ));
+
+	WStringView previous = { NULL, 0 };
+	for ( size_t i = 0; i < n; i++ ) {
+		WStringView string = wstring_view( strings[i] );
+		if ( i > 0 and string.length == previous.length and memcmp( string.bytes, previous.bytes, string.length ) == 0 )
+			continue;
+
+		char* bytes = &dict->bytes[dict->sizeBytes];
+		if ( dict->size % WStringDictBlockSize == 0 ) {
+			dict->blocks[dict->numberBlocks++] = dict->sizeBytes;
+			dict->sizeBytes += writeVarint( bytes, string.length );
+			memcpy( &dict->bytes[dict->sizeBytes], string.bytes, string.length );
+			dict->sizeBytes += string.length;
+		}
+		else {
+			size_t shared = commonPrefixLength( previous.bytes, previous.length, string.bytes, string.length );
+			size_t written = writeVarint( bytes, shared );
+			written += writeVarint( &bytes[written], string.length - shared );
+			memcpy( &bytes[written], &string.bytes[shared], string.length - shared );
+			dict->sizeBytes += written + string.length - shared;
+		}
+
+		dict->maxLength = __wmax( dict->maxLength, string.length );
+		dict->size++;
+		previous = string;
+	}
+
+	dict->bytes = __wxrealloc( dict->bytes, __wmax( dict->sizeBytes, 1 ));
+
+	assert( dict );
+	return checkDict( dict );
+}
+
+void
+wstringdict_delete( WStringDict** dictPtr )
+{
+	if ( dictPtr == NULL or *dictPtr == NULL )
+		return;
+
+	WStringDict* dict = *dictPtr;
+
+	free( dict->bytes );
+	free( dict->blocks );
+	free( dict );
+	*dictPtr = NULL;
+}
+
+size_t
+wstringdict_size( const WStringDict* dict )
+{
+	assert( dict );
+
+	return dict->size;
+}
+
+size_t
+wstringdict_sizeBytes( const WStringDict* dict )
+{
+	assert( dict );
+
+	return sizeof( WStringDict ) + dict->sizeBytes + ( dict->size / WStringDictBlockSize + 1 ) * sizeof( size_t );
+}
+
+//---------------------------------------------------------------------------------
+//	Lookup
+//---------------------------------------------------------------------------------
+
+//Compare the first string of a block with a key.
+static int
+compareBlock( const WStringDict* dict, size_t block, WStringView key )
+{
+	const char* bytes = &dict->bytes[dict->blocks[block]];
+	size_t length = readVarint( &bytes );
+
+	return compareFrom( bytes, length, key, commonPrefixLength( bytes, length, key.bytes, key.length ));
+}
+
+//Return the rank of a key within a block whose first string is not greater than the key.
+//Keeps track of the bytes the key shares with the current string, so only the bytes of
+//a string that differ from its predecessor are compared.
+static size_t
+rankInBlock( const WStringDict* dict, size_t block, WStringView key, bool* found )
+{
+	const char* bytes = &dict->bytes[dict->blocks[block]];
+	size_t index = block * WStringDictBlockSize;
+	size_t end = __wmin( index + WStringDictBlockSize, dict->size );
+
+	size_t length = readVarint( &bytes );
+	size_t matched = commonPrefixLength( bytes, length, key.bytes, key.length );
+	int order = compareFrom( bytes, length, key, matched );
+	bytes += length;
+
+	*found = order == 0;
+	if ( order >= 0 )
+		return index;
+
+	for ( index++; index < end; index++ ) {
+		size_t shared = readVarint( &bytes );
+		size_t suffixLength = readVarint( &bytes );
+		const char* suffix = bytes;
+		bytes += suffixLength;
+
+		//The string still differs from the key where its predecessor did, so it is smaller.
+		if ( shared > matched )
+			continue;
+		//The string is greater than its predecessor where the predecessor equals the key.
+		if ( shared < matched )
+			return index;
+
+		matched += commonPrefixLength( suffix, suffixLength, &key.bytes[matched], key.length - matched );
+		length = shared + suffixLength;
+		if ( matched == length and matched == key.length ) {
+			*found = true;
+			return index;
+		}
+		if ( matched < length and ( matched == key.length or (unsigned char)suffix[matched - shared] > (unsigned char)key.bytes[matched] ))
+			return index;
+	}
+
+	return end;
+}
+
+static size_t
+rank( const WStringDict* dict, WStringView key, bool* found )
+{
+	*found = false;
+	if ( dict->size == 0 or compareBlock( dict, 0, key ) > 0 )
+		return 0;
+
+	//Find the last block starting with a string not greater than the key.
+	size_t low = 0, high = dict->numberBlocks - 1;
+	while ( low < high ) {
+		size_t middle = low + ( high - low + 1 ) / 2;
+		if ( compareBlock( dict, middle, key ) <= 0 )
+			low = middle;
+		else
+			high = middle - 1;
+	}
+
+	return rankInBlock( dict, low, key, found );
+}
+
+int64_t
+wstringdict_find( const WStringDict* dict, WStringView key )
+{
+	assert( dict );
+	assert( key.bytes or key.length == 0 );
+
+	bool found;
+	size_t index = rank( dict, key, &found );
+
+	return found ? (int64_t)index : -1;
+}
+
+size_t
+wstringdict_rank( const WStringDict* dict, WStringView key )
+{
+	assert( dict );
+	assert( key.bytes or key.length == 0 );
+
+	bool found;
+	return rank( dict, key, &found );
+}
+
+//---------------------------------------------------------------------------------
+
+static void
+cursorInit( DictCursor* cursor, const WStringDict* dict, size_t index )
+{
+	size_t block = index / WStringDictBlockSize;
+
+	*cursor = (DictCursor){
+		.dict = dict,
+		.position = &dict->bytes[dict->blocks[block]],
+		.index = block * WStringDictBlockSize,
+		.buffer = __wxmalloc( dict->maxLength + 1 ),
+	};
+}
+
+//Decode the next string into the buffer.
+static void
+cursorNext( DictCursor* cursor )
+{
+	assert( cursor->index < cursor->dict->size );
+
+	size_t shared = 0;
+	if ( cursor->index % WStringDictBlockSize != 0 )
+		shared = readVarint( &cursor->position );
+	size_t suffixLength = readVarint( &cursor->position );
+
+	memcpy( &cursor->buffer[shared], cursor->position, suffixLength );
+	cursor->position += suffixLength;
+	cursor->length = shared + suffixLength;
+	cursor->buffer[cursor->length] = '\0';
+	cursor->index++;
+}
+
+WString*
+wstringdict_select( const WStringDict* dict, size_t index )
+{
+	assert( dict );
+	assert( index < dict->size );
+
+	DictCursor cursor;
+	cursorInit( &cursor, dict, index );
+	while ( cursor.index <= index )
+		cursorNext( &cursor );
+
+	WString* string = wstring_fromView( (WStringView){ cursor.buffer, cursor.length });
+	free( cursor.buffer );
+
+	assert( string );
+	return string;
+}
+
+void
+wstringdict_foreachPrefix( const WStringDict* dict, WStringView prefix, void foreach( WStringView string, size_t index, void* data ), void* data )
+{
+	assert( dict );
+	assert( prefix.bytes or prefix.length == 0 );
+	assert( foreach );
+
+	bool found;
+	size_t start = rank( dict, prefix, &found );
+	if ( start == dict->size )
+		return;
+
+	DictCursor cursor;
+	cursorInit( &cursor, dict, start );
+	while ( cursor.index < dict->size ) {
+		cursorNext( &cursor );
+		if ( cursor.index <= start )
+			continue;
+		if ( cursor.length < prefix.length or ( prefix.length > 0 and memcmp( cursor.buffer, prefix.bytes, prefix.length ) != 0 ))
+			break;
+
+		foreach( (WStringView){ cursor.buffer, cursor.length }, cursor.index - 1, data );
+	}
+
+	free( cursor.buffer );
+}
+
+//---------------------------------------------------------------------------------
@@ -0,0 +1,122 @@
+/**	@file
+	An immutable dictionary of sorted strings, compressed with front coding.
+*/
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef WSTRING_DICT_H_INCLUDED
+#define WSTRING_DICT_H_INCLUDED
+
+#include "wstring.h"
+
+//---------------------------------------------------------------------------------
+//	Types
+//---------------------------------------------------------------------------------
+
+/**	A sorted set of strings that cannot be changed after its creation.
+
+	The strings are stored in blocks of 16. The first string of a block is stored
+	completely, each following string only as the length of the prefix it shares with
+	its predecessor plus the remaining bytes. Strings with long common prefixes like URLs
+	or paths therefore shrink a lot, and all of them lie in one buffer.
+
+	A lookup is a binary search over the first strings of the blocks, followed by a scan
+	of one block that compares only the bytes not shared with the previous string.
+	The index of a string is its rank: the number of smaller strings in the dictionary.
+*/
+typedef struct WStringDict WStringDict;
+
+//---------------------------------------------------------------------------------
+//	Dictionary creation and destruction
+//---------------------------------------------------------------------------------
+
+/**	Create a dictionary from a sorted array of strings.
+
+	@param strings The strings in the order of wstring_compare(), for example sorted with
+		wstring_sortArray(). Duplicates are stored once.
+	@param n Number of strings in the array
+	@return The new dictionary
+*/
+WStringDict*
+wstringdict_new( WString* const strings[], size_t n );
+
+/**	Destroys a dictionary.
+*/
+void
+wstringdict_delete( WStringDict** dictPointer );
+
+/**	Return the number of different strings in the dictionary.
+*/
+size_t
+wstringdict_size( const WStringDict* dict );
+
+/**	Return the number of bytes allocated for the dictionary.
+*/
+size_t
+wstringdict_sizeBytes( const WStringDict* dict );
+
+//---------------------------------------------------------------------------------
+//	Lookup
+//---------------------------------------------------------------------------------
+
+/**	Find a string.
+
+	@param dict
+	@param key The string to be found
+	@return The index of the string, or -1 if the dictionary does not contain it
+*/
+int64_t
+wstringdict_find( const WStringDict* dict, WStringView key );
+
+/**	Return the number of strings in the dictionary that are smaller than a key.
+
+	That is the index of key, if it is in the dictionary, or else the index where it
+	would have to be inserted.
+*/
+size_t
+wstringdict_rank( const WStringDict* dict, WStringView key );
+
+/**	Return a copy of the string with the given index.
+
+	@param dict
+	@param index Must be less than wstringdict_size()
+	@return A new string
+*/
+WString*
+wstringdict_select( const WStringDict* dict, size_t index );
+
+/**	Call a function for all strings starting with a prefix, in sorted order.
+
+	\code
+	void printRoute( WStringView route, size_t index, void* data )
+	{
+		printf( "%zu: %.*s\n", index, (int)route.length, route.bytes );
+	}
+
+	wstringdict_foreachPrefix( routes, wstring_viewc( "/api/" ), printRoute, NULL );
+	\endcode
+
+	@param dict
+	@param prefix
+	@param foreach Gets each string and its index. The view is only valid during the call.
+	@param data Passed to foreach
+*/
+void
+wstringdict_foreachPrefix( const WStringDict* dict, WStringView prefix, void foreach( WStringView string, size_t index, void* data ), void* data );
+
+//---------------------------------------------------------------------------------
+
+#endif // WSTRING_DICT_H_INCLUDED
@@ -0,0 +1,238 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "wstring_gapbuffer.h"
+#include "wstring_internal.h"
+#include <assert.h>
+#include <iso646.h>
+
+//---------------------------------------------------------------------------------
+
+enum WStringGapBufferConfiguration {
+	WStringGapBufferGrowthRate		= 2,
+	WStringGapBufferMinimumGap		= 64,
+};
+
+//The text is bytes[0, gapStart) followed by bytes[gapEnd, capacity). The gap is never
+//empty, so that closing it leaves room for the 0 terminator.
+struct WStringGapBuffer {
+	char*	bytes;
+	size_t	capacity;
+	size_t	gapStart;
+	size_t	gapEnd;
+	size_t	size;				//Number of characters
+	size_t	gapStartSize;		//Number of characters before the gap
+};
+
+static WStringGapBuffer*
+checkBuffer( const WStringGapBuffer* buffer )
+{
+	assert( buffer->bytes );
+	assert( buffer->gapStart < buffer->gapEnd );
+	assert( buffer->gapEnd <= buffer->capacity );
+	assert( buffer->gapStartSize <= buffer->size );
+	assert( buffer->gapStartSize == __wutf8count( buffer->bytes, buffer->gapStart ));
+
+	return (WStringGapBuffer*)buffer;
+}
+
+static inline bool
+isContinuation( char byte )
+{
+	return ( byte & 0xC0 ) == 0x80;
+}
+
+//Move the gap to a character position. Costs the distance to the old position.
+static void
+moveGap( WStringGapBuffer* buffer, size_t position )
+{
+	if ( position < buffer->gapStartSize ) {
+		size_t start = buffer->gapStart;
+		for ( size_t n = buffer->gapStartSize - position; n > 0; ) {
+			start--;
+			n -= not isContinuation( buffer->bytes[start] );
+		}
+
+		size_t length = buffer->gapStart - start;
+		memmove( &buffer->bytes[buffer->gapEnd - length], &buffer->bytes[start], length );
+		buffer->gapStart = start;
+		buffer->gapEnd -= length;
+	}
+	else if ( position > buffer->gapStartSize ) {
+		size_t end = buffer->gapEnd;
+		for ( size_t n = position - buffer->gapStartSize; n > 0 and end < buffer->capacity; n-- ) {
+			end++;
+			while ( end < buffer->capacity and isContinuation( buffer->bytes[end] ))
+				end++;
+		}
+
+		size_t length = end - buffer->gapEnd;
+		memmove( &buffer->bytes[buffer->gapStart], &buffer->bytes[buffer->gapEnd], length );
+		buffer->gapStart += length;
+		buffer->gapEnd = end;
+	}
+
+	buffer->gapStartSize = position;
+}
+
+//Make the gap longer than length bytes.
+static void
+growGap( WStringGapBuffer* buffer, size_t length )
+{
+	size_t gap = buffer->gapEnd - buffer->gapStart;
+	if ( gap > length )
+		return;
+
+	size_t afterLength = buffer->capacity - buffer->gapEnd;
+	size_t capacity = __wmax( buffer->capacity * WStringGapBufferGrowthRate, buffer->capacity - gap + length + WStringGapBufferMinimumGap );
+
+	buffer->bytes = __wxrealloc( buffer->bytes, capacity );
+	memmove( &buffer->bytes[capacity - afterLength], &buffer->bytes[buffer->gapEnd], afterLength );
+	buffer->gapEnd = capacity - afterLength;
+	buffer->capacity = capacity;
+}
+
+//---------------------------------------------------------------------------------
+//	Gap buffer creation and destruction
+//---------------------------------------------------------------------------------
+
+WStringGapBuffer*
+wstringgapbuffer_new( WString** stringPtr )
+{
+	assert( stringPtr );
+	assert( *stringPtr );
+
+	//Take over a heap buffer, not a mapped file.
+	WString* string = wstring_unmap( *stringPtr );
+	WStringGapBuffer* buffer = __wxnew( WStringGapBuffer,
+		.capacity = string->capacity,
+		.gapStart = string->sizeBytes - 1,
+		.gapEnd = string->capacity,
+		.size = wstring_size( string ),
+		.gapStartSize = wstring_size( string ),
+	);
+	buffer->bytes = wstring_steal( stringPtr );
+
+	assert( buffer );
+	return checkBuffer( buffer );
+}
+
+void
+wstringgapbuffer_delete( WStringGapBuffer** bufferPtr )
+{
+	if ( bufferPtr == NULL or *bufferPtr == NULL )
+		return;
+
+	free( (*bufferPtr)->bytes );
+	free( *bufferPtr );
+	*bufferPtr = NULL;
+}
+
+WString*
+wstringgapbuffer_toString( WStringGapBuffer** bufferPtr )
+{
+	assert( bufferPtr );
+	assert( *bufferPtr );
+
+	WStringGapBuffer* buffer = *bufferPtr;
+	moveGap( buffer, buffer->size );
+	buffer->bytes[buffer->gapStart] = '\0';
+
+	WString* string = __wxnew( WString,
+		.cstring = buffer->bytes,
+		.size = buffer->size,
+		.sizeBytes = buffer->gapStart + 1,
+		.capacity = buffer->capacity,
+	);
+
+	free( buffer );
+	*bufferPtr = NULL;
+
+	assert( string );
+	return string;
+}
+
+size_t
+wstringgapbuffer_size( const WStringGapBuffer* buffer )
+{
+	assert( buffer );
+
+	return buffer->size;
+}
+
+//---------------------------------------------------------------------------------
+//	Editing
+//---------------------------------------------------------------------------------
+
+WStringGapBuffer*
+wstringgapbuffer_insert( WStringGapBuffer* buffer, size_t position, WStringView text )
+{
+	assert( buffer );
+	assert( position <= buffer->size );
+	assert( text.bytes or text.length == 0 );
+
+	moveGap( buffer, position );
+	growGap( buffer, text.length );
+
+	size_t size = __wutf8count( text.bytes, text.length );
+	memcpy( &buffer->bytes[buffer->gapStart], text.bytes, text.length );
+	buffer->gapStart += text.length;
+	buffer->gapStartSize += size;
+	buffer->size += size;
+
+	return checkBuffer( buffer );
+}
+
+WStringGapBuffer*
+wstringgapbuffer_erase( WStringGapBuffer* buffer, size_t position, size_t length )
+{
+	assert( buffer );
+	assert( position <= buffer->size );
+
+	moveGap( buffer, position );
+
+	length = __wmin( length, buffer->size - position );
+	for ( size_t n = length; n > 0; n-- ) {
+		buffer->gapEnd++;
+		while ( buffer->gapEnd < buffer->capacity and isContinuation( buffer->bytes[buffer->gapEnd] ))
+			buffer->gapEnd++;
+	}
+	buffer->size -= length;
+
+	return checkBuffer( buffer );
+}
+
+//---------------------------------------------------------------------------------
+//	Reading
+//---------------------------------------------------------------------------------
+
+WStringView
+wstringgapbuffer_before( const WStringGapBuffer* buffer )
+{
+	assert( buffer );
+
+	return (WStringView){ buffer->bytes, buffer->gapStart };
+}
+
+WStringView
+wstringgapbuffer_after( const WStringGapBuffer* buffer )
+{
+	assert( buffer );
+
+	return (WStringView){ &buffer->bytes[buffer->gapEnd], buffer->capacity - buffer->gapEnd };
+}
+
+//---------------------------------------------------------------------------------
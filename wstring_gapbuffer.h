@@ -0,0 +1,120 @@
+/**	@file
+	A rope: a huge string stored as a balanced tree of chunks, for cheap edits anywhere.
+*/
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef WSTRING_GAPBUFFER_H_INCLUDED
+#define WSTRING_GAPBUFFER_H_INCLUDED
+
+#include "wstring.h"
+
+//---------------------------------------------------------------------------------
+//	Types
+//---------------------------------------------------------------------------------
+
+/**	A string being edited near a cursor. The unused capacity is kept as a gap at the
+	cursor, so inserting and erasing there cost only the length of the edit, instead of
+	moving the rest of the string like wstring_insert() and wstring_erase().
+
+	Moving the cursor moves the text between the old and the new position across the
+	gap, so edits close to each other stay cheap even in big strings.
+
+	Example:
+	\code
+	WStringGapBuffer* buffer = wstringgapbuffer_new( &string );
+	wstringgapbuffer_insert( buffer, 5, wstring_viewc( "," ));
+	wstringgapbuffer_erase( buffer, 6, 1 );
+	string = wstringgapbuffer_toString( &buffer );
+	\endcode
+
+	Positions and lengths are counted in characters, like in wstring_insert().
+*/
+typedef struct WStringGapBuffer WStringGapBuffer;
+
+//---------------------------------------------------------------------------------
+//	Gap buffer creation and destruction
+//---------------------------------------------------------------------------------
+
+/**	Start editing a string. The gap buffer takes over the memory of the string, which
+	is destroyed.
+
+	@param stringPointer Set to NULL
+	@return A new gap buffer with the cursor at the end
+*/
+WStringGapBuffer*
+wstringgapbuffer_new( WString** stringPointer );
+
+/**	Destroys a gap buffer and its text.
+*/
+void
+wstringgapbuffer_delete( WStringGapBuffer** bufferPointer );
+
+/**	Stop editing: Close the gap and return the text as a string, without copying it.
+
+	@param bufferPointer Destroyed and set to NULL
+	@return A new string
+*/
+WString*
+wstringgapbuffer_toString( WStringGapBuffer** bufferPointer );
+
+/**	Return the number of characters.
+*/
+size_t
+wstringgapbuffer_size( const WStringGapBuffer* buffer );
+
+//---------------------------------------------------------------------------------
+//	Editing
+//---------------------------------------------------------------------------------
+
+/**	Insert the bytes of a view before a character position and put the cursor after
+	them.
+
+	@param buffer
+	@param position Character position, at most wstringgapbuffer_size()
+	@param text
+	@return buffer
+*/
+WStringGapBuffer*
+wstringgapbuffer_insert( WStringGapBuffer* buffer, size_t position, WStringView text );
+
+/**	Remove characters from a character position on and put the cursor there.
+
+	@param buffer
+	@param position Character position, at most wstringgapbuffer_size()
+	@param length Number of characters, cut at the end of the text
+	@return buffer
+*/
+WStringGapBuffer*
+wstringgapbuffer_erase( WStringGapBuffer* buffer, size_t position, size_t length );
+
+//---------------------------------------------------------------------------------
+//	Reading
+//---------------------------------------------------------------------------------
+
+/**	Return the text before the cursor. Valid until the buffer is changed.
+*/
+WStringView
+wstringgapbuffer_before( const WStringGapBuffer* buffer );
+
+/**	Return the text after the cursor. Valid until the buffer is changed.
+*/
+WStringView
+wstringgapbuffer_after( const WStringGapBuffer* buffer );
+
+//---------------------------------------------------------------------------------
+
+#endif // WSTRING_GAPBUFFER_H_INCLUDED
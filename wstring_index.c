@@ -0,0 +1,321 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "wstring_index.h"
+#include "wstring_internal.h"
+#include <assert.h>
+#include <iso646.h>
+
+//---------------------------------------------------------------------------------
+
+enum {
+	Empty = UINT32_MAX,		//Unused entry of a suffix array during its construction
+};
+
+struct WStringIndex {
+	WStringView	text;
+	uint32_t*	suffixes;		//Positions of all suffixes in sorted order
+};
+
+//---------------------------------------------------------------------------------
+//	Suffix array construction (SA-IS)
+//---------------------------------------------------------------------------------
+
+/*	SA-IS by Nong, Zhang and Chan: Each suffix is of type S if it is smaller than the
+	following one, else of type L. The leftmost S suffixes of runs (LMS) are sorted first,
+	recursively if needed. The sorted LMS suffixes at the ends of their buckets then
+	determine the order of all L suffixes in one scan from left to right, and these the
+	order of all S suffixes in one scan from right to left.
+
+	The text ends with a virtual sentinel smaller than all symbols. The top level sorts
+	bytes, the recursion the 32 bit names of LMS substrings.
+*/
+
+static inline uint32_t
+symbolAt( const void* text, int symbolSize, size_t i )
+{
+	return symbolSize == 1 ? ((const uint8_t*)text)[i] : ((const uint32_t*)text)[i];
+}
+
+static inline bool
+isS( const uint8_t* types, size_t i )
+{
+	return types[i / 8] >> ( i % 8 ) & 1;
+}
+
+static inline bool
+isLMS( const uint8_t* types, size_t i )
+{
+	return i > 0 and isS( types, i ) and not isS( types, i - 1 );
+}
+
+static void
+bucketStarts( const uint32_t* counts, uint32_t* buckets, size_t alphabetSize )
+{
+	uint32_t sum = 0;
+	for ( size_t c = 0; c < alphabetSize; c++ ) {
+		buckets[c] = sum;
+		sum += counts[c];
+	}
+}
+
+static void
+bucketEnds( const uint32_t* counts, uint32_t* buckets, size_t alphabetSize )
+{
+	uint32_t sum = 0;
+	for ( size_t c = 0; c < alphabetSize; c++ ) {
+		sum += counts[c];
+		buckets[c] = sum;
+	}
+}
+
+//Sort the L suffixes, then the S suffixes by the LMS suffixes at the ends of their buckets.
+static void
+induce( const void* text, int symbolSize, const uint8_t* types, uint32_t* suffixes, size_t n, const uint32_t* counts, uint32_t* buckets, size_t alphabetSize )
+{
+	bucketStarts( counts, buckets, alphabetSize );
+	suffixes[buckets[symbolAt( text, symbolSize, n - 1 )]++] = n - 1;	//Follows the sentinel
+	for ( size_t i = 0; i < n; i++ ) {
+		uint32_t j = suffixes[i];
+		if ( j != Empty and j > 0 and not isS( types, j - 1 ))
+			suffixes[buckets[symbolAt( text, symbolSize, j - 1 )]++] = j - 1;
+	}
+
+	bucketEnds( counts, buckets, alphabetSize );
+	for ( size_t i = n; i-- > 0; ) {
+		uint32_t j = suffixes[i];
+		if ( j != Empty and j > 0 and isS( types, j - 1 ))
+			suffixes[--buckets[symbolAt( text, symbolSize, j - 1 )]] = j - 1;
+	}
+}
+
+//Compare the LMS substrings starting at a and b, each up to the next LMS position.
+static bool
+equalLMSSubstrings( const void* text, int symbolSize, const uint8_t* types, size_t n, size_t a, size_t b )
+{
+	for ( size_t d = 0; ; d++ ) {
+		if ( a + d == n or b + d == n )
+			return false;
+		if ( symbolAt( text, symbolSize, a + d ) != symbolAt( text, symbolSize, b + d ) or isS( types, a + d ) != isS( types, b + d ))
+			return false;
+		if ( d > 0 and ( isLMS( types, a + d ) or isLMS( types, b + d )))
+			return isLMS( types, a + d ) and isLMS( types, b + d );
+	}
+}
+
+static void
+sais( const void* text, int symbolSize, uint32_t* suffixes, size_t n, size_t alphabetSize )
+{
+	if ( n == 0 )
+		return;
+	if ( n == 1 ) {
+		suffixes[0] = 0;
+		return;
+	}
+
+	//The last suffix is of type L, because the sentinel is smaller.
+	uint8_t* types = __wxcalloc( n / 8 + 1, 1 );
+	for ( size_t i = n - 1; i-- > 0; ) {
+		uint32_t symbol = symbolAt( text, symbolSize, i ), next = symbolAt( text, symbolSize, i + 1 );
+		if ( symbol < next or ( symbol == next and isS( types, i + 1 )))
+			types[i / 8] |= 1 << ( i % 8 );
+	}
+
+	uint32_t* counts = __wxcalloc( alphabetSize, sizeof( uint32_t ));
+	uint32_t* buckets = __wxmalloc( alphabetSize * sizeof( uint32_t ));
+	for ( size_t i = 0; i < n; i++ )
+		counts[symbolAt( text, symbolSize, i )]++;
+
+	//Sort the LMS substrings.
+	for ( size_t i = 0; i < n; i++ )
+		suffixes[i] = Empty;
+	bucketEnds( counts, buckets, alphabetSize );
+	for ( size_t i = 1; i < n; i++ )
+		if ( isLMS( types, i ))
+			suffixes[--buckets[symbolAt( text, symbolSize, i )]] = i;
+	induce( text, symbolSize, types, suffixes, n, counts, buckets, alphabetSize );
+
+	size_t m = 0;
+	for ( size_t i = 0; i < n; i++ )
+		if ( suffixes[i] != Empty and isLMS( types, suffixes[i] ))
+			suffixes[m++] = suffixes[i];
+
+	//Name the LMS substrings by their rank. There are at most n / 2 LMS positions, so
+	//the names fit behind the sorted ones, at position / 2.
+	for ( size_t i = m; i < n; i++ )
+		suffixes[i] = Empty;
+	size_t names = 0;
+	for ( size_t i = 0; i < m; i++ ) {
+		if ( i == 0 or not equalLMSSubstrings( text, symbolSize, types, n, suffixes[i], suffixes[i - 1] ))
+			names++;
+		suffixes[m + suffixes[i] / 2] = names - 1;
+	}
+
+	//Move the names to the end, in text order: the reduced text.
+	for ( size_t i = n, j = n; i-- > m; )
+		if ( suffixes[i] != Empty )
+			suffixes[--j] = suffixes[i];
+	uint32_t* reduced = &suffixes[n - m];
+
+	//Sort the LMS suffixes: recursively, unless all their substrings differ.
+	if ( names < m )
+		sais( reduced, 4, suffixes, m, names );
+	else
+		for ( size_t i = 0; i < m; i++ )
+			suffixes[reduced[i]] = i;
+
+	for ( size_t i = 1, j = 0; i < n; i++ )
+		if ( isLMS( types, i ))
+			reduced[j++] = i;
+	for ( size_t i = 0; i < m; i++ )
+		suffixes[i] = reduced[suffixes[i]];
+
+	//Sort all suffixes from the sorted LMS suffixes.
+	for ( size_t i = m; i < n; i++ )
+		suffixes[i] = Empty;
+	bucketEnds( counts, buckets, alphabetSize );
+	for ( size_t i = m; i-- > 0; ) {
+		uint32_t j = suffixes[i];
+		suffixes[i] = Empty;
+		suffixes[--buckets[symbolAt( text, symbolSize, j )]] = j;
+	}
+	induce( text, symbolSize, types, suffixes, n, counts, buckets, alphabetSize );
+
+	free( buckets );
+	free( counts );
+	free( types );
+}
+
+//---------------------------------------------------------------------------------
+//	Index creation and destruction
+//---------------------------------------------------------------------------------
+
+WStringIndex*
+wstringindex_new( WStringView text )
+{
+	assert( text.bytes or text.length == 0 );
+	assert( text.length < UINT32_MAX );
+
+	WStringIndex* index = __wxnew( WStringIndex, .text = text );
+	index->suffixes = __wxmalloc( __wmax( text.length, 1 ) * sizeof( uint32_t ));
+	sais( text.bytes, 1, index->suffixes, text.length, 256 );
+
+	assert( index );
+	return index;
+}
+
+void
+wstringindex_delete( WStringIndex** indexPtr )
+{
+	if ( indexPtr == NULL or *indexPtr == NULL )
+		return;
+
+	free( (*indexPtr)->suffixes );
+	free( *indexPtr );
+	*indexPtr = NULL;
+}
+
+//---------------------------------------------------------------------------------
+//	Searching
+//---------------------------------------------------------------------------------
+
+//Compare the suffix at position with the pattern, knowing that their first skip bytes
+//are equal. Suffixes starting with the pattern count as equal.
+static int
+compareSuffix( const WStringIndex* index, size_t position, WStringView pattern, size_t skip, size_t* commonLength )
+{
+	const char* suffix = &index->text.bytes[position];
+	size_t limit = __wmin( index->text.length - position, pattern.length );
+
+	size_t i = skip;
+	while ( i < limit and suffix[i] == pattern.bytes[i] )
+		i++;
+
+	*commonLength = i;
+	if ( i == pattern.length )
+		return 0;
+	if ( i == limit )
+		return -1;
+	return (unsigned char)suffix[i] < (unsigned char)pattern.bytes[i] ? -1 : 1;
+}
+
+//Return the first suffix not smaller than the pattern, or with upper the first greater one.
+//All suffixes between the bounds share at least the smaller of the bounds' common
+//prefixes with the pattern, so these bytes are skipped.
+static size_t
+searchBound( const WStringIndex* index, WStringView pattern, bool upper )
+{
+	size_t low = 0, high = index->text.length;
+	size_t lowLength = 0, highLength = 0;
+
+	while ( low < high ) {
+		size_t middle = low + ( high - low ) / 2;
+		size_t commonLength;
+		int order = compareSuffix( index, index->suffixes[middle], pattern, __wmin( lowLength, highLength ), &commonLength );
+		if ( order < 0 or ( upper and order == 0 )) {
+			low = middle + 1;
+			lowLength = commonLength;
+		}
+		else {
+			high = middle;
+			highLength = commonLength;
+		}
+	}
+
+	return low;
+}
+
+bool
+wstringindex_contains( const WStringIndex* index, WStringView pattern )
+{
+	assert( index );
+	assert( pattern.bytes or pattern.length == 0 );
+
+	if ( pattern.length == 0 )
+		return true;
+
+	size_t first = searchBound( index, pattern, false );
+	size_t commonLength;
+	return first < index->text.length and
+		   compareSuffix( index, index->suffixes[first], pattern, 0, &commonLength ) == 0;
+}
+
+size_t
+wstringindex_count( const WStringIndex* index, WStringView pattern )
+{
+	assert( index );
+	assert( pattern.bytes or pattern.length == 0 );
+
+	return searchBound( index, pattern, true ) - searchBound( index, pattern, false );
+}
+
+size_t
+wstringindex_locate( const WStringIndex* index, WStringView pattern, size_t positions[], size_t maxPositions )
+{
+	assert( index );
+	assert( pattern.bytes or pattern.length == 0 );
+	assert( positions or maxPositions == 0 );
+
+	size_t first = searchBound( index, pattern, false );
+	size_t end = searchBound( index, pattern, true );
+
+	for ( size_t i = first; i < end and i - first < maxPositions; i++ )
+		positions[i - first] = index->suffixes[i];
+
+	return end - first;
+}
+
+//---------------------------------------------------------------------------------
@@ -0,0 +1,89 @@
+/**	@file
+	A suffix array over a large text, for fast repeated searches in it.
+*/
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef WSTRING_INDEX_H_INCLUDED
+#define WSTRING_INDEX_H_INCLUDED
+
+#include "wstring.h"
+
+//---------------------------------------------------------------------------------
+//	Types
+//---------------------------------------------------------------------------------
+
+/**	An index of all positions of a text, sorted by the text following them (a suffix
+	array).
+
+	All matches of a pattern lie next to each other in the suffix array, so a search is
+	a binary search that compares the pattern with at most a few suffixes per step,
+	instead of a scan of the whole text like wstring_contains(). Build it once for texts
+	that are searched many times.
+
+	The index is built in linear time with the SA-IS algorithm and needs 4 bytes per byte
+	of text. The text is not copied and must stay unchanged as long as the index is used.
+	Texts are limited to 4 GiB - 1 bytes.
+*/
+typedef struct WStringIndex WStringIndex;
+
+//---------------------------------------------------------------------------------
+//	Index creation and destruction
+//---------------------------------------------------------------------------------
+
+/**	Create the index of a text.
+
+	@param text The text, for example wstring_view( string ). May contain any bytes.
+	@return The new index
+*/
+WStringIndex*
+wstringindex_new( WStringView text );
+
+/**	Destroys an index, but not its text.
+*/
+void
+wstringindex_delete( WStringIndex** indexPointer );
+
+//---------------------------------------------------------------------------------
+//	Searching
+//---------------------------------------------------------------------------------
+
+/**	Check if the text contains a pattern.
+*/
+bool
+wstringindex_contains( const WStringIndex* index, WStringView pattern );
+
+/**	Return the number of matches of a pattern in the text, including overlapping ones.
+
+	An empty pattern matches at each position of the text.
+*/
+size_t
+wstringindex_count( const WStringIndex* index, WStringView pattern );
+
+/**	Find the positions of all matches of a pattern.
+
+	@param index
+	@param pattern
+	@param positions Receives the byte positions of the matches in no particular order
+	@param maxPositions Maximum number of positions to be written
+	@return The number of matches, which may be more than maxPositions
+*/
+size_t
+wstringindex_locate( const WStringIndex* index, WStringView pattern, size_t positions[], size_t maxPositions );
+
+//---------------------------------------------------------------------------------
+
+#endif // WSTRING_INDEX_H_INCLUDED
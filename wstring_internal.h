@@ -0,0 +1,164 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*	Helpers shared by the implementation files of Workhorse String.
+	Not part of the public interface, do not include it in applications.
+*/
+#ifndef WSTRING_INTERNAL_H_INCLUDED
+#define WSTRING_INTERNAL_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//---------------------------------------------------------------------------------
+//	Memeory management
+//---------------------------------------------------------------------------------
+
+#define __wmax( x, y )	((x) > (y) ? (x) : (y))
+#define __wmin( x, y )	((x) < (y) ? (x) : (y))
+
+#define __wxnew( type, ... )	\
+	memcpy( __wxmalloc( sizeof( type )), &(type){ __VA_ARGS__ }, sizeof(type) )
+
+static inline void
+__wdie( const char* text )
+{
+	fputs( text, stderr );
+	abort();
+}
+
+static inline void*
+__wxmalloc( size_t size )
+{
+	void* ptr = malloc( size );
+	if ( ptr ) return ptr;
+
+	__wdie( "Out of memory." );
+	return NULL;
+}
+
+static inline void*
+__wxrealloc( void* pointer, size_t size )
+{
+	void* ptr = realloc( pointer, size );
+	if ( ptr ) return ptr;
+
+	__wdie( "Out of memory." );
+	return NULL;
+}
+
+static inline void*
+__wxcalloc( size_t number, size_t size )
+{
+	void* ptr = calloc( number, size );
+	if ( ptr ) return ptr;
+
+	__wdie( "Out of memory." );
+	return NULL;
+}
+
+//---------------------------------------------------------------------------------
+//	Bytes and UTF8 characters
+//---------------------------------------------------------------------------------
+
+//Load 8 bytes as a little endian word, so that the first byte is the lowest one.
+static inline uint64_t
+__wload8( const char* bytes )
+{
+	uint64_t word;
+	memcpy( &word, bytes, sizeof( word ));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	word = __builtin_bswap64( word );
+#endif
+	return word;
+}
+
+//Store a word loaded by __wload8().
+static inline void
+__wstore8( char* bytes, uint64_t word )
+{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	word = __builtin_bswap64( word );
+#endif
+	memcpy( bytes, &word, sizeof( word ));
+}
+
+//For each byte below 0x80 set the high bit if it lies within [low, high].
+static inline uint64_t
+__wswarInRange( uint64_t word, uint8_t low, uint8_t high )
+{
+	const uint64_t ones = 0x0101010101010101;
+
+	uint64_t aboveHigh = word + ones * ( 0x7f - high );
+	uint64_t atLeastLow = word + ones * ( 0x80 - low );
+	return atLeastLow & ~aboveHigh & ( ones * 0x80 );
+}
+
+//Convert the ASCII letters of a word with only ASCII bytes to lower case.
+static inline uint64_t
+__wswarToLower( uint64_t word )
+{
+	return word | ( __wswarInRange( word, 'A', 'Z' ) >> 2 );
+}
+
+//Count the UTF8 continuation bytes 10xxxxxx of a word.
+static inline unsigned
+__wswarContinuations( uint64_t word )
+{
+	return __builtin_popcountll( word & ~( word << 1 ) & 0x8080808080808080 );
+}
+
+//Count the UTF8 characters in a byte range: All bytes that are not continuation bytes.
+static inline size_t
+__wutf8count( const char* bytes, size_t length )
+{
+	size_t count = 0;
+	size_t i = 0;
+	for ( ; i + 8 <= length; i += 8 )
+		count += 8 - __wswarContinuations( __wload8( &bytes[i] ));
+	for ( ; i < length; i++ )
+		count += ( bytes[i] & 0xC0 ) != 0x80;
+
+	return count;
+}
+
+//Return the byte offset of a character position in a byte range, or length if the range
+//has fewer characters.
+static inline size_t
+__wutf8offset( const char* bytes, size_t length, size_t characters )
+{
+	size_t offset = 0;
+	for ( ; offset + 8 <= length; offset += 8 ) {
+		size_t count = 8 - __wswarContinuations( __wload8( &bytes[offset] ));
+		if ( count > characters )
+			break;
+		characters -= count;
+	}
+	for ( ; offset < length; offset++ ) {
+		if (( bytes[offset] & 0xC0 ) != 0x80 && characters-- == 0 )
+			break;
+	}
+
+	return offset;
+}
+
+//---------------------------------------------------------------------------------
+
+#endif // WSTRING_INTERNAL_H_INCLUDED
@@ -0,0 +1,246 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "wstring_keywordset.h"
+#include "wstring_table.h"
+#include "wstring_internal.h"
+#include <assert.h>
+#include <iso646.h>
+
+//---------------------------------------------------------------------------------
+
+enum WStringKeywordSetConfiguration {
+	KeywordsPerBucket	= 2,		//Average, more need less memory but longer to build
+	MaxDisplacements	= 1 << 20,	//Tries per bucket, before starting again with another seed
+};
+
+/*	Hash and displace: The keywords are distributed to buckets by their hash values. For
+	each bucket, starting with the largest, a displacement is searched that moves all its
+	keywords to free slots. A lookup hashes once, reads the displacement of the bucket
+	and compares with the keyword in the resulting slot.
+*/
+struct WStringKeywordSet {
+	uint64_t		seed;
+	uint32_t*		displacements;	//One per bucket
+	size_t			numberBuckets;
+	WStringTable*	keywords;		//The keywords in the order of their slots
+	int64_t*		indexes;		//The index given to wstringkeywordset_new() of each slot
+};
+
+//---------------------------------------------------------------------------------
+
+//Mix the bits of a word (the finalizer of SplitMix64).
+static inline uint64_t
+mix( uint64_t x )
+{
+	x ^= x >> 30;
+	x *= 0xBF58476D1CE4E5B9;
+	x ^= x >> 27;
+	x *= 0x94D049BB133111EB;
+	x ^= x >> 31;
+	return x;
+}
+
+static inline size_t
+bucketOf( const WStringKeywordSet* set, uint64_t hash )
+{
+	return mix( hash ^ set->seed ) % set->numberBuckets;
+}
+
+static inline size_t
+slotOf( uint64_t hash, uint32_t displacement, size_t numberSlots )
+{
+	return mix( hash + ( displacement + 1 ) * 0x9E3779B97F4A7C15 ) % numberSlots;
+}
+
+typedef struct {
+	uint64_t	hash;
+	size_t		index;
+}Keyword;
+
+typedef struct {
+	size_t	start;		//First keyword of the bucket in the keywords sorted by bucket
+	size_t	size;
+	size_t	bucket;
+}Bucket;
+
+static int
+compareBucketSizes( const void* a, const void* b )
+{
+	const Bucket* x = a;
+	const Bucket* y = b;
+	return ( x->size < y->size ) - ( x->size > y->size );
+}
+
+//Try to find displacements for all buckets with the current seed. Duplicates of
+//keywords are removed from the buckets on the way.
+static bool
+findDisplacements( WStringKeywordSet* set, const char* const keywords[], const Keyword* hashed, size_t n, size_t* slots, size_t* numberSlots )
+{
+	Keyword* sorted = __wxmalloc( __wmax( n, 1 ) * sizeof( Keyword ));
+	Bucket* buckets = __wxcalloc( set->numberBuckets, sizeof( Bucket ));
+
+	//Sort the keywords by bucket, keeping their order within each bucket.
+	for ( size_t i = 0; i < n; i++ )
+		buckets[bucketOf( set, hashed[i].hash )].size++;
+	for ( size_t b = 0, start = 0; b < set->numberBuckets; b++ ) {
+		buckets[b].start = start;
+		buckets[b].bucket = b;
+		start += buckets[b].size;
+		buckets[b].size = 0;
+	}
+	for ( size_t i = 0; i < n; i++ ) {
+		Bucket* bucket = &buckets[bucketOf( set, hashed[i].hash )];
+		Keyword keyword = hashed[i];
+
+		bool duplicate = false;
+		for ( size_t j = 0; j < bucket->size and not duplicate; j++ ) {
+			Keyword other = sorted[bucket->start + j];
+			duplicate = other.hash == keyword.hash and strcmp( keywords[other.index], keywords[keyword.index] ) == 0;
+		}
+		if ( not duplicate )
+			sorted[bucket->start + bucket->size++] = keyword;
+	}
+
+	*numberSlots = 0;
+	for ( size_t b = 0; b < set->numberBuckets; b++ )
+		*numberSlots += buckets[b].size;
+
+	qsort( buckets, set->numberBuckets, sizeof( Bucket ), compareBucketSizes );
+
+	bool* taken = __wxcalloc( __wmax( *numberSlots, 1 ), sizeof( bool ));
+	bool success = true;
+	for ( size_t b = 0; b < set->numberBuckets and buckets[b].size > 0 and success; b++ ) {
+		const Keyword* bucketKeywords = &sorted[buckets[b].start];
+		size_t size = buckets[b].size;
+
+		uint32_t displacement = 0;
+		for ( ; displacement < MaxDisplacements; displacement++ ) {
+			size_t placed = 0;
+			for ( ; placed < size; placed++ ) {
+				size_t slot = slotOf( bucketKeywords[placed].hash, displacement, *numberSlots );
+				if ( taken[slot] ) break;
+				taken[slot] = true;
+				slots[bucketKeywords[placed].index] = slot;
+			}
+			if ( placed == size ) break;
+
+			//Free the slots of this try again.
+			for ( size_t i = 0; i < placed; i++ )
+				taken[slots[bucketKeywords[i].index]] = false;
+		}
+
+		set->displacements[buckets[b].bucket] = displacement;
+		success = displacement < MaxDisplacements;
+	}
+
+	free( taken );
+	free( buckets );
+	free( sorted );
+	return success;
+}
+
+WStringKeywordSet*
+wstringkeywordset_new( const char* const keywords[], size_t n )
+{
+	assert( keywords or n == 0 );
+
+	WStringKeywordSet* set = __wxnew( WStringKeywordSet,
+		.numberBuckets = n / KeywordsPerBucket + 1,
+	);
+	set->displacements = __wxmalloc( set->numberBuckets * sizeof( uint32_t ));
+
+	Keyword* hashed = __wxmalloc( __wmax( n, 1 ) * sizeof( Keyword ));
+	for ( size_t i = 0; i < n; i++ ) {
+		assert( keywords[i] );
+		hashed[i] = (Keyword){ wstring_hashView( wstring_viewc( keywords[i] )), i };
+	}
+
+	//slots[i] is the slot of keywords[i], SIZE_MAX for duplicates.
+	size_t* slots = __wxmalloc( __wmax( n, 1 ) * sizeof( size_t ));
+	size_t numberSlots;
+	for ( ;; set->seed++ ) {
+		for ( size_t i = 0; i < n; i++ )
+			slots[i] = SIZE_MAX;
+		if ( findDisplacements( set, keywords, hashed, n, slots, &numberSlots ))
+			break;
+	}
+
+	//Store the keywords in the order of their slots.
+	size_t* slotKeywords = __wxmalloc( __wmax( numberSlots, 1 ) * sizeof( size_t ));
+	for ( size_t i = 0; i < n; i++ )
+		if ( slots[i] != SIZE_MAX )
+			slotKeywords[slots[i]] = i;
+
+	set->keywords = wstringtable_new( numberSlots, 0 );
+	set->indexes = __wxmalloc( __wmax( numberSlots, 1 ) * sizeof( int64_t ));
+	for ( size_t slot = 0; slot < numberSlots; slot++ ) {
+		wstringtable_appendc( set->keywords, keywords[slotKeywords[slot]] );
+		set->indexes[slot] = slotKeywords[slot];
+	}
+
+	free( slotKeywords );
+	free( slots );
+	free( hashed );
+
+	assert( set );
+	return set;
+}
+
+void
+wstringkeywordset_delete( WStringKeywordSet** setPtr )
+{
+	if ( setPtr == NULL or *setPtr == NULL )
+		return;
+
+	WStringKeywordSet* set = *setPtr;
+
+	wstringtable_delete( &set->keywords );
+	free( set->displacements );
+	free( set->indexes );
+	free( set );
+	*setPtr = NULL;
+}
+
+size_t
+wstringkeywordset_size( const WStringKeywordSet* set )
+{
+	assert( set );
+
+	return wstringtable_size( set->keywords );
+}
+
+int64_t
+wstringkeywordset_find( const WStringKeywordSet* set, WStringView key )
+{
+	assert( set );
+	assert( key.bytes or key.length == 0 );
+
+	size_t numberSlots = wstringtable_size( set->keywords );
+	if ( numberSlots == 0 )
+		return -1;
+
+	uint64_t hash = wstring_hashView( key );
+	size_t slot = slotOf( hash, set->displacements[bucketOf( set, hash )], numberSlots );
+
+	WStringView keyword = wstringtable_at( set->keywords, slot );
+	if ( keyword.length != key.length or ( key.length > 0 and memcmp( keyword.bytes, key.bytes, key.length ) != 0 ))
+		return -1;
+
+	return set->indexes[slot];
+}
+
+//---------------------------------------------------------------------------------
@@ -0,0 +1,82 @@
+/**	@file
+	A fixed set of keywords with a minimal perfect hash function.
+*/
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef WSTRING_KEYWORDSET_H_INCLUDED
+#define WSTRING_KEYWORDSET_H_INCLUDED
+
+#include "wstring.h"
+
+//---------------------------------------------------------------------------------
+//	Types
+//---------------------------------------------------------------------------------
+
+/**	A set of keywords that cannot be changed after its creation, for example the
+	commands of a protocol or the keys of a configuration file.
+
+	A minimal perfect hash function maps each keyword to its own slot of a table with
+	exactly one slot per keyword. Finding a token is one hash, one table lookup and one
+	comparison, instead of a comparison with every keyword.
+*/
+typedef struct WStringKeywordSet WStringKeywordSet;
+
+//---------------------------------------------------------------------------------
+
+/**	Create a keyword set.
+
+	Building searches the hash function and takes a few milliseconds for ten thousand
+	keywords.
+
+	@param keywords The keywords. Duplicates are stored once.
+	@param n Number of keywords
+	@return The new set
+*/
+WStringKeywordSet*
+wstringkeywordset_new( const char* const keywords[], size_t n );
+
+/**	Destroys a keyword set.
+*/
+void
+wstringkeywordset_delete( WStringKeywordSet** setPointer );
+
+/**	Return the number of different keywords in the set.
+*/
+size_t
+wstringkeywordset_size( const WStringKeywordSet* set );
+
+/**	Find a keyword.
+
+	\code
+	const char* methods[] = { "GET", "HEAD", "POST", "PUT", "DELETE" };
+	WStringKeywordSet* set = wstringkeywordset_new( methods, 5 );
+
+	wstringkeywordset_find( set, wstring_viewc( "POST" ));	//2
+	wstringkeywordset_find( set, wstring_viewc( "post" ));	//-1
+	\endcode
+
+	@param set
+	@param key
+	@return The index of the keyword in the array given to wstringkeywordset_new(), the
+		first index for duplicates. -1 if key is no keyword.
+*/
+int64_t
+wstringkeywordset_find( const WStringKeywordSet* set, WStringView key );
+
+//---------------------------------------------------------------------------------
+
+#endif // WSTRING_KEYWORDSET_H_INCLUDED
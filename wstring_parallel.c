@@ -0,0 +1,394 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define _GNU_SOURCE
+#include "wstring_parallel.h"
+#include "wstring_internal.h"
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <iso646.h>
+
+//---------------------------------------------------------------------------------
+
+enum WStringParallelConfiguration {
+	ParallelChunkSize		= 256,		//Strings per chunk of the batch operations
+	ParallelSortThreshold	= 10000,	//Smaller arrays are sorted by the calling thread alone
+	BucketsPerThread		= 8,
+	SamplesPerBucket		= 16,
+};
+
+struct WStringThreadPool {
+	pthread_t*			threads;
+	size_t				numberThreads;
+
+	pthread_mutex_t		jobMutex;		//Held by the thread that runs a job
+	pthread_mutex_t		mutex;			//Protects everything below
+	pthread_cond_t		jobStarted;
+	pthread_cond_t		jobFinished;
+	size_t				generation;		//Counts the jobs, so that workers notice new ones
+	size_t				busyThreads;
+	bool				shutdown;
+
+	WStringParallelFunction*	function;
+	void*				context;
+	size_t				n;
+	size_t				chunkSize;
+	atomic_size_t		nextChunk;
+};
+
+//---------------------------------------------------------------------------------
+//	Thread pool
+//---------------------------------------------------------------------------------
+
+static void
+runChunks( WStringThreadPool* pool )
+{
+	for (;;) {
+		size_t begin = atomic_fetch_add( &pool->nextChunk, pool->chunkSize );
+		if ( begin >= pool->n )
+			return;
+
+		pool->function( pool->context, begin, __wmin( begin + pool->chunkSize, pool->n ));
+	}
+}
+
+static void*
+worker( void* argument )
+{
+	WStringThreadPool* pool = argument;
+	size_t generation = 0;
+
+	pthread_mutex_lock( &pool->mutex );
+	for (;;) {
+		while ( not pool->shutdown and pool->generation == generation )
+			pthread_cond_wait( &pool->jobStarted, &pool->mutex );
+		if ( pool->shutdown )
+			break;
+
+		generation = pool->generation;
+		pthread_mutex_unlock( &pool->mutex );
+
+		runChunks( pool );
+
+		pthread_mutex_lock( &pool->mutex );
+		if ( --pool->busyThreads == 0 )
+			pthread_cond_signal( &pool->jobFinished );
+	}
+	pthread_mutex_unlock( &pool->mutex );
+
+	return NULL;
+}
+
+WStringThreadPool*
+wstringthreadpool_new( size_t numberThreads )
+{
+	WStringThreadPool* pool = __wxcalloc( 1, sizeof( WStringThreadPool ));
+	pool->threads = __wxcalloc( __wmax( numberThreads, 1 ), sizeof( pthread_t ));
+
+	pthread_mutex_init( &pool->jobMutex, NULL );
+	pthread_mutex_init( &pool->mutex, NULL );
+	pthread_cond_init( &pool->jobStarted, NULL );
+	pthread_cond_init( &pool->jobFinished, NULL );
+	atomic_init( &pool->nextChunk, 0 );
+
+	for ( size_t i = 0; i < numberThreads; i++ ) {
+		if ( pthread_create( &pool->threads[i], NULL, worker, pool ) != 0 )
+			break;
+		pool->numberThreads++;
+	}
+
+	assert( pool );
+	return pool;
+}
+
+void
+wstringthreadpool_delete( WStringThreadPool** poolPointer )
+{
+	if ( poolPointer == NULL or *poolPointer == NULL )
+		return;
+
+	WStringThreadPool* pool = *poolPointer;
+
+	pthread_mutex_lock( &pool->mutex );
+	pool->shutdown = true;
+	pthread_cond_broadcast( &pool->jobStarted );
+	pthread_mutex_unlock( &pool->mutex );
+
+	for ( size_t i = 0; i < pool->numberThreads; i++ )
+		pthread_join( pool->threads[i], NULL );
+
+	pthread_cond_destroy( &pool->jobFinished );
+	pthread_cond_destroy( &pool->jobStarted );
+	pthread_mutex_destroy( &pool->mutex );
+	pthread_mutex_destroy( &pool->jobMutex );
+	free( pool->threads );
+	free( pool );
+	*poolPointer = NULL;
+}
+
+size_t
+wstringthreadpool_size( const WStringThreadPool* pool )
+{
+	assert( pool );
+
+	return pool->numberThreads;
+}
+
+static WStringThreadPool* defaultPool;
+static pthread_once_t defaultPoolOnce = PTHREAD_ONCE_INIT;
+
+static void
+createDefaultPool( void )
+{
+	long cpus = sysconf( _SC_NPROCESSORS_ONLN );
+	defaultPool = wstringthreadpool_new( cpus > 1 ? cpus - 1 : 0 );
+}
+
+static WStringThreadPool*
+poolOrDefault( WStringThreadPool* pool )
+{
+	if ( pool ) return pool;
+
+	pthread_once( &defaultPoolOnce, createDefaultPool );
+	return defaultPool;
+}
+
+void
+wstringthreadpool_run( WStringThreadPool* pool, size_t n, size_t chunkSize, WStringParallelFunction* function, void* context )
+{
+	assert( chunkSize > 0 );
+	assert( function );
+
+	pool = poolOrDefault( pool );
+	if ( n == 0 )
+		return;
+	if ( pool->numberThreads == 0 or n <= chunkSize ) {
+		function( context, 0, n );
+		return;
+	}
+
+	pthread_mutex_lock( &pool->jobMutex );
+
+	pthread_mutex_lock( &pool->mutex );
+	pool->function = function;
+	pool->context = context;
+	pool->n = n;
+	pool->chunkSize = chunkSize;
+	atomic_store( &pool->nextChunk, 0 );
+	pool->busyThreads = pool->numberThreads;
+	pool->generation++;
+	pthread_cond_broadcast( &pool->jobStarted );
+	pthread_mutex_unlock( &pool->mutex );
+
+	runChunks( pool );
+
+	pthread_mutex_lock( &pool->mutex );
+	while ( pool->busyThreads > 0 )
+		pthread_cond_wait( &pool->jobFinished, &pool->mutex );
+	pthread_mutex_unlock( &pool->mutex );
+
+	pthread_mutex_unlock( &pool->jobMutex );
+}
+
+//---------------------------------------------------------------------------------
+//	Parallel sort
+//---------------------------------------------------------------------------------
+
+typedef struct {
+	WString**	strings;
+	WString**	splitters;
+	size_t		numberSplitters;
+	uint32_t*	buckets;		//The bucket of each string
+	size_t*		bucketStarts;	//numberSplitters + 2 entries
+	WString**	sorted;
+}SampleSort;
+
+//The bucket of a string is the number of splitters less than or equal to it, so
+//equal strings always end up in the same bucket.
+static void
+assignBuckets( void* context, size_t begin, size_t end )
+{
+	SampleSort* sort = context;
+
+	for ( size_t i = begin; i < end; i++ ) {
+		size_t low = 0, high = sort->numberSplitters;
+		while ( low < high ) {
+			size_t middle = low + ( high - low ) / 2;
+			if ( wstring_compare( sort->splitters[middle], sort->strings[i] ) <= 0 )
+				low = middle + 1;
+			else
+				high = middle;
+		}
+		sort->buckets[i] = (uint32_t)low;
+	}
+}
+
+static void
+sortBuckets( void* context, size_t begin, size_t end )
+{
+	SampleSort* sort = context;
+
+	for ( size_t bucket = begin; bucket < end; bucket++ ) {
+		size_t start = sort->bucketStarts[bucket];
+		wstring_sortArray( &sort->sorted[start], sort->bucketStarts[bucket + 1] - start );
+	}
+}
+
+void
+wstring_parallelSortArray( WStringThreadPool* pool, WString* strings[], size_t n )
+{
+	assert( strings or n == 0 );
+
+	pool = poolOrDefault( pool );
+	if ( pool->numberThreads == 0 or n < ParallelSortThreshold ) {
+		wstring_sortArray( strings, n );
+		return;
+	}
+
+	//Take the splitters from a sorted random sample.
+	size_t numberBuckets = ( pool->numberThreads + 1 ) * BucketsPerThread;
+	size_t sampleSize = numberBuckets * SamplesPerBucket;
+	WString** sample = __wxmalloc( sampleSize * sizeof( WString* ));
+	uint64_t random = 0x9E3779B97F4A7C15;
+	for ( size_t i = 0; i < sampleSize; i++ ) {
+		random = random * 6364136223846793005 + 1442695040888963407;
+		sample[i] = strings[( random >> 33 ) % n];
+	}
+	wstring_sortArray( sample, sampleSize );
+
+	SampleSort sort = {
+		.strings = strings,
+		.splitters = __wxmalloc(( numberBuckets - 1 ) * sizeof( WString* )),
+		.numberSplitters = numberBuckets - 1,
+		.buckets = __wxmalloc( n * sizeof( uint32_t )),
+		.bucketStarts = __wxcalloc( numberBuckets + 1, sizeof( size_t )),
+		.sorted = __wxmalloc( n * sizeof( WString* )),
+	};
+	for ( size_t i = 0; i < sort.numberSplitters; i++ )
+		sort.splitters[i] = sample[( i + 1 ) * SamplesPerBucket];
+
+	wstringthreadpool_run( pool, n, ParallelChunkSize * 16, assignBuckets, &sort );
+
+	//Distribute the strings to their buckets, keeping their order.
+	for ( size_t i = 0; i < n; i++ )
+		sort.bucketStarts[sort.buckets[i] + 1]++;
+	for ( size_t bucket = 0; bucket < numberBuckets; bucket++ )
+		sort.bucketStarts[bucket + 1] += sort.bucketStarts[bucket];
+
+	size_t* positions = __wxmalloc( numberBuckets * sizeof( size_t ));
+	memcpy( positions, sort.bucketStarts, numberBuckets * sizeof( size_t ));
+	for ( size_t i = 0; i < n; i++ )
+		sort.sorted[positions[sort.buckets[i]]++] = strings[i];
+
+	wstringthreadpool_run( pool, numberBuckets, 1, sortBuckets, &sort );
+	memcpy( strings, sort.sorted, n * sizeof( WString* ));
+
+	free( positions );
+	free( sort.sorted );
+	free( sort.bucketStarts );
+	free( sort.buckets );
+	free( sort.splitters );
+	free( sample );
+}
+
+//---------------------------------------------------------------------------------
+//	Parallel batch operations
+//---------------------------------------------------------------------------------
+
+typedef struct {
+	WString* const*	strings;
+	const char*		chars;
+	const char*		search;
+	const char*		replace;
+	uint64_t*		results;
+}Batch;
+
+static void
+toLowerChunk( void* context, size_t begin, size_t end )
+{
+	const Batch* batch = context;
+
+	for ( size_t i = begin; i < end; i++ )
+		wstring_toLower( batch->strings[i] );
+}
+
+static void
+trimChunk( void* context, size_t begin, size_t end )
+{
+	const Batch* batch = context;
+
+	for ( size_t i = begin; i < end; i++ )
+		wstring_trim( batch->strings[i], batch->chars );
+}
+
+static void
+replaceAllChunk( void* context, size_t begin, size_t end )
+{
+	const Batch* batch = context;
+
+	for ( size_t i = begin; i < end; i++ )
+		wstring_replaceAll( batch->strings[i], batch->search, batch->replace );
+}
+
+static void
+hashChunk( void* context, size_t begin, size_t end )
+{
+	const Batch* batch = context;
+
+	for ( size_t i = begin; i < end; i++ )
+		batch->results[i] = wstring_hash( batch->strings[i] );
+}
+
+void
+wstring_parallelToLower( WStringThreadPool* pool, WString* strings[], size_t n )
+{
+	assert( strings or n == 0 );
+
+	wstringthreadpool_run( pool, n, ParallelChunkSize, toLowerChunk, &(Batch){ .strings = strings });
+}
+
+void
+wstring_parallelTrim( WStringThreadPool* pool, WString* strings[], size_t n, const char chars[] )
+{
+	assert( strings or n == 0 );
+	assert( chars );
+
+	wstringthreadpool_run( pool, n, ParallelChunkSize, trimChunk, &(Batch){ .strings = strings, .chars = chars });
+}
+
+void
+wstring_parallelReplaceAll( WStringThreadPool* pool, WString* strings[], size_t n, const char search[], const char replace[] )
+{
+	assert( strings or n == 0 );
+	assert( search );
+	assert( replace );
+
+	wstringthreadpool_run( pool, n, ParallelChunkSize, replaceAllChunk,
+		&(Batch){ .strings = strings, .search = search, .replace = replace });
+}
+
+void
+wstring_parallelHash( WStringThreadPool* pool, WString* const strings[], size_t n, uint64_t results[] )
+{
+	assert( strings or n == 0 );
+	assert( results or n == 0 );
+
+	wstringthreadpool_run( pool, n, ParallelChunkSize, hashChunk, &(Batch){ .strings = strings, .results = results });
+}
+
+//---------------------------------------------------------------------------------
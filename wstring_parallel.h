@@ -0,0 +1,125 @@
+/**	@file
+	A small thread pool and parallel batch operations on arrays of strings.
+
+	Link with -pthread.
+*/
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef WSTRING_PARALLEL_H_INCLUDED
+#define WSTRING_PARALLEL_H_INCLUDED
+
+#include "wstring.h"
+
+//---------------------------------------------------------------------------------
+//	Types
+//---------------------------------------------------------------------------------
+
+/**	A fixed number of worker threads that process index ranges in parallel.
+
+	All functions taking a pool accept NULL for a default pool, which is created on
+	first use with one worker less than the number of online CPUs. The calling thread
+	always works, too.
+*/
+typedef struct WStringThreadPool WStringThreadPool;
+
+/**	A function processing the indexes from begin to end, excluding end.
+*/
+typedef void WStringParallelFunction( void* context, size_t begin, size_t end );
+
+//---------------------------------------------------------------------------------
+//	Thread pool
+//---------------------------------------------------------------------------------
+
+/**	Create a thread pool.
+
+	@param numberThreads Number of worker threads besides the calling thread. With 0
+		everything runs in the calling thread.
+	@return The new pool
+*/
+WStringThreadPool*
+wstringthreadpool_new( size_t numberThreads );
+
+/**	Stops all worker threads and destroys the pool.
+*/
+void
+wstringthreadpool_delete( WStringThreadPool** poolPointer );
+
+/**	Return the number of worker threads, not counting the calling thread.
+*/
+size_t
+wstringthreadpool_size( const WStringThreadPool* pool );
+
+/**	Process all indexes from 0 to n-1 in chunks and in parallel, and wait until all
+	chunks are done.
+
+	The chunks are handed out one by one to the threads, so uneven work is balanced.
+	Jobs on the same pool are processed one after another. function must not start
+	another job on the same pool.
+
+	@param pool The pool or NULL for the default pool
+	@param n Number of indexes
+	@param chunkSize Maximum number of indexes per call of function, at least 1
+	@param function Gets called for each chunk
+	@param context Passed to function
+*/
+void
+wstringthreadpool_run( WStringThreadPool* pool, size_t n, size_t chunkSize, WStringParallelFunction* function, void* context );
+
+//---------------------------------------------------------------------------------
+//	Parallel batch operations
+//---------------------------------------------------------------------------------
+
+/**	Sort an array of strings in the order of wstring_compare(), using all threads of the pool.
+
+	Uses sample sort: The strings are distributed to buckets by splitters taken from a
+	sorted sample, then the buckets are sorted in parallel with wstring_sortArray().
+
+	@param pool The pool or NULL for the default pool
+	@param strings The array, gets sorted in place
+	@param n Number of strings in the array
+*/
+void
+wstring_parallelSortArray( WStringThreadPool* pool, WString* strings[], size_t n );
+
+/**	Apply wstring_toLower() to all strings of an array in parallel.
+*/
+void
+wstring_parallelToLower( WStringThreadPool* pool, WString* strings[], size_t n );
+
+/**	Apply wstring_trim() to all strings of an array in parallel.
+*/
+void
+wstring_parallelTrim( WStringThreadPool* pool, WString* strings[], size_t n, const char chars[] );
+
+/**	Apply wstring_replaceAll() to all strings of an array in parallel.
+*/
+void
+wstring_parallelReplaceAll( WStringThreadPool* pool, WString* strings[], size_t n, const char search[], const char replace[] );
+
+/**	Compute wstring_hash() of all strings of an array in parallel.
+
+	@param pool The pool or NULL for the default pool
+	@param strings The array
+	@param n Number of strings in the array
+	@param results Receives the n hash values
+*/
+void
+wstring_parallelHash( WStringThreadPool* pool, WString* const strings[], size_t n, uint64_t results[] );
+
+//---------------------------------------------------------------------------------
+
+#endif // WSTRING_PARALLEL_H_INCLUDED
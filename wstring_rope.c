@@ -0,0 +1,411 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "wstring_rope.h"
+#include "wstring_internal.h"
+#include <assert.h>
+#include <iso646.h>
+
+//---------------------------------------------------------------------------------
+
+enum WStringRopeConfiguration {
+	RopeLeafSize	= 2048,		//Maximum number of bytes per leaf
+};
+
+//A leaf with height 0 and bytes, or an inner node with two children. Shared nodes are
+//never changed, they are replaced by new ones.
+typedef struct RopeNode {
+	size_t				references;
+	size_t				length;		//Number of bytes of all leaves below
+	int					height;
+	struct RopeNode*	left;
+	struct RopeNode*	right;
+	size_t				capacity;	//Leaves only: bytes allocated for bytes
+	char				bytes[];	//Leaves only
+}RopeNode;
+
+struct WStringRope {
+	RopeNode*	root;		//NULL if empty
+};
+
+//---------------------------------------------------------------------------------
+//	Nodes
+//---------------------------------------------------------------------------------
+
+static inline RopeNode*
+retain( RopeNode* node )
+{
+	if ( node ) node->references++;
+	return node;
+}
+
+static void
+release( RopeNode* node )
+{
+	if ( node == NULL or --node->references > 0 )
+		return;
+
+	release( node->left );
+	release( node->right );
+	free( node );
+}
+
+static inline int
+height( const RopeNode* node )
+{
+	return node ? node->height : -1;
+}
+
+static RopeNode*
+newLeaf( const char* bytes, size_t length, size_t capacity )
+{
+	assert( length <= capacity );
+
+	RopeNode* leaf = __wxmalloc( sizeof( RopeNode ) + capacity );
+	*leaf = (RopeNode){ .references = 1, .length = length, .capacity = capacity };
+	memcpy( leaf->bytes, bytes, length );
+
+	return leaf;
+}
+
+//Takes over the references to left and right.
+static RopeNode*
+newNode( RopeNode* left, RopeNode* right )
+{
+	RopeNode* node = __wxmalloc( sizeof( RopeNode ));
+	*node = (RopeNode){
+		.references = 1,
+		.length = left->length + right->length,
+		.height = __wmax( left->height, right->height ) + 1,
+		.left = left,
+		.right = right,
+	};
+
+	return node;
+}
+
+//Build a balanced tree of full leaves.
+static RopeNode*
+build( const char* bytes, size_t length )
+{
+	if ( length == 0 )
+		return NULL;
+	if ( length <= RopeLeafSize )
+		return newLeaf( bytes, length, length );
+
+	size_t half = ( length + RopeLeafSize - 1 ) / RopeLeafSize / 2 * RopeLeafSize;
+	return newNode( build( bytes, half ), build( &bytes[half], length - half ));
+}
+
+//Join two trees whose heights differ by at most 2 with one AVL rotation.
+static RopeNode*
+balance( RopeNode* left, RopeNode* right )
+{
+	if ( height( left ) > height( right ) + 1 ) {
+		RopeNode* a = retain( left->left );
+		RopeNode* b = retain( left->right );
+		release( left );
+		if ( height( a ) >= height( b ))
+			return newNode( a, newNode( b, right ));
+
+		RopeNode* b1 = retain( b->left );
+		RopeNode* b2 = retain( b->right );
+		release( b );
+		return newNode( newNode( a, b1 ), newNode( b2, right ));
+	}
+
+	if ( height( right ) > height( left ) + 1 ) {
+		RopeNode* a = retain( right->left );
+		RopeNode* b = retain( right->right );
+		release( right );
+		if ( height( b ) >= height( a ))
+			return newNode( newNode( left, a ), b );
+
+		RopeNode* a1 = retain( a->left );
+		RopeNode* a2 = retain( a->right );
+		release( a );
+		return newNode( newNode( left, a1 ), newNode( a2, b ));
+	}
+
+	return newNode( left, right );
+}
+
+//Join two trees, taking over their references. The smaller tree goes down the border of
+//the larger one until the heights match. Small leaves are merged with their neighbour,
+//in place if the neighbour has room and nobody else uses it.
+static RopeNode*
+join( RopeNode* left, RopeNode* right )
+{
+	if ( left == NULL ) return right;
+	if ( right == NULL ) return left;
+
+	if ( left->height == 0 and right->height == 0 ) {
+		size_t length = left->length + right->length;
+		if ( length > RopeLeafSize )
+			return newNode( left, right );
+
+		RopeNode* merged = left;
+		if ( left->references > 1 or length > left->capacity ) {
+			merged = newLeaf( left->bytes, left->length, RopeLeafSize );
+			release( left );
+		}
+		memcpy( &merged->bytes[merged->length], right->bytes, right->length );
+		merged->length = length;
+		release( right );
+		return merged;
+	}
+
+	bool smallRight = right->height == 0 and right->length < RopeLeafSize;
+	bool smallLeft = left->height == 0 and left->length < RopeLeafSize;
+
+	if ( height( left ) > height( right ) + 1 or smallRight ) {
+		RopeNode* a = retain( left->left );
+		RopeNode* b = retain( left->right );
+		release( left );
+		return balance( a, join( b, right ));
+	}
+
+	if ( height( right ) > height( left ) + 1 or smallLeft ) {
+		RopeNode* a = retain( right->left );
+		RopeNode* b = retain( right->right );
+		release( right );
+		return balance( join( left, a ), b );
+	}
+
+	return newNode( left, right );
+}
+
+//Split a tree into the bytes before and from position, taking over its reference.
+static void
+split( RopeNode* node, size_t position, RopeNode** left, RopeNode** right )
+{
+	if ( node == NULL or position == 0 ) {
+		*left = NULL;
+		*right = node;
+		return;
+	}
+	if ( position >= node->length ) {
+		*left = node;
+		*right = NULL;
+		return;
+	}
+
+	if ( node->height == 0 ) {
+		*left = newLeaf( node->bytes, position, position );
+		*right = newLeaf( &node->bytes[position], node->length - position, node->length - position );
+		release( node );
+		return;
+	}
+
+	RopeNode* a = retain( node->left );
+	RopeNode* b = retain( node->right );
+	release( node );
+
+	RopeNode* middle;
+	if ( position < a->length ) {
+		split( a, position, left, &middle );
+		*right = join( middle, b );
+	}
+	else {
+		split( b, position - a->length, &middle, right );
+		*left = join( a, middle );
+	}
+}
+
+//---------------------------------------------------------------------------------
+//	Rope creation and destruction
+//---------------------------------------------------------------------------------
+
+WStringRope*
+wstringrope_new( void )
+{
+	WStringRope* rope = __wxnew( WStringRope );
+
+	assert( rope );
+	return rope;
+}
+
+WStringRope*
+wstringrope_fromView( WStringView text )
+{
+	assert( text.bytes or text.length == 0 );
+
+	WStringRope* rope = __wxnew( WStringRope, .root = build( text.bytes, text.length ));
+
+	assert( rope );
+	return rope;
+}
+
+void
+wstringrope_delete( WStringRope** ropePtr )
+{
+	if ( ropePtr == NULL or *ropePtr == NULL )
+		return;
+
+	release( (*ropePtr)->root );
+	free( *ropePtr );
+	*ropePtr = NULL;
+}
+
+size_t
+wstringrope_length( const WStringRope* rope )
+{
+	assert( rope );
+
+	return rope->root ? rope->root->length : 0;
+}
+
+//---------------------------------------------------------------------------------
+//	Editing
+//---------------------------------------------------------------------------------
+
+WStringRope*
+wstringrope_append( WStringRope* rope, WStringView text )
+{
+	assert( rope );
+	assert( text.bytes or text.length == 0 );
+
+	rope->root = join( rope->root, build( text.bytes, text.length ));
+
+	assert( rope );
+	return rope;
+}
+
+WStringRope*
+wstringrope_appendRope( WStringRope* rope, const WStringRope* other )
+{
+	assert( rope );
+	assert( other );
+
+	rope->root = join( rope->root, retain( other->root ));
+
+	assert( rope );
+	return rope;
+}
+
+WStringRope*
+wstringrope_prepend( WStringRope* rope, WStringView text )
+{
+	assert( rope );
+	assert( text.bytes or text.length == 0 );
+
+	rope->root = join( build( text.bytes, text.length ), rope->root );
+
+	assert( rope );
+	return rope;
+}
+
+WStringRope*
+wstringrope_insert( WStringRope* rope, size_t position, WStringView text )
+{
+	assert( rope );
+	assert( position <= wstringrope_length( rope ));
+	assert( text.bytes or text.length == 0 );
+
+	RopeNode* left, *right;
+	split( rope->root, position, &left, &right );
+	rope->root = join( join( left, build( text.bytes, text.length )), right );
+
+	assert( rope );
+	return rope;
+}
+
+WStringRope*
+wstringrope_erase( WStringRope* rope, size_t position, size_t length )
+{
+	assert( rope );
+	assert( position <= wstringrope_length( rope ));
+
+	RopeNode* left, *middle, *right;
+	split( rope->root, position, &left, &right );
+	split( right, length, &middle, &right );
+	release( middle );
+	rope->root = join( left, right );
+
+	assert( rope );
+	return rope;
+}
+
+WStringRope*
+wstringrope_slice( const WStringRope* rope, size_t position, size_t length )
+{
+	assert( rope );
+	assert( position <= wstringrope_length( rope ));
+
+	RopeNode* left, *middle, *right;
+	split( retain( rope->root ), position, &left, &right );
+	split( right, length, &middle, &right );
+	release( left );
+	release( right );
+
+	WStringRope* slice = __wxnew( WStringRope, .root = middle );
+
+	assert( slice );
+	return slice;
+}
+
+//---------------------------------------------------------------------------------
+//	Reading
+//---------------------------------------------------------------------------------
+
+static void
+foreachLeaf( const RopeNode* node, void foreach( WStringView chunk, void* data ), void* data )
+{
+	for ( ; node; node = node->right ) {
+		if ( node->height == 0 ) {
+			foreach( (WStringView){ node->bytes, node->length }, data );
+			return;
+		}
+		foreachLeaf( node->left, foreach, data );
+	}
+}
+
+void
+wstringrope_foreachChunk( const WStringRope* rope, void foreach( WStringView chunk, void* data ), void* data )
+{
+	assert( rope );
+	assert( foreach );
+
+	foreachLeaf( rope->root, foreach, data );
+}
+
+static void
+copyChunk( WStringView chunk, void* data )
+{
+	char** position = data;
+	memcpy( *position, chunk.bytes, chunk.length );
+	*position += chunk.length;
+}
+
+WString*
+wstringrope_flatten( const WStringRope* rope )
+{
+	assert( rope );
+
+	size_t length = wstringrope_length( rope );
+	WString* string = wstring_new( "", length + 1 );
+
+	char* position = string->cstring;
+	foreachLeaf( rope->root, copyChunk, &position );
+	*position = '\0';
+	string->sizeBytes = length + 1;
+	string->size = __wutf8count( string->cstring, length );
+
+	assert( string );
+	return string;
+}
+
+//---------------------------------------------------------------------------------
@@ -0,0 +1,148 @@
+/**	@file
+	A rope: a huge string stored as a balanced tree of chunks, for cheap edits anywhere.
+*/
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef WSTRING_ROPE_H_INCLUDED
+#define WSTRING_ROPE_H_INCLUDED
+
+#include "wstring.h"
+
+//---------------------------------------------------------------------------------
+//	Types
+//---------------------------------------------------------------------------------
+
+/**	A string stored as a balanced binary tree whose leaves hold chunks of up to 2 KiB.
+
+	Appending, prepending, inserting and erasing split and join the tree along one path
+	and cost O(log n) plus the length of the new text, instead of moving the whole
+	string like wstring_prepend(). Use it to assemble big texts out of order, then
+	flatten it into a WString once.
+
+	The nodes of the tree are never changed, only replaced, so slices and appended ropes
+	share them instead of copying. Ropes sharing nodes must not be used by different
+	threads at the same time.
+
+	Positions and lengths are counted in bytes. To keep UTF-8 text valid, insert and
+	erase only at character boundaries.
+*/
+typedef struct WStringRope WStringRope;
+
+//---------------------------------------------------------------------------------
+//	Rope creation and destruction
+//---------------------------------------------------------------------------------
+
+/**	Create an empty rope.
+*/
+WStringRope*
+wstringrope_new( void );
+
+/**	Create a rope with the bytes of a view.
+*/
+WStringRope*
+wstringrope_fromView( WStringView text );
+
+/**	Destroys a rope.
+*/
+void
+wstringrope_delete( WStringRope** ropePointer );
+
+/**	Return the number of bytes in the rope.
+*/
+size_t
+wstringrope_length( const WStringRope* rope );
+
+//---------------------------------------------------------------------------------
+//	Editing
+//---------------------------------------------------------------------------------
+
+/**	Append the bytes of a view.
+
+	@param rope
+	@param text
+	@return rope
+*/
+WStringRope*
+wstringrope_append( WStringRope* rope, WStringView text );
+
+/**	Append another rope. Shares its nodes, so this costs O(log n) whatever its length.
+
+	@param rope
+	@param other May be rope itself
+	@return rope
+*/
+WStringRope*
+wstringrope_appendRope( WStringRope* rope, const WStringRope* other );
+
+/**	Insert the bytes of a view at the start.
+*/
+WStringRope*
+wstringrope_prepend( WStringRope* rope, WStringView text );
+
+/**	Insert the bytes of a view.
+
+	@param rope
+	@param position Byte position to insert at, at most wstringrope_length()
+	@param text
+	@return rope
+*/
+WStringRope*
+wstringrope_insert( WStringRope* rope, size_t position, WStringView text );
+
+/**	Remove a range of bytes.
+
+	@param rope
+	@param position Byte position of the first removed byte
+	@param length Number of removed bytes, cut at the end of the rope
+	@return rope
+*/
+WStringRope*
+wstringrope_erase( WStringRope* rope, size_t position, size_t length );
+
+/**	Create a rope with a range of bytes of another rope. It shares the nodes of the other
+	rope, so this costs O(log n) whatever the length of the range.
+
+	@param rope
+	@param position Byte position of the range, at most wstringrope_length()
+	@param length Number of bytes, cut at the end of the rope
+	@return A new rope
+*/
+WStringRope*
+wstringrope_slice( const WStringRope* rope, size_t position, size_t length );
+
+//---------------------------------------------------------------------------------
+//	Reading
+//---------------------------------------------------------------------------------
+
+/**	Copy the whole text of the rope into a new string.
+*/
+WString*
+wstringrope_flatten( const WStringRope* rope );
+
+/**	Call a function for each chunk of the rope in order, for example to write it to a
+	file without flattening it first.
+
+	@param rope
+	@param foreach Gets each chunk, which is valid as long as the rope is not changed
+	@param data Passed to foreach
+*/
+void
+wstringrope_foreachChunk( const WStringRope* rope, void foreach( WStringView chunk, void* data ), void* data );
+
+//---------------------------------------------------------------------------------
+
+#endif // WSTRING_ROPE_H_INCLUDED
@@ -46,13 +46,21 @@
 */
 typedef struct WStringNamespace {
 	WString*	(*new)			(const char* cstring, size_t capacity);
+	WString*	(*newBytes)		(const char* bytes, size_t length);
 	WString*	(*dup)			(const char*);
 	WString*	(*clone)		(const WString*);
 	WString*	(*printf)		(const char*, ...);
 	void	(*delete)		(WString**);
 	void	(*clear)		(WString*);
 	char*	(*steal)		(WString**);
+	WString*	(*adopt)		(char*, size_t, size_t);
+	WString*	(*mapFile)		(const char*);
+	WString*	(*unmap)		(WString*);
 	void	(*assign)		(WString** string, WString* other);
+	void	(*swap)			(WString*, WString*);
+	WString*	(*fromView)		(WStringView);
+	WString*	(*reserve)		(WString*, size_t);
+	WString*	(*shrinkToFit)	(WString*);
 
 	bool	(*empty)		(const WString*);
 	bool	(*nonEmpty)		(const WString*);
@@ -61,17 +69,35 @@ typedef struct WStringNamespace {
 	int		(*compareCase)	(const WString*, const WString*);
 	size_t	(*similarity)	(const WString*, const WString*);
 	bool	(*contains)		(const WString*, const WString*);
+	bool	(*containsCase)	(const WString*, const WString*);
+	WStringView	(*findCase)	(const WString*, const WString*);
 	bool	(*startsWith)	(const WString*, const WString*);
 	bool	(*endsWith)		(const WString*, const WString*);
+	uint64_t	(*hash)			(const WString*);
+	WStringSignature	(*signature)	(const WString*);
 
 	WString*	(*append)		(WString*, const WString*);
+	WString*	(*appendMove)	(WString*, WString**);
 	WString*	(*appendc)		(WString*, const char*);
 	WString*	(*appendn)		(WString*, size_t, const char*);
 	WString*	(*appendf)		(WString*, const char*, ... );
+	WString*	(*setf)			(WString*, const char*, ... );
+	WString*	(*appendInt)	(WString*, int64_t);
+	WString*	(*appendUint)	(WString*, uint64_t);
+	WString*	(*appendDouble)	(WString*, double);
+	WString*	(*appendTemplate)	(WString*, const WStringTemplate*, const WStringValue[]);
 	WString*	(*prepend)		(WString*, const WString*);
+	WString*	(*join)			(const char*, WString* const[], size_t);
+	WString*	(*joinViews)	(WStringView, const WStringView[], size_t);
+	WString*	(*insert)		(WString*, size_t, const char*);
+	WString*	(*erase)		(WString*, size_t, size_t);
+
+	uint32_t	(*at)			(const WString*, size_t);
+	WString*	(*slice)		(const WString*, size_t, size_t);
 
 	WString*	(*replace)		(WString*, const char*, const char*);
 	WString*	(*replaceAll)	(WString*, const char*, const char*);
+	WString*	(*replaceAllCase)	(WString*, const char*, const char*);
 
 	WString*	(*trim)			(WString*, const char[]);
 	WString*	(*ltrim)		(WString*, const char[]);
@@ -88,21 +114,39 @@ typedef struct WStringNamespace {
 	WString*	(*rjust)		(WString*, size_t);
 
 	void	(*split)		(const WString*, const char*, void foreach(const WString*, void* data), void* data);
+	void	(*sortArray)	(WString*[], size_t);
+	WString*	(*sortKey)		(const WString*, WStringCollation);
 	int		(*toInt)		(const WString*);
 	double	(*toDouble)		(const WString*);
+
+	WStringParseStatus	(*parseInt64)	(const char[], size_t, int64_t*, size_t*);
+	WStringParseStatus	(*parseUint64)	(const char[], size_t, uint64_t*, size_t*);
+	WStringParseStatus	(*parseHex)		(const char[], size_t, uint64_t*, size_t*);
+	WStringParseStatus	(*parseDouble)	(const char[], size_t, double*, size_t*);
+
+	WString*	(*readLine)		(WString*, FILE*);
+	WString*	(*readLineFd)	(WString*, WStringReader*);
 }WStringNamespace;
 
 /**	Predefined value for StringNamespace variables
 */
 #define wstringNamespace {				\
 	.new = wstring_new,					\
+	.newBytes = wstring_newBytes,		\
 	.dup = wstring_dup,					\
 	.clone = wstring_clone,				\
 	.printf = wstring_printf,			\
 	.delete = wstring_delete,			\
 	.clear = wstring_clear,				\
 	.steal = wstring_steal,				\
+	.adopt = wstring_adopt,				\
+	.mapFile = wstring_mapFile,			\
+	.unmap = wstring_unmap,				\
 	.assign = wstring_assign,			\
+	.swap = wstring_swap,				\
+	.fromView = wstring_fromView,		\
+	.reserve = wstring_reserve,			\
+	.shrinkToFit = wstring_shrinkToFit,	\
 \
 	.empty = wstring_empty,				\
 	.nonEmpty = wstring_nonEmpty,		\
@@ -111,16 +155,34 @@ typedef struct WStringNamespace {
 	.compareCase = wstring_compareCase,	\
 	.similarity = wstring_similarity,	\
 	.contains = wstring_contains,		\
+	.containsCase = wstring_containsCase,	\
+	.findCase = wstring_findCase,		\
 	.startsWith = wstring_startsWith,	\
 	.endsWith = wstring_endsWith,		\
+	.hash = wstring_hash,				\
+	.signature = wstring_signature,		\
 \
 	.append = wstring_append,			\
+	.appendMove = wstring_appendMove,	\
 	.appendc = wstring_appendc,			\
 	.appendn = wstring_appendn,			\
 	.appendf = wstring_appendf,			\
+	.setf = wstring_setf,				\
+	.appendInt = wstring_appendInt,		\
+	.appendUint = wstring_appendUint,	\
+	.appendDouble = wstring_appendDouble,	\
+	.appendTemplate = wstring_appendTemplate,	\
 	.prepend = wstring_prepend,			\
+	.join = wstring_join,				\
+	.joinViews = wstring_joinViews,		\
+	.insert = wstring_insert,			\
+	.erase = wstring_erase,				\
+\
+	.at = wstring_at,					\
+	.slice = wstring_slice,				\
 	.replace = wstring_replace,			\
 	.replaceAll = wstring_replaceAll,	\
+	.replaceAllCase = wstring_replaceAllCase,	\
 \
 	.trim = wstring_trim,				\
 	.ltrim = wstring_ltrim,				\
@@ -137,8 +199,18 @@ typedef struct WStringNamespace {
 	.rjust = wstring_rjust,				\
 \
 	.split = wstring_split,				\
+	.sortArray = wstring_sortArray,		\
+	.sortKey = wstring_sortKey,			\
 	.toInt = wstring_toInt,				\
 	.toDouble = wstring_toDouble,		\
+\
+	.parseInt64 = wstring_parseInt64,	\
+	.parseUint64 = wstring_parseUint64,	\
+	.parseHex = wstring_parseHex,		\
+	.parseDouble = wstring_parseDouble,	\
+\
+	.readLine = wstring_readLine,		\
+	.readLineFd = wstring_readLineFd,	\
 }
 
 //---------------------------------------------------------------------------------
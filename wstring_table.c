@@ -0,0 +1,374 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define _GNU_SOURCE
+#include "wstring_table.h"
+#include "wstring_internal.h"
+#include <assert.h>
+#include <limits.h>
+#include <wchar.h>
+#include <wctype.h>
+#include <iso646.h>
+
+//---------------------------------------------------------------------------------
+
+enum WStringTableConfiguration {
+	WStringTableGrowthRate			= 2,
+	WStringTableDefaultCapacity		= 64,
+	WStringTableDefaultCapacityBytes	= 1024,
+};
+
+static WStringTable*
+checkTable( const WStringTable* table )
+{
+	assert( table->bytes );
+	assert( table->offsets );
+	assert( table->size <= table->capacity );
+	assert( table->sizeBytes <= table->capacityBytes );
+	assert( table->offsets[0] == 0 );
+	assert( table->offsets[table->size] == table->sizeBytes );
+
+	return (WStringTable*)table;
+}
+
+//---------------------------------------------------------------------------------
+
+WStringTable*
+wstringtable_new( size_t capacity, size_t capacityBytes )
+{
+	WStringTable* table = __wxnew( WStringTable,
+		.capacity = capacity ? capacity : WStringTableDefaultCapacity,
+		.capacityBytes = capacityBytes ? capacityBytes : WStringTableDefaultCapacityBytes,
+	);
+
+	table->bytes = __wxmalloc( table->capacityBytes );
+	table->offsets = __wxmalloc(( table->capacity + 1 ) * sizeof( size_t ));
+	table->offsets[0] = 0;
+
+	assert( table );
+	return checkTable( table );
+}
+
+void
+wstringtable_delete( WStringTable** tablePtr )
+{
+	if ( tablePtr == NULL or *tablePtr == NULL )
+		return;
+
+	WStringTable* table = *tablePtr;
+
+	free( table->bytes );
+	free( table->offsets );
+	free( table );
+	*tablePtr = NULL;
+}
+
+void
+wstringtable_clear( WStringTable* table )
+{
+	assert( table );
+
+	table->size = 0;
+	table->sizeBytes = 0;
+
+	checkTable( table );
+}
+
+size_t
+wstringtable_size( const WStringTable* table )
+{
+	assert( table );
+
+	return table->size;
+}
+
+//---------------------------------------------------------------------------------
+
+size_t
+wstringtable_appendView( WStringTable* table, WStringView view )
+{
+	assert( table );
+	assert( view.bytes or view.length == 0 );
+
+	if ( table->size == table->capacity ) {
+		table->capacity *= WStringTableGrowthRate;
+		table->offsets = __wxrealloc( table->offsets, ( table->capacity + 1 ) * sizeof( size_t ));
+	}
+
+	size_t newSizeBytes = table->sizeBytes + view.length + 1;
+	if ( newSizeBytes > table->capacityBytes ) {
+		table->capacityBytes = __wmax( newSizeBytes, table->capacityBytes * WStringTableGrowthRate );
+		table->bytes = __wxrealloc( table->bytes, table->capacityBytes );
+	}
+
+	memcpy( &table->bytes[table->sizeBytes], view.bytes, view.length );
+	table->bytes[newSizeBytes - 1] = '\0';
+	table->sizeBytes = newSizeBytes;
+	table->offsets[++table->size] = newSizeBytes;
+
+	checkTable( table );
+	return table->size - 1;
+}
+
+size_t
+wstringtable_append( WStringTable* table, const WString* string )
+{
+	assert( string );
+
+	return wstringtable_appendView( table, wstring_view( string ));
+}
+
+size_t
+wstringtable_appendc( WStringTable* table, const char* cstring )
+{
+	assert( cstring );
+
+	return wstringtable_appendView( table, wstring_viewc( cstring ));
+}
+
+//---------------------------------------------------------------------------------
+
+void
+wstringtable_compare( const WStringTable* table, const WString* other, int results[] )
+{
+	assert( table );
+	assert( other );
+	assert( results or table->size == 0 );
+
+	WStringView otherView = wstring_view( other );
+	for ( size_t i = 0; i < table->size; i++ ) {
+		WStringView view = wstringtable_at( table, i );
+		int result = memcmp( view.bytes, otherView.bytes, __wmin( view.length, otherView.length ));
+		if ( result == 0 )
+			result = ( view.length > otherView.length ) - ( view.length < otherView.length );
+		results[i] = result;
+	}
+}
+
+//Find the string that contains the byte at the given offset, starting the search at first.
+static size_t
+findStringAt( const WStringTable* table, size_t first, size_t offset )
+{
+	size_t low = first;
+	size_t high = table->size;
+	while ( low < high ) {
+		size_t middle = low + ( high - low ) / 2;
+		if ( table->offsets[middle + 1] <= offset )
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return low;
+}
+
+size_t
+wstringtable_contains( const WStringTable* table, const WString* other, bool results[] )
+{
+	assert( table );
+	assert( other );
+	assert( results or table->size == 0 );
+
+	if ( wstring_empty( other )) {
+		for ( size_t i = 0; i < table->size; i++ )
+			results[i] = true;
+		return table->size;
+	}
+
+	memset( results, 0, table->size * sizeof( bool ));
+	size_t count = 0;
+
+	//A search text with 0 bytes could match across the terminator between two strings,
+	//so search each string by itself.
+	if ( memchr( other->cstring, '\0', other->sizeBytes - 1 )) {
+		for ( size_t i = 0; i < table->size; i++ ) {
+			WStringView string = wstringtable_at( table, i );
+			results[i] = memmem( string.bytes, string.length, other->cstring, other->sizeBytes - 1 ) != NULL;
+			count += results[i];
+		}
+		return count;
+	}
+
+	//Otherwise a match never spans two strings. After a match continue with the next
+	//string.
+	const char* end = &table->bytes[table->sizeBytes];
+	const char* current = table->bytes;
+	const char* match;
+	size_t index = 0;
+
+	while (( match = memmem( current, end - current, other->cstring, other->sizeBytes - 1 ))) {
+		index = findStringAt( table, index, match - table->bytes );
+		results[index] = true;
+		count++;
+		current = &table->bytes[table->offsets[++index]];
+	}
+
+	return count;
+}
+
+void
+wstringtable_signatures( const WStringTable* table, WStringSignature results[] )
+{
+	assert( table );
+	assert( results or table->size == 0 );
+
+	for ( size_t i = 0; i < table->size; i++ )
+		results[i] = wstring_signatureView( wstringtable_at( table, i ));
+}
+
+size_t
+wstringtable_containsFiltered( const WStringTable* table, const WStringSignature signatures[], const WString* other, bool results[] )
+{
+	assert( table );
+	assert( signatures or table->size == 0 );
+	assert( other );
+	assert( results or table->size == 0 );
+
+	WStringSignature searchSignature = wstring_signature( other );
+	size_t count = 0;
+
+	for ( size_t i = 0; i < table->size; i++ ) {
+		results[i] = false;
+		if ( not wstring_signatureMayContain( &signatures[i], &searchSignature ))
+			continue;
+
+		WStringView string = wstringtable_at( table, i );
+		results[i] = memmem( string.bytes, string.length, other->cstring, other->sizeBytes - 1 ) != NULL;
+		count += results[i];
+	}
+
+	return count;
+}
+
+//Buffers of wstringtable_toLower(): Converts in place as long as the result does not
+//overtake the unconverted input.
+typedef struct {
+	char*	in;
+	char*	out;
+	size_t	capacity;
+	size_t	read;
+	size_t	write;
+	size_t	sizeBytes;
+}LowerBuffers;
+
+//Make room for n output bytes, which replace consumed input bytes at read.
+static void
+reserveOutput( LowerBuffers* buffers, size_t n, size_t consumed )
+{
+	if ( buffers->out == buffers->in ) {
+		if ( buffers->write + n <= buffers->read + consumed )
+			return;
+
+		//The text grows: Continue in a separate buffer.
+		buffers->capacity = __wmax( buffers->capacity, buffers->sizeBytes ) * WStringTableGrowthRate;
+		buffers->out = __wxmalloc( buffers->capacity );
+		memcpy( buffers->out, buffers->in, buffers->write );
+	}
+
+	if ( buffers->write + n > buffers->capacity ) {
+		buffers->capacity = __wmax( buffers->write + n, buffers->capacity * WStringTableGrowthRate );
+		buffers->out = __wxrealloc( buffers->out, buffers->capacity );
+	}
+}
+
+WStringTable*
+wstringtable_toLower( WStringTable* table )
+{
+	assert( table );
+
+	LowerBuffers buffers = {
+		.in = table->bytes,
+		.out = table->bytes,
+		.capacity = table->capacityBytes,
+		.sizeBytes = table->sizeBytes,
+	};
+
+	for ( size_t i = 0; i < table->size; i++ ) {
+		buffers.read = table->offsets[i];
+		size_t end = table->offsets[i + 1] - 1;
+		table->offsets[i] = buffers.write;
+
+		while ( buffers.read < end ) {
+			//ASCII fast path
+			if ( end - buffers.read >= 8 ) {
+				uint64_t word = __wload8( &buffers.in[buffers.read] );
+				if ( not ( word & 0x8080808080808080 )) {
+					reserveOutput( &buffers, 8, 8 );
+					__wstore8( &buffers.out[buffers.write], __wswarToLower( word ));
+					buffers.read += 8;
+					buffers.write += 8;
+					continue;
+				}
+			}
+
+			unsigned char byte = buffers.in[buffers.read];
+			if ( byte < 0x80 ) {
+				reserveOutput( &buffers, 1, 1 );
+				buffers.out[buffers.write++] = ( byte >= 'A' and byte <= 'Z' ) ? byte | 0x20 : byte;
+				buffers.read++;
+				continue;
+			}
+
+			//Other UTF-8 characters. Invalid bytes are kept as they are.
+			char converted[MB_LEN_MAX];
+			wchar_t wide;
+			mbstate_t state = { 0 };
+			size_t length = mbrtowc( &wide, &buffers.in[buffers.read], end - buffers.read, &state );
+			size_t convertedLength = (size_t)-1;
+			if ( length != (size_t)-1 and length != (size_t)-2 and length != 0 ) {
+				mbstate_t outState = { 0 };
+				convertedLength = wcrtomb( converted, towlower( wide ), &outState );
+			}
+			else
+				length = 1;
+			if ( convertedLength == (size_t)-1 ) {
+				memcpy( converted, &buffers.in[buffers.read], length );
+				convertedLength = length;
+			}
+
+			reserveOutput( &buffers, convertedLength, length );
+			memcpy( &buffers.out[buffers.write], converted, convertedLength );
+			buffers.read += length;
+			buffers.write += convertedLength;
+		}
+
+		reserveOutput( &buffers, 1, 1 );
+		buffers.out[buffers.write++] = '\0';
+		buffers.read++;
+	}
+
+	if ( buffers.out != buffers.in ) {
+		free( table->bytes );
+		table->bytes = buffers.out;
+		table->capacityBytes = buffers.capacity;
+	}
+	table->sizeBytes = buffers.write;
+	table->offsets[table->size] = buffers.write;
+
+	return checkTable( table );
+}
+
+void
+wstringtable_hash( const WStringTable* table, uint64_t results[] )
+{
+	assert( table );
+	assert( results or table->size == 0 );
+
+	for ( size_t i = 0; i < table->size; i++ )
+		results[i] = wstring_hashView( wstringtable_at( table, i ));
+}
+
+//---------------------------------------------------------------------------------
@@ -0,0 +1,201 @@
+/**	@file
+	A column of many strings, stored in one contiguous buffer.
+*/
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef WSTRING_TABLE_H_INCLUDED
+#define WSTRING_TABLE_H_INCLUDED
+
+#include "wstring.h"
+
+//---------------------------------------------------------------------------------
+//	Types
+//---------------------------------------------------------------------------------
+
+/**	A table of many strings, stored one after another in a single growing byte buffer
+	plus an array of offsets, like a string column of Apache Arrow.
+
+	Each string costs one offset and its 0 terminator instead of a WString header and
+	the malloc overhead, and neighbouring strings lie next to each other in memory.
+	Strings cannot be changed after they have been appended, except by the batch
+	operations on the whole table.
+*/
+typedef struct WStringTable {
+	char*	bytes;			//<Private member: Do not use. All strings, one after another, each 0-terminated.
+	size_t	sizeBytes;		//<Private member: Do not use. Number of used bytes.
+	size_t	capacityBytes;	//<Private member: Do not use. Number of allocated bytes.
+	size_t*	offsets;		//<Private member: Do not use. Start of each string, plus the end of the last string.
+	size_t	size;			//<Private member: Do not use. Number of strings.
+	size_t	capacity;		//<Private member: Do not use. Number of strings that fit into offsets.
+}WStringTable;
+
+//---------------------------------------------------------------------------------
+//	Table creation and destruction
+//---------------------------------------------------------------------------------
+
+/**	Create an empty table.
+
+	@param capacity Number of strings to reserve space for, or 0 for a default
+	@param capacityBytes Number of text bytes to reserve space for, or 0 for a default
+	@return The new table
+*/
+WStringTable*
+wstringtable_new( size_t capacity, size_t capacityBytes );
+
+/**	Destroys a table.
+*/
+void
+wstringtable_delete( WStringTable** tablePointer );
+
+/**	Removes all strings, but keeps the allocated memory.
+*/
+void
+wstringtable_clear( WStringTable* table );
+
+/**	Return the number of strings in the table.
+*/
+size_t
+wstringtable_size( const WStringTable* table );
+
+//---------------------------------------------------------------------------------
+
+/**	Append a copy of a string.
+
+	@param table
+	@param string
+	@return The index of the string in the table
+*/
+size_t
+wstringtable_append( WStringTable* table, const WString* string );
+
+/**	Append a copy of a C string.
+
+	@param table
+	@param cstring
+	@return The index of the string in the table
+*/
+size_t
+wstringtable_appendc( WStringTable* table, const char cstring[] );
+
+/**	Append a copy of the bytes of a view, which may contain 0 bytes. Then
+	wstringtable_cstring() ends at the first of them, but wstringtable_at() does not.
+
+	@param table
+	@param view
+	@return The index of the string in the table
+*/
+size_t
+wstringtable_appendView( WStringTable* table, WStringView view );
+
+/**	Return a view on the string with the given index.
+
+	The view is valid until the table is changed the next time.
+
+	@param table
+	@param index Must be less than wstringtable_size()
+	@return The view, not including the 0 terminator.
+*/
+static inline WStringView
+wstringtable_at( const WStringTable* table, size_t index )
+{
+	return (WStringView){
+		&table->bytes[table->offsets[index]],
+		table->offsets[index + 1] - table->offsets[index] - 1
+	};
+}
+
+/**	Return the 0-terminated text of the string with the given index.
+
+	The pointer is valid until the table is changed the next time.
+*/
+static inline const char*
+wstringtable_cstring( const WStringTable* table, size_t index )
+{
+	return &table->bytes[table->offsets[index]];
+}
+
+//---------------------------------------------------------------------------------
+//	Batch operations on all strings
+//---------------------------------------------------------------------------------
+
+/**	Compare all strings of the table with another string, like wstring_compare().
+
+	@param table
+	@param other
+	@param results Receives wstringtable_size() results: <0, 0 or >0 for each string
+*/
+void
+wstringtable_compare( const WStringTable* table, const WString* other, int results[] );
+
+/**	Check for all strings of the table if they contain another string.
+
+	The whole buffer is searched in a single pass, so strings without a match cost
+	only the search itself.
+
+	@param table
+	@param other
+	@param results Receives wstringtable_size() results, true for each string containing other
+	@return The number of strings containing other
+*/
+size_t
+wstringtable_contains( const WStringTable* table, const WString* other, bool results[] );
+
+/**	Compute the signatures of all strings of the table, like wstring_signature().
+
+	@param table
+	@param results Receives wstringtable_size() signatures
+*/
+void
+wstringtable_signatures( const WStringTable* table, WStringSignature results[] );
+
+/**	Check for all strings of the table if they contain another string, skipping the
+	strings whose signatures show that they cannot contain it.
+
+	Faster than wstringtable_contains() if few strings match and the signatures are
+	reused for many searches.
+
+	@param table
+	@param signatures The signatures of all strings, from wstringtable_signatures()
+	@param other
+	@param results Receives wstringtable_size() results, true for each string containing other
+	@return The number of strings containing other
+*/
+size_t
+wstringtable_containsFiltered( const WStringTable* table, const WStringSignature signatures[], const WString* other, bool results[] );
+
+/**	Convert all strings of the table to lower case.
+
+	ASCII text is converted 8 bytes at a time. Other UTF-8 characters are converted
+	with the wchar_t standard library functions like in wstring_toLower().
+
+	@param table
+	@return table
+*/
+WStringTable*
+wstringtable_toLower( WStringTable* table );
+
+/**	Compute the hash values of all strings of the table, like wstring_hash().
+
+	@param table
+	@param results Receives wstringtable_size() hash values
+*/
+void
+wstringtable_hash( const WStringTable* table, uint64_t results[] );
+
+//---------------------------------------------------------------------------------
+
+#endif // WSTRING_TABLE_H_INCLUDED
@@ -0,0 +1,287 @@
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "wstring_trie.h"
+#include "wstring_internal.h"
+#include <assert.h>
+#include <iso646.h>
+
+//---------------------------------------------------------------------------------
+
+enum WStringTrieConfiguration {
+	WStringTrieGrowthRate			= 2,
+	WStringTrieDefaultCapacity		= 16,
+	WStringTrieDefaultLabelCapacity	= 256,
+};
+
+enum {
+	NoPrefix	= -1,	//Value of nodes that do not end a prefix
+};
+
+//The label of the edge to a node is a range of the label buffer. Splitting an edge
+//only splits the range, so labels are never copied.
+typedef struct {
+	size_t		labelStart;
+	size_t		labelLength;
+	size_t*		children;		//Sorted by the first byte of their labels, which all differ
+	size_t		numberChildren;
+	int64_t		prefix;			//The index of the prefix ending here, or NoPrefix
+}TrieNode;
+
+struct WStringTrie {
+	TrieNode*	nodes;			//nodes[0] is the root with an empty label
+	size_t		numberNodes;
+	size_t		capacityNodes;
+	char*		labels;
+	size_t		sizeLabels;
+	size_t		capacityLabels;
+	size_t		size;			//Number of prefixes
+};
+
+static WStringTrie*
+checkTrie( const WStringTrie* trie )
+{
+	assert( trie->nodes );
+	assert( trie->labels );
+	assert( trie->numberNodes >= 1 and trie->numberNodes <= trie->capacityNodes );
+	assert( trie->sizeLabels <= trie->capacityLabels );
+	assert( trie->nodes[0].labelLength == 0 );
+
+	return (WStringTrie*)trie;
+}
+
+//---------------------------------------------------------------------------------
+//	Trie creation and destruction
+//---------------------------------------------------------------------------------
+
+static size_t
+addNode( WStringTrie* trie, size_t labelStart, size_t labelLength )
+{
+	if ( trie->numberNodes == trie->capacityNodes ) {
+		trie->capacityNodes *= WStringTrieGrowthRate;
+		trie->nodes = __wxrealloc( trie->nodes, trie->capacityNodes * sizeof( TrieNode ));
+	}
+
+	trie->nodes[trie->numberNodes] = (TrieNode){
+		.labelStart = labelStart,
+		.labelLength = labelLength,
+		.prefix = NoPrefix,
+	};
+	return trie->numberNodes++;
+}
+
+WStringTrie*
+wstringtrie_new( void )
+{
+	WStringTrie* trie = __wxnew( WStringTrie,
+		.capacityNodes = WStringTrieDefaultCapacity,
+		.capacityLabels = WStringTrieDefaultLabelCapacity,
+	);
+
+	trie->nodes = __wxmalloc( trie->capacityNodes * sizeof( TrieNode ));
+	trie->labels = __wxmalloc( trie->capacityLabels );
+	addNode( trie, 0, 0 );
+
+	assert( trie );
+	return checkTrie( trie );
+}
+
+void
+wstringtrie_delete( WStringTrie** triePtr )
+{
+	if ( triePtr == NULL or *triePtr == NULL )
+		return;
+
+	WStringTrie* trie = *triePtr;
+
+	for ( size_t i = 0; i < trie->numberNodes; i++ )
+		free( trie->nodes[i].children );
+	free( trie->nodes );
+	free( trie->labels );
+	free( trie );
+	*triePtr = NULL;
+}
+
+size_t
+wstringtrie_size( const WStringTrie* trie )
+{
+	assert( trie );
+
+	return trie->size;
+}
+
+//---------------------------------------------------------------------------------
+
+static inline unsigned char
+firstLabelByte( const WStringTrie* trie, size_t node )
+{
+	return trie->labels[trie->nodes[node].labelStart];
+}
+
+//Return the position of the child whose label starts with byte, or where it belongs.
+static size_t
+findChild( const WStringTrie* trie, size_t node, unsigned char byte, bool* found )
+{
+	const TrieNode* parent = &trie->nodes[node];
+
+	size_t low = 0, high = parent->numberChildren;
+	while ( low < high ) {
+		size_t middle = low + ( high - low ) / 2;
+		if ( firstLabelByte( trie, parent->children[middle] ) < byte )
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	*found = low < parent->numberChildren and firstLabelByte( trie, parent->children[low] ) == byte;
+	return low;
+}
+
+static void
+insertChild( WStringTrie* trie, size_t node, size_t position, size_t child )
+{
+	TrieNode* parent = &trie->nodes[node];
+
+	parent->children = __wxrealloc( parent->children, ( parent->numberChildren + 1 ) * sizeof( size_t ));
+	memmove( &parent->children[position + 1], &parent->children[position], ( parent->numberChildren - position ) * sizeof( size_t ));
+	parent->children[position] = child;
+	parent->numberChildren++;
+}
+
+static size_t
+appendLabel( WStringTrie* trie, const char* bytes, size_t length )
+{
+	if ( trie->sizeLabels + length > trie->capacityLabels ) {
+		trie->capacityLabels = __wmax( trie->sizeLabels + length, trie->capacityLabels * WStringTrieGrowthRate );
+		trie->labels = __wxrealloc( trie->labels, trie->capacityLabels );
+	}
+
+	memcpy( &trie->labels[trie->sizeLabels], bytes, length );
+	trie->sizeLabels += length;
+	return trie->sizeLabels - length;
+}
+
+size_t
+wstringtrie_add( WStringTrie* trie, WStringView prefix )
+{
+	assert( trie );
+	assert( prefix.bytes or prefix.length == 0 );
+
+	size_t node = 0, position = 0;
+	while ( position < prefix.length ) {
+		bool found;
+		size_t childPosition = findChild( trie, node, prefix.bytes[position], &found );
+
+		//No edge continues with the next byte: add a leaf for the rest.
+		if ( not found ) {
+			size_t labelStart = appendLabel( trie, &prefix.bytes[position], prefix.length - position );
+			size_t leaf = addNode( trie, labelStart, prefix.length - position );
+			insertChild( trie, node, childPosition, leaf );
+			node = leaf;
+			break;
+		}
+
+		size_t child = trie->nodes[node].children[childPosition];
+		TrieNode label = trie->nodes[child];
+		size_t matched = 1;
+		while ( matched < label.labelLength and position + matched < prefix.length and
+				trie->labels[label.labelStart + matched] == prefix.bytes[position + matched] )
+			matched++;
+
+		//The prefix leaves the edge in its middle: split the edge there.
+		if ( matched < label.labelLength ) {
+			size_t middle = addNode( trie, label.labelStart, matched );
+			trie->nodes[child].labelStart += matched;
+			trie->nodes[child].labelLength -= matched;
+			insertChild( trie, middle, 0, child );
+			trie->nodes[node].children[childPosition] = middle;
+			child = middle;
+		}
+
+		node = child;
+		position += matched;
+	}
+
+	if ( trie->nodes[node].prefix == NoPrefix )
+		trie->nodes[node].prefix = trie->size++;
+
+	checkTrie( trie );
+	return trie->nodes[node].prefix;
+}
+
+//---------------------------------------------------------------------------------
+//	Matching
+//---------------------------------------------------------------------------------
+
+//Walk down the edges matching string and collect the prefixes passed on the way.
+static size_t
+walk( const WStringTrie* trie, WStringView string, size_t results[], size_t maxResults, int64_t* longest )
+{
+	size_t node = 0, position = 0, count = 0;
+	*longest = NoPrefix;
+
+	for (;;) {
+		int64_t prefix = trie->nodes[node].prefix;
+		if ( prefix != NoPrefix ) {
+			if ( count < maxResults )
+				results[count] = prefix;
+			count++;
+			*longest = prefix;
+		}
+
+		if ( position == string.length )
+			break;
+
+		bool found;
+		size_t childPosition = findChild( trie, node, string.bytes[position], &found );
+		if ( not found )
+			break;
+
+		node = trie->nodes[node].children[childPosition];
+		const TrieNode* child = &trie->nodes[node];
+		if ( string.length - position < child->labelLength or
+			 memcmp( &trie->labels[child->labelStart], &string.bytes[position], child->labelLength ) != 0 )
+			break;
+		position += child->labelLength;
+	}
+
+	return count;
+}
+
+int64_t
+wstringtrie_longestMatch( const WStringTrie* trie, WStringView string )
+{
+	assert( trie );
+	assert( string.bytes or string.length == 0 );
+
+	int64_t longest;
+	walk( trie, string, NULL, 0, &longest );
+
+	return longest;
+}
+
+size_t
+wstringtrie_matchAll( const WStringTrie* trie, WStringView string, size_t results[], size_t maxResults )
+{
+	assert( trie );
+	assert( string.bytes or string.length == 0 );
+	assert( results or maxResults == 0 );
+
+	int64_t longest;
+	return walk( trie, string, results, maxResults, &longest );
+}
+
+//---------------------------------------------------------------------------------
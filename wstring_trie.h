@@ -0,0 +1,105 @@
+/**	@file
+	A radix tree of prefixes, to find all prefixes of a string in one walk.
+*/
+/*  Copyright (c) 2017 Michael Nau
+    This file is part of Workhorse String.
+
+    Workhorse String is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Workhorse String is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Workhorse Array.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef WSTRING_TRIE_H_INCLUDED
+#define WSTRING_TRIE_H_INCLUDED
+
+#include "wstring.h"
+
+//---------------------------------------------------------------------------------
+//	Types
+//---------------------------------------------------------------------------------
+
+/**	A set of prefixes, for example the routes of a web server.
+
+	The prefixes are stored in a compact radix tree: Each edge is labeled with a run of
+	bytes instead of a single byte. Finding the prefixes a string starts with walks down
+	the tree once and reads each byte of the string at most once, no matter how many
+	prefixes there are.
+
+	Each prefix gets an index in the order it was added, like the strings of a
+	WStringTable, to be used for example as an index into an array of handlers.
+*/
+typedef struct WStringTrie WStringTrie;
+
+//---------------------------------------------------------------------------------
+//	Trie creation and destruction
+//---------------------------------------------------------------------------------
+
+/**	Create an empty trie.
+*/
+WStringTrie*
+wstringtrie_new( void );
+
+/**	Destroys a trie.
+*/
+void
+wstringtrie_delete( WStringTrie** triePointer );
+
+/**	Return the number of prefixes in the trie.
+*/
+size_t
+wstringtrie_size( const WStringTrie* trie );
+
+/**	Add a prefix.
+
+	@param trie
+	@param prefix
+	@return The index of the prefix. If the trie already contains it, its old index.
+*/
+size_t
+wstringtrie_add( WStringTrie* trie, WStringView prefix );
+
+//---------------------------------------------------------------------------------
+//	Matching
+//---------------------------------------------------------------------------------
+
+/**	Find the longest prefix a string starts with.
+
+	\code
+	WStringTrie* routes = wstringtrie_new();
+	wstringtrie_add( routes, wstring_viewc( "/" ));			//0
+	wstringtrie_add( routes, wstring_viewc( "/api/" ));		//1
+	wstringtrie_add( routes, wstring_viewc( "/api/users/" ));	//2
+
+	wstringtrie_longestMatch( routes, wstring_viewc( "/api/users/42" ));	//2
+	wstringtrie_longestMatch( routes, wstring_viewc( "/api/orders" ));	//1
+	\endcode
+
+	@param trie
+	@param string
+	@return The index of the prefix, or -1 if string starts with none of the prefixes
+*/
+int64_t
+wstringtrie_longestMatch( const WStringTrie* trie, WStringView string );
+
+/**	Find all prefixes a string starts with.
+
+	@param trie
+	@param string
+	@param results Receives the indexes of the prefixes, shortest prefix first
+	@param maxResults Maximum number of indexes to be written into results
+	@return The number of prefixes string starts with, which may be more than maxResults
+*/
+size_t
+wstringtrie_matchAll( const WStringTrie* trie, WStringView string, size_t results[], size_t maxResults );
+
+//---------------------------------------------------------------------------------
+
+#endif // WSTRING_TRIE_H_INCLUDED